@@ -0,0 +1,67 @@
+"""
+Compare end-to-end turn latency of the json and --binary agent protocols.
+
+Replays a log of observations (one json line per turn, exactly as main.py writes them to the agent)
+through agent.out in both modes. Each turn is timed from encoding the observation to decoding the
+response, so Python-side conversion cost is included. The decoded actions of both modes are checked
+against each other.
+
+USAGE: python3 bench_protocol.py OBS_LOG [AGENT_BIN]
+"""
+import json
+import statistics
+import sys
+import time
+from subprocess import Popen, PIPE, DEVNULL
+
+from main import encode_obs, read_frame, decode_actions
+
+
+def run(agent_bin, lines, binary):
+    args = [agent_bin] + (["--binary"] if binary else [])
+    proc = Popen(args, stdin=PIPE, stdout=PIPE, stderr=DEVNULL)
+    times, results = [], []
+    for line in lines:
+        start = time.perf_counter()
+        if binary:
+            data = json.loads(line)
+            proc.stdin.write(encode_obs(data["obs"], data["step"], data["remainingOverageTime"], data["player"]))
+            proc.stdin.flush()
+            payload = read_frame(proc.stdout)
+            res = decode_actions(payload) if payload else {}
+        else:
+            proc.stdin.write(line.encode() + b"\n")
+            proc.stdin.flush()
+            res = json.loads(proc.stdout.readline().decode() or "{}")
+        times.append(time.perf_counter() - start)
+        results.append(res)
+    proc.stdin.close()
+    proc.wait()
+    return times, results
+
+
+def report(name, times):
+    ms = sorted(t * 1000 for t in times)
+    print("%-6s turns=%d mean=%.2fms p50=%.2fms p95=%.2fms max=%.2fms total=%.1fms" % (
+        name, len(ms), statistics.mean(ms), ms[len(ms) // 2], ms[int(len(ms) * 0.95)], ms[-1], sum(ms)))
+
+
+def main():
+    obs_log = sys.argv[1]
+    agent_bin = sys.argv[2] if len(sys.argv) > 2 else "./build/agent.out"
+    lines = [l.rstrip("\n") for l in open(obs_log) if l.strip()]
+
+    json_times, json_results = run(agent_bin, lines, binary=False)
+    bin_times, bin_results = run(agent_bin, lines, binary=True)
+    report("json", json_times)
+    report("binary", bin_times)
+
+    mismatches = [i for i, (a, b) in enumerate(zip(json_results, bin_results)) if a != b]
+    if mismatches:
+        print("MISMATCH at turns:", mismatches[:10])
+        sys.exit(1)
+    print("actions identical for all %d turns" % len(lines))
+
+
+if __name__ == "__main__":
+    main()
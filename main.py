@@ -5,12 +5,102 @@ from queue import Queue, Empty
 from collections import defaultdict
 import atexit
 import os
+import struct
 import sys
 agent_processes = defaultdict(lambda : None)
 t = None
 q_stderr = None
 q_stdout = None
 import time
+
+# Set LUX_BINARY_PROTOCOL=1 to talk to agent.out with length-prefixed binary frames (src/lux/wire.hpp)
+# instead of json lines
+BINARY_PROTOCOL = os.environ.get("LUX_BINARY_PROTOCOL", "0") == "1"
+SIZE = 64
+CELL_RUBBLE, CELL_LICHEN, CELL_LICHEN_STRAIN = 1, 2, 4
+
+def _plane_bytes(plane):
+    # [x][y] -> cell id order (y * SIZE + x)
+    return bytes((int(plane[x][y]) & 0xff) for y in range(SIZE) for x in range(SIZE))
+
+def encode_obs(obs, step, remaining_overage_time, player):
+    board = obs["board"]
+    out = bytearray(struct.pack("<iiibi", step, int(remaining_overage_time), obs["real_env_steps"],
+                                0 if player == "player_0" else 1, board.get("factories_per_team", 0)))
+    for player_id in ("player_0", "player_1"):
+        team = obs["teams"].get(player_id)
+        if team is None:
+            out += struct.pack("<b", 0)
+            continue
+        strains = team["factory_strains"]
+        out += struct.pack("<biibB", 1, team["water"], team["metal"], int(team["place_first"]), len(strains))
+        out += struct.pack("<%dh" % len(strains), *strains)
+
+    planes = [board.get(k) for k in ("ice", "ore", "rubble", "valid_spawns_mask")]
+    flags = 0
+    for i, plane in enumerate(planes):
+        if isinstance(plane, list): flags |= (1 << i)
+    out += struct.pack("<B", flags)
+    for plane in planes:
+        if isinstance(plane, list): out += _plane_bytes(plane)
+
+    deltas = {}
+    for key, field, idx in (("rubble", CELL_RUBBLE, 1), ("lichen", CELL_LICHEN, 2), ("lichen_strains", CELL_LICHEN_STRAIN, 3)):
+        diff = board.get(key)
+        if not isinstance(diff, dict): continue
+        for xy, val in diff.items():
+            x, y = xy.split(",")
+            delta = deltas.setdefault(int(y) * SIZE + int(x), [0, 0, 0, 0])
+            delta[0] |= field
+            delta[idx] = val
+    out += struct.pack("<H", len(deltas))
+    for cell_id, (fields, rubble, lichen, strain) in deltas.items():
+        out += struct.pack("<hbbbb", cell_id, fields, rubble, lichen, strain)
+
+    units = [u for player_units in obs["units"].values() for u in player_units.values()]
+    out += struct.pack("<H", len(units))
+    for u in units:
+        cargo = u["cargo"]
+        aq = u["action_queue"]
+        out += struct.pack("<hbbhhiiiiiB", int(u["unit_id"].split("_")[1]), u["team_id"], u["unit_type"] == "HEAVY",
+                           u["pos"][0], u["pos"][1], cargo["ice"], cargo["ore"], cargo["water"], cargo["metal"],
+                           u["power"], len(aq))
+        for a in aq:
+            out += struct.pack("<bbbhhh", *[int(v) for v in a])
+
+    factories = [f for player_factories in obs["factories"].values() for f in player_factories.values()]
+    out += struct.pack("<H", len(factories))
+    for f in factories:
+        cargo = f["cargo"]
+        out += struct.pack("<hbhhiiiii", f["strain_id"], f["team_id"], f["pos"][0], f["pos"][1],
+                           cargo["ice"], cargo["ore"], cargo["water"], cargo["metal"], f["power"])
+    return struct.pack("<I", len(out)) + out
+
+def read_frame(stream):
+    header = stream.read(4)
+    if len(header) < 4:
+        return None
+    (length,) = struct.unpack("<I", header)
+    return stream.read(length)
+
+def decode_actions(payload):
+    if payload[0] == 1:  # json text (bidding / factory placement)
+        return json.loads(payload[1:].decode())
+    actions = {}
+    pos = 1
+    (unit_count,) = struct.unpack_from("<H", payload, pos); pos += 2
+    for _ in range(unit_count):
+        unit_id, n = struct.unpack_from("<hB", payload, pos); pos += 3
+        aq = []
+        for _ in range(n):
+            aq.append(list(struct.unpack_from("<bbbhhh", payload, pos))); pos += 9
+        actions["unit_%d" % unit_id] = aq
+    (factory_count,) = struct.unpack_from("<H", payload, pos); pos += 2
+    for _ in range(factory_count):
+        factory_id, action = struct.unpack_from("<hb", payload, pos); pos += 3
+        actions["factory_%d" % factory_id] = action
+    return actions
+
 def cleanup_process():
     global agent_processes
     for agent_key in agent_processes:
@@ -34,7 +124,8 @@ def agent(observation, configuration):
             cwd = os.path.dirname(configuration["__raw_path__"])
         else:
             cwd = os.path.dirname(__file__)
-        agent_process = Popen(["./docker_build/agent.out"], stdin=PIPE, stdout=PIPE, stderr=PIPE, cwd=cwd)
+        args = ["./docker_build/agent.out"] + (["--binary"] if BINARY_PROTOCOL else [])
+        agent_process = Popen(args, stdin=PIPE, stdout=PIPE, stderr=PIPE, cwd=cwd)
         agent_processes[observation.player] = agent_process
         atexit.register(cleanup_process)
 
@@ -43,11 +134,17 @@ def agent(observation, configuration):
         t = Thread(target=enqueue_output, args=(agent_process.stderr, q_stderr))
         t.daemon = True # thread dies with the program
         t.start()
-    data = json.dumps(dict(obs=json.loads(observation.obs), step=observation.step, remainingOverageTime=observation.remainingOverageTime, player=observation.player, info=configuration))
-    agent_process.stdin.write(f"{data}\n".encode())
-    agent_process.stdin.flush()
+    if BINARY_PROTOCOL:
+        data = encode_obs(json.loads(observation.obs), observation.step, observation.remainingOverageTime, observation.player)
+        agent_process.stdin.write(data)
+        agent_process.stdin.flush()
+        payload = read_frame(agent_process.stdout)
+    else:
+        data = json.dumps(dict(obs=json.loads(observation.obs), step=observation.step, remainingOverageTime=observation.remainingOverageTime, player=observation.player, info=configuration))
+        agent_process.stdin.write(f"{data}\n".encode())
+        agent_process.stdin.flush()
 
-    agent1res = (agent_process.stdout.readline()).decode()
+        agent1res = (agent_process.stdout.readline()).decode()
     while True:
         try:  line = q_stderr.get_nowait()
         except Empty:
@@ -56,6 +153,8 @@ def agent(observation, configuration):
         else:
             # standard error output received, print it out
             print(line.decode(), file=sys.stderr, end='')
+    if BINARY_PROTOCOL:
+        return decode_actions(payload) if payload else {}
     if agent1res == "":
         return {}
     return json.loads(agent1res)
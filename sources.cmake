@@ -3,3 +3,9 @@ set(AGENT_SRC_FILES
     src/agent_setup.cpp
     src/agent_act.cpp
 )
+
+set(REPLAY_SRC_FILES
+    src/replay.cpp
+    src/agent_setup.cpp
+    src/agent_act.cpp
+)
@@ -4,6 +4,8 @@
 #include <string>
 
 #include "lux/json.hpp"
+#include "lux/observation.hpp"
+#include "lux/time_budget.hpp"
 
 
 typedef struct Agent {
@@ -17,11 +19,17 @@ typedef struct Agent {
     int64_t metal_left;
     bool place_first;
 
+    int sim_iterations;  // future sim steps completed during the last act()
+    TimeBudget time_budget;
+
     bool isTurnToPlaceFactory() const {
         return step % 2 == (place_first ? 1 : 0);
     }
 
+    void init(struct Observation &obs);  // per-turn input, also (re-)inits board
     json setup();
-    json act();
+    void act(struct ActionWriter *writer);
+    void simulate(int future_sim);  // future sim loop of act(), may throw WatchdogExpired after step 0
 } Agent;
-extern Agent agent;
+extern thread_local Agent *g_agent;  // owned by the current MatchContext
+inline Agent &agent() { return *g_agent; }  // the calling thread's match, see MatchContext::bind
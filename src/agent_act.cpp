@@ -2,30 +2,62 @@
 
 #include <string>
 
+#include "lux/action_writer.hpp"
 #include "lux/board.hpp"
 #include "lux/defs.hpp"
 #include "lux/exception.hpp"
 #include "lux/factory_group.hpp"
 #include "lux/log.hpp"
+#include "lux/match.hpp"
 #include "lux/unit_group.hpp"
 using namespace std;
 
 
-json Agent::act() {
-    double start_time = get_time();
-    string board_summary = board.summary();
+void Agent::act(ActionWriter *writer) {
+    string board_summary = board().summary();
+
+    double max_time = prod() ? MAX_TIME_PROD : MAX_TIME_DEV;
+    int future_sim = prod() ? FUTURE_SIM_PROD : FUTURE_SIM_DEV;
+    this->sim_iterations = 0;
+    this->time_budget.begin_loop(board().real_env_step, this->remainingOverageTime, max_time);
+
+    bool fallback = false;
+    try {
+        this->simulate(future_sim);
+    } catch (WatchdogExpired const&) {
+        fallback = true;
+        board().abandon_step_simulation();
+        // Only the step 0 actions are final, drop those appended by the abandoned steps
+        for (Unit *unit : board().player->units()) {
+            if (unit->build_step <= board().step && !unit->new_action_queue.empty()) {
+                unit->new_action_queue.resize(1);
+            }
+        }
+    }
+
+    this->time_budget.end_loop(this->sim_iterations, fallback);
 
-    double max_time = g_prod ? MAX_TIME_PROD : MAX_TIME_DEV;
-    int future_sim = g_prod ? FUTURE_SIM_PROD : FUTURE_SIM_DEV;
+    board().player->get_new_actions(writer);
 
+    if (board().step % 20 == 0 || board().step == 999) {
+        LUX_LOG(board_summary << ", " << this->sim_iterations << "/"
+                << this->time_budget.horizon_avg() << "/" << this->time_budget.horizon_min << "H, "
+                << this->time_budget.near_misses << "-" << this->time_budget.fallbacks << "wD");
+    }
+
+    board().load();
+    this->time_budget.end_turn();
+}
+
+void Agent::simulate(int future_sim) {
     for (int i = 0; i < future_sim; i++) {
-        if (board.sim_step == 1000) break;
+        if (board().sim_step == 1000) break;
         LUX_LOG_DEBUG("AA A");
-        if (i == 0) board.save_begin();
-        board.begin_step_simulation();
+        if (i == 0) board().save_begin();
+        board().begin_step_simulation();
 
-        UnitGroup ugroup{.step = board.step + i};
-        FactoryGroup fgroup{.step = board.step + i};
+        UnitGroup ugroup{.step = board().step + i};
+        FactoryGroup fgroup{.step = board().step + i};
 
         ugroup.do_move_998();
         ugroup.do_dig_999();
@@ -183,23 +215,17 @@ json Agent::act() {
         ugroup.finalize();
         if (i == 0) fgroup.finalize();
 
-        board.end_step_simulation();
-        if (i == 0) board.save_end();
+        board().end_step_simulation();
+        if (i == 0) {
+            board().save_end();
+            this->time_budget.arm_watchdog();
+        }
+        this->sim_iterations++;
 
         // Exit early if not enough time to finish another loop
-        double elapsed_time = get_time() - start_time;
-        double time_per_step = elapsed_time / (i + 1);
-        if (elapsed_time + time_per_step > max_time) break;
+        if (!this->time_budget.fits_another_step(i + 1)) break;
 
         LUX_LOG_DEBUG("AA D");
-        board.sim_step += 1;
+        board().sim_step += 1;
     }
-
-    json actions = json::object();
-    board.player->get_new_actions(&actions);
-
-    if (board.step % 20 == 0 || board.step == 999) LUX_LOG(board_summary);
-
-    board.load();
-    return actions;
 }
@@ -49,6 +49,24 @@ using namespace std;
 */
 
 
+void Agent::init(Observation &obs) {
+    this->time_budget.turn_start = get_time();
+    this->step = obs.step;
+    this->remainingOverageTime = obs.remainingOverageTime;
+    if (this->step == 0) {
+        this->player = obs.player;
+        this->factories_per_team = obs.factories_per_team;
+        this->factories_left = obs.factories_per_team;
+    } else if (this->step == 1) {
+        ObsTeam &team = obs.teams[this->player == "player_0" ? 0 : 1];
+        this->water_left = team.water;
+        this->metal_left = team.metal;
+        this->place_first = team.place_first;
+    }
+
+    board().init(obs, this->step, this->player == "player_0");
+}
+
 json Agent::setup() {
     json actions = json::object();
 
@@ -58,15 +76,15 @@ json Agent::setup() {
     }
 
     // Update ice vuln count and ore mult
-    board._ice_vuln_count = 0;
+    board()._ice_vuln_count = 0;
     double ore_mult = 1;
-    if (board.step > 0) {
-        for (Factory *opp_factory : board.opp->factories()) {
+    if (board().step > 0) {
+        for (Factory *opp_factory : board().opp->factories()) {
             opp_factory->_ice_vuln_covered = false;
             vector<Cell*> &ice_vuln_cells = opp_factory->cell->ice_vulnerable_cells();
-            for (Factory *own_factory : board.player->factories()) {
+            for (Factory *own_factory : board().player->factories()) {
                 if (count(ice_vuln_cells.begin(), ice_vuln_cells.end(), own_factory->cell)) {
-                    board._ice_vuln_count += 1;
+                    board()._ice_vuln_count += 1;
                     opp_factory->_ice_vuln_covered = true;
                     //LUX_LOG(*opp_factory << " IC covered by " << *own_factory);
                     break;
@@ -76,10 +94,10 @@ json Agent::setup() {
 
         int opp_ore_count = 0;
         int own_ore_count = 0;
-        for (Factory *opp_factory : board.opp->factories()) {
+        for (Factory *opp_factory : board().opp->factories()) {
             if (opp_factory->ore_cells[0]->man_dist_factory(opp_factory) <= 5) opp_ore_count++;
         }
-        for (Factory *own_factory : board.player->factories()) {
+        for (Factory *own_factory : board().player->factories()) {
             if (own_factory->ore_cells[0]->man_dist_factory(own_factory) <= 5) own_ore_count++;
         }
         if (opp_ore_count >= own_ore_count) {
@@ -89,9 +107,9 @@ json Agent::setup() {
 
     // Score each possible spawn_cell
     vector<pair<Cell*, double> > cell_scores1;
-    for (Cell &spawn_cell : board.cells) {
+    for (Cell &spawn_cell : board().cells) {
         if (spawn_cell.valid_spawn) {
-            //if (board.step == 10
+            //if (board().step == 10
             //    && spawn_cell.x == 61
             //    && spawn_cell.y == 43) (void)spawn_cell.get_spawn_score(ore_mult, true);
             double score = spawn_cell.get_spawn_score(ore_mult);
@@ -120,13 +138,13 @@ json Agent::setup() {
     // First step: bid for first factory placement
     if (this->step == 0) {
         // Low ice seeds: 109, 44570609, 517525016, 682050041, 917281543
-	actions["bid"] = (board.low_iceland() ? 30 : 0);
+	actions["bid"] = (board().low_iceland() ? 30 : 0);
 	actions["faction"] = "AlphaStrike";
 	return actions;
     }
 
     // Debug print:
-    if (board.step <= 2) {
+    if (board().step <= 2) {
         for (int i = 0; i < 3; i++) {
             (void)cell_scores2[i].first->get_spawn_score(ore_mult, /*verbose*/true);
         }
@@ -142,8 +160,8 @@ json Agent::setup() {
     int water = this->water_left / this->factories_left;
     if (water % 10 != 0 && this->water_left >= water + 10 - (water % 10)) water += 10 - (water % 10);
 
-    int factory_num = (board.step + 1) / 2;
-    if (board.low_iceland()) {
+    int factory_num = (board().step + 1) / 2;
+    if (board().low_iceland()) {
         if (factory_num <= 2) {
             water = MIN(this->water_left, 200);
         }
@@ -0,0 +1,119 @@
+#include "lux/action_writer.hpp"
+
+#include <charconv>  // to_chars
+
+#include "lux/wire.hpp"
+using namespace std;
+
+
+void ActionWriter::begin() {
+    this->buf.clear();
+    this->action_count = 0;
+    this->_count = 0;
+    this->_in_factories = false;
+    if (this->binary) {
+        wire_put<uint32_t>(&this->buf, 0);  // frame length, set in end()
+        wire_put<uint8_t>(&this->buf, WireFrame_ACTIONS);
+        this->_count_offset = this->buf.size();
+        wire_put<uint16_t>(&this->buf, 0);
+    } else {
+        this->buf.push_back('{');
+    }
+}
+
+void ActionWriter::_int(int val) {
+    char tmp[12];
+    auto res = to_chars(tmp, tmp + sizeof(tmp), val);
+    this->buf.append(tmp, res.ptr);
+}
+
+void ActionWriter::unit(int16_t unit_id, vector<ActionSpec> &action_queue) {
+    if (this->binary) {
+        wire_put<int16_t>(&this->buf, unit_id);
+        wire_put<uint8_t>(&this->buf, action_queue.size());
+        for (ActionSpec &spec : action_queue) {
+            wire_put<int8_t>(&this->buf, spec.action);
+            wire_put<int8_t>(&this->buf, spec.direction);
+            wire_put<int8_t>(&this->buf, spec.resource);
+            wire_put<int16_t>(&this->buf, spec.amount);
+            wire_put<int16_t>(&this->buf, spec.repeat);
+            wire_put<int16_t>(&this->buf, spec.n);
+        }
+    } else {
+        if (this->_count) this->buf.push_back(',');
+        this->buf.append("\"unit_");
+        this->_int(unit_id);
+        this->buf.append("\":[");
+        for (size_t i = 0; i < action_queue.size(); i++) {
+            ActionSpec &spec = action_queue[i];
+            if (i) this->buf.push_back(',');
+            this->buf.push_back('[');
+            this->_int(spec.action); this->buf.push_back(',');
+            this->_int(spec.direction); this->buf.push_back(',');
+            this->_int(spec.resource); this->buf.push_back(',');
+            this->_int(spec.amount); this->buf.push_back(',');
+            this->_int(spec.repeat); this->buf.push_back(',');
+            this->_int(spec.n);
+            this->buf.push_back(']');
+        }
+        this->buf.push_back(']');
+    }
+    this->action_count++;
+    this->_count++;
+}
+
+void ActionWriter::_begin_factories() {
+    if (this->_in_factories) return;
+    this->_in_factories = true;
+    if (this->binary) {
+        wire_set<uint16_t>(&this->buf, this->_count_offset, this->_count);
+        this->_count_offset = this->buf.size();
+        this->_count = 0;
+        wire_put<uint16_t>(&this->buf, 0);
+    }
+}
+
+void ActionWriter::factory(int16_t factory_id, FactoryAction action) {
+    this->_begin_factories();
+    if (this->binary) {
+        wire_put<int16_t>(&this->buf, factory_id);
+        wire_put<int8_t>(&this->buf, action);
+    } else {
+        if (this->buf.size() > 1) this->buf.push_back(',');
+        this->buf.append("\"factory_");
+        this->_int(factory_id);
+        this->buf.append("\":");
+        this->_int(action);
+    }
+    this->action_count++;
+    this->_count++;
+}
+
+void ActionWriter::end() {
+    this->_begin_factories();
+    if (this->binary) {
+        wire_set<uint16_t>(&this->buf, this->_count_offset, this->_count);
+        wire_set<uint32_t>(&this->buf, 0, this->buf.size() - sizeof(uint32_t));
+    } else {
+        this->buf.append("}\n");
+    }
+}
+
+void ActionWriter::write_json(json &output) {
+    this->buf.clear();
+    this->action_count = output.size();
+    if (this->binary) {
+        string text = output.dump();
+        wire_put<uint32_t>(&this->buf, text.size() + 1);
+        wire_put<uint8_t>(&this->buf, WireFrame_JSON);
+        this->buf.append(text);
+    } else {
+        this->buf.append(output.dump());
+        this->buf.push_back('\n');
+    }
+}
+
+void ActionWriter::flush(ostream &out) {
+    out.write(this->buf.data(), this->buf.size());
+    out.flush();
+}
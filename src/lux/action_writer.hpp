@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lux/action.hpp"
+#include "lux/json.hpp"
+
+
+// Serializes one turn of actions straight into a reusable buffer, either as the json action dict
+// or as a --binary frame (see lux/wire.hpp). Call begin(), then unit()/factory() in that order,
+// then end() and a single flush().
+typedef struct ActionWriter {
+    bool binary;
+    std::string buf;
+    int action_count;  // units with a new action queue + factories with an action
+
+    size_t _count_offset;
+    uint16_t _count;
+    bool _in_factories;
+
+    // ~~~ Methods:
+
+    void begin();
+    void unit(int16_t unit_id, std::vector<ActionSpec> &action_queue);
+    void factory(int16_t factory_id, FactoryAction action);
+    void end();
+    void write_json(json &output);  // bidding/placement responses
+    void flush(std::ostream &out);
+
+    void _int(int val);
+    void _begin_factories();
+} ActionWriter;
@@ -0,0 +1,135 @@
+#include "lux/bitboard.hpp"
+
+#include <bit>  // countr_zero, popcount
+#include <vector>
+
+#include "lux/defs.hpp"
+using namespace std;
+
+
+bool BitBoard::any() const {
+    uint64_t res = 0;
+    for (int y = 0; y < SIZE; y++) res |= this->rows[y];
+    return res != 0;
+}
+
+BitBoard BitBoard::operator|(const BitBoard &other) const {
+    BitBoard res;
+    for (int y = 0; y < SIZE; y++) res.rows[y] = this->rows[y] | other.rows[y];
+    return res;
+}
+
+BitBoard BitBoard::operator&(const BitBoard &other) const {
+    BitBoard res;
+    for (int y = 0; y < SIZE; y++) res.rows[y] = this->rows[y] & other.rows[y];
+    return res;
+}
+
+BitBoard BitBoard::and_not(const BitBoard &other) const {
+    BitBoard res;
+    for (int y = 0; y < SIZE; y++) res.rows[y] = this->rows[y] & ~other.rows[y];
+    return res;
+}
+
+BitBoard BitBoard::dilate() const {
+    BitBoard res;
+    for (int y = 0; y < SIZE; y++) {
+        uint64_t row = this->rows[y];
+        res.rows[y] = (row | (row >> 1) | (row << 1)
+                       | (y > 0 ? this->rows[y - 1] : 0)
+                       | (y < SIZE - 1 ? this->rows[y + 1] : 0));
+    }
+    return res;
+}
+
+BitBoard BitBoard::two_neighbors() const {
+    BitBoard res;
+    for (int y = 0; y < SIZE; y++) {
+        // Set cells adjacent to cell (x, y) in each direction, aligned to (x, y)
+        uint64_t a = (y > 0 ? this->rows[y - 1] : 0);
+        uint64_t b = (y < SIZE - 1 ? this->rows[y + 1] : 0);
+        uint64_t c = this->rows[y] >> 1;
+        uint64_t d = this->rows[y] << 1;
+        res.rows[y] = (a & b) | (a & c) | (a & d) | (b & c) | (b & d) | (c & d);
+    }
+    return res;
+}
+
+// Union-find over horizontal runs of set bits, so the cost scales with the number of runs
+// rather than with region diameter.
+int BitBoard::label_regions(int16_t first_label, int16_t *labels, int16_t *sizes,
+                            vector<int> *region_sizes) const {
+    static thread_local vector<uint64_t> run_bits;
+    static thread_local vector<int16_t> run_y;
+    static thread_local vector<int16_t> run_parent;
+    run_bits.clear();
+    run_y.clear();
+    run_parent.clear();
+
+    auto find = [&](int run) {
+        while (run_parent[run] != run) {
+            run_parent[run] = run_parent[run_parent[run]];
+            run = run_parent[run];
+        }
+        return run;
+    };
+
+    int prev_begin = 0, prev_end = 0;
+    for (int y = 0; y < SIZE; y++) {
+        int cur_begin = run_bits.size();
+        uint64_t row = this->rows[y];
+        while (row) {
+            uint64_t low = row & -row;
+            uint64_t run = row & ~(row + low);  // lowest run of consecutive set bits
+            row &= ~run;
+            int16_t index = run_bits.size();
+            run_bits.push_back(run);
+            run_y.push_back(y);
+            run_parent.push_back(index);
+            for (int prev = prev_begin; prev < prev_end; prev++) {
+                if (run_bits[prev] & run) {
+                    int a = find(prev), b = find(index);
+                    if (a != b) run_parent[MAX(a, b)] = MIN(a, b);  // root is the earliest run
+                }
+            }
+        }
+        prev_begin = cur_begin;
+        prev_end = run_bits.size();
+    }
+
+    // Runs are in cell id order and roots are each region's first run, so labels follow the
+    // lowest cell id of each region
+    int run_count = run_bits.size();
+    static thread_local vector<int> root_label;
+    static thread_local vector<int> root_size;
+    root_label.assign(run_count, -1);
+    root_size.assign(run_count, 0);
+    int region_count = 0;
+    for (int run = 0; run < run_count; run++) {
+        int root = find(run);
+        if (root_label[root] < 0) root_label[root] = region_count++;
+        root_size[root] += popcount(run_bits[run]);
+    }
+    if (region_sizes) {
+        region_sizes->assign(region_count, 0);
+        for (int run = 0; run < run_count; run++) {
+            if (run_parent[run] == run) (*region_sizes)[root_label[run]] = root_size[run];
+        }
+    }
+
+    for (int cell_id = 0; cell_id < SIZE2; cell_id++) labels[cell_id] = sizes[cell_id] = -1;
+    for (int run = 0; run < run_count; run++) {
+        int root = find(run);
+        int16_t label = first_label + root_label[root];
+        int16_t size = root_size[root];
+        uint64_t bits = run_bits[run];
+        int base = run_y[run] * SIZE;
+        while (bits) {
+            int cell_id = base + countr_zero(bits);
+            labels[cell_id] = label;
+            sizes[cell_id] = size;
+            bits &= bits - 1;
+        }
+    }
+    return region_count;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>  // memset
+#include <vector>
+
+#include "lux/defs.hpp"
+
+static_assert(SIZE == 64, "BitBoard rows are uint64_t");
+
+
+// One boolean layer of the map: bit x of rows[y] is cell (x, y), i.e. cell id y * SIZE + x.
+// Whole-board ops are straight loops over the 64 rows so the compiler can vectorize them.
+typedef struct BitBoard {
+    uint64_t rows[SIZE];
+
+    // ~~~ Methods:
+
+    inline void clear() { memset(this->rows, 0, sizeof(this->rows)); }
+    inline bool get(int cell_id) const { return (this->rows[cell_id / SIZE] >> (cell_id % SIZE)) & 1; }
+    inline void set(int cell_id) { this->rows[cell_id / SIZE] |= (uint64_t)1 << (cell_id % SIZE); }
+
+    bool any() const;
+    BitBoard operator|(const BitBoard &other) const;
+    BitBoard operator&(const BitBoard &other) const;
+    BitBoard and_not(const BitBoard &other) const;
+
+    BitBoard dilate() const;  // set cells plus their 4-neighbors
+    BitBoard two_neighbors() const;  // cells with at least 2 set 4-neighbors
+
+    // Labels the 4-connected regions as first_label, first_label + 1, .. in order of their lowest
+    // cell id; labels/sizes get -1 for unset cells. Returns the number of regions.
+    int label_regions(int16_t first_label, int16_t *labels, int16_t *sizes,
+                      std::vector<int> *region_sizes = NULL) const;
+} BitBoard;
@@ -1,7 +1,7 @@
 #include "lux/board.hpp"
 
-#include <algorithm>  // reverse, stable_sort
-#include <queue>  // priority_queue
+#include <algorithm>  // fill_n, reverse, stable_sort
+#include <cstring>  // memcmp, memcpy, memset
 #include <stack>
 
 #include "agent.hpp"
@@ -13,6 +13,8 @@
 #include "lux/mode.hpp"
 #include "lux/mode_default.hpp"
 #include "lux/mode_ice_conflict.hpp"
+#include "lux/object_pool.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/player.hpp"
 #include "lux/role.hpp"
 #include "lux/role_blockade.hpp"
@@ -27,20 +29,20 @@
 using namespace std;
 
 
-void Board::init(json &obs, int agent_step, bool is_player0) {
-    json &board_info = obs.at("board");
-
+void Board::init(Observation &obs, int agent_step, bool is_player0) {
     // Init all cells during bidding step
     if (agent_step == 0) {
-        this->_flood_fill_call_id = 0;
-        this->_pathfind_call_id = 0;
+        LUX_ASSERT(obs.has_ice && obs.has_ore && obs.has_rubble);
+        this->terrain_epoch = 0;
+        this->booking_version = 1;
+        this->_unit_cells.clear();
         for (int16_t x = 0; x < SIZE; x++) {
 	    for (int16_t y = 0; y < SIZE; y++) {
 		int16_t cell_id = y * SIZE + x;
-		int ice = board_info.at("ice").at(x).at(y);
-		int ore = board_info.at("ore").at(x).at(y);
-		int rubble = board_info.at("rubble").at(x).at(y);
-		this->cells[cell_id].init(cell_id, x, y, ice, ore, rubble);
+		int ice = obs.ice[cell_id];
+		int ore = obs.ore[cell_id];
+		int rubble = obs.rubble[cell_id];
+		this->cells[cell_id].init(cell_id, x, y, ice, ore, rubble, &this->planes);
 	    }
 	}
 	for (Cell &cell : this->cells) {
@@ -55,6 +57,11 @@ void Board::init(json &obs, int agent_step, bool is_player0) {
                 rc = ice_cell->radius_cell_factory(1, rc);
             }
 	}
+        this->_bits.ice.clear();
+        this->_bits.ore.clear();
+        for (Cell *ice_cell : this->ice_cells) this->_bits.ice.set(ice_cell->id);
+        for (Cell *ore_cell : this->ore_cells) this->_bits.ore.set(ore_cell->id);
+
         this->factories.reserve(20);
         this->units.reserve(5000); // This must be SAFELY high enough
         //LUX_LOG("cell: " << sizeof(Cell));
@@ -66,7 +73,7 @@ void Board::init(json &obs, int agent_step, bool is_player0) {
         this->update_icelands();
     }
 
-    this->real_env_step = obs.at("real_env_steps");
+    this->real_env_step = obs.real_env_steps;
     if (this->real_env_step >= 0) {
 	this->step = this->real_env_step;
     } else {
@@ -75,37 +82,37 @@ void Board::init(json &obs, int agent_step, bool is_player0) {
     this->sim_step = this->step;
 
     // Full (re-)init for bidding, factory placement, and first real step
+    bool terrain_changed = false;
     if (real_env_step <= 0) {
+        this->changed_cell_count = SIZE2;
+        this->_save_all = true;
+        terrain_changed = true;
+
 	// Get player water/metal/strains data for each player
 	if (agent_step > 0) {  // Not included for bidding step
-	    string player_id_str = is_player0 ? "player_0" : "player_1";
 	    this->home.init(
 		is_player0,
-		obs.at("teams").at(player_id_str).at("factory_strains"));
-	    string opp_id_str = is_player0 ? "player_1" : "player_0";
+		obs.teams[is_player0 ? 0 : 1].factory_strains);
 	    this->away.init(
 		!is_player0,
-		obs.at("teams").at(opp_id_str).at("factory_strains"));
+		obs.teams[is_player0 ? 1 : 0].factory_strains);
             this->player = &this->home.player;
             this->opp = &this->away.player;
 	}
 
 	// Get basic factory info
-	for (auto &[_, factories_info] : obs.at("factories").items()) {
-	    for (auto &[__, factory_info] : factories_info.items()) {
-		int16_t factory_id = factory_info.at("strain_id");
-		json &cargo_info = factory_info.at("cargo");
-                if (this->factories.size() <= (size_t)factory_id) {
-                    this->factories.resize(factory_id + 1);
-                }
-		this->factories[factory_id].init(
-		    factory_id,
-		    factory_info.at("team_id"),
-		    factory_info.at("pos").at(0),
-		    factory_info.at("pos").at(1),
-		    cargo_info.at("water"),
-		    cargo_info.at("metal"));
+	for (ObsFactory &factory_info : obs.factories) {
+	    int16_t factory_id = factory_info.id;
+	    if (this->factories.size() <= (size_t)factory_id) {
+		this->factories.resize(factory_id + 1);
 	    }
+	    this->factories[factory_id].init(
+		factory_id,
+		factory_info.team_id,
+		factory_info.x,
+		factory_info.y,
+		factory_info.water,
+		factory_info.metal);
 	}
 
         // Update dist from each cell to nearest factory of each team
@@ -114,66 +121,53 @@ void Board::init(json &obs, int agent_step, bool is_player0) {
         }
     } else {  // real_env_step > 0
 	// Update cell rubble, lichen, lichen_strain
-	for (const auto &[k, v] : board_info.at("rubble").items()) {
-	    size_t offset = k.find_first_of(',');
-	    int16_t x = static_cast<int16_t>(std::stol(k.substr(0, offset)));
-	    int16_t y = static_cast<int16_t>(std::stol(k.substr(offset + 1)));
-	    this->cell(x, y)->reinit_rubble(v);
-	}  for (const auto &[k, v] : board_info.at("lichen").items()) {
-	    size_t offset = k.find_first_of(',');
-	    int16_t x = static_cast<int16_t>(std::stol(k.substr(0, offset)));
-	    int16_t y = static_cast<int16_t>(std::stol(k.substr(offset + 1)));
-	    this->cell(x, y)->reinit_lichen(v);
-	}  for (const auto &[k, v] : board_info.at("lichen_strains").items()) {
-	    size_t offset = k.find_first_of(',');
-	    int16_t x = static_cast<int16_t>(std::stol(k.substr(0, offset)));
-	    int16_t y = static_cast<int16_t>(std::stol(k.substr(offset + 1)));
-	    this->cell(x, y)->reinit_lichen_strain(v);
+	for (ObsCellDelta &delta : obs.cell_deltas) {
+	    Cell *cell = &this->cells[delta.cell_id];
+	    this->_changed_cells.push_back(delta.cell_id);
+	    if (delta.fields & CellDelta_RUBBLE) {
+                cell->reinit_rubble(delta.rubble);
+                terrain_changed = true;
+            }
+	    if (delta.fields & CellDelta_LICHEN) cell->reinit_lichen(delta.lichen);
+	    if (delta.fields & CellDelta_LICHEN_STRAIN) cell->reinit_lichen_strain(delta.lichen_strain);
 	}
+	this->changed_cell_count = obs.cell_deltas.size();
 
         // init/re-init units
-        for (auto &[_, units_info] : obs.at("units").items()) {
-            for (auto &[__, unit_info] : units_info.items()) {
-                string unit_id_str = unit_info.at("unit_id");
-                int16_t unit_id = stoi(unit_id_str.substr(unit_id_str.find("_") + 1));
-                json &cargo_info = unit_info.at("cargo");
-
-                if (this->units.capacity() <= (size_t)unit_id) {
-                    LUX_ASSERT(false);
-                }
-                if (this->units.size() <= (size_t)unit_id) {
-                    this->units.resize(unit_id + 1);
-                }
+        for (ObsUnit &unit_info : obs.units) {
+            int16_t unit_id = unit_info.id;
 
-                string unit_type = unit_info.at("unit_type");
-                this->units[unit_id].init(
-                    unit_id,
-                    unit_info.at("team_id"),
-                    unit_info.at("pos").at(0),
-                    unit_info.at("pos").at(1),
-                    unit_type.at(0) == 'H',
-                    this->step,
-                    cargo_info.at("ice"),
-                    cargo_info.at("ore"),
-                    cargo_info.at("water"),
-                    cargo_info.at("metal"),
-                    unit_info.at("power"),
-                    &unit_info.at("action_queue"));  // json array of json arrays
+            if (this->units.capacity() <= (size_t)unit_id) {
+                LUX_ASSERT(false);
+            }
+            if (this->units.size() <= (size_t)unit_id) {
+                this->units.resize(unit_id + 1);
             }
+
+            this->units[unit_id].init(
+                unit_id,
+                unit_info.team_id,
+                unit_info.x,
+                unit_info.y,
+                unit_info.heavy,
+                this->step,
+                unit_info.ice,
+                unit_info.ore,
+                unit_info.water,
+                unit_info.metal,
+                unit_info.power,
+                unit_info.aq,
+                unit_info.aq_len);
         }
 
 	// Get non-basic factory info
-	for (auto &[_, factories_info] : obs.at("factories").items()) {
-	    for (auto &[__, factory_info] : factories_info.items()) {
-		int16_t factory_id = factory_info.at("strain_id");
-		json &cargo_info = factory_info.at("cargo");
-		this->factories[factory_id].reinit(
-		    cargo_info.at("ice"),
-		    cargo_info.at("ore"),
-		    cargo_info.at("water"),
-		    cargo_info.at("metal"),
-		    factory_info.at("power"));
-	    }
+	for (ObsFactory &factory_info : obs.factories) {
+	    this->factories[factory_info.id].reinit(
+		factory_info.ice,
+		factory_info.ore,
+		factory_info.water,
+		factory_info.metal,
+		factory_info.power);
 	}
 
 	// Check for newly destroyed units and factories
@@ -185,6 +179,7 @@ void Board::init(json &obs, int agent_step, bool is_player0) {
         for (Factory &factory : this->factories) {
 	    if (factory.alive_step && factory.alive_step == this->step - 1) {
 		factory.handle_destruction();
+                terrain_changed = true;
 
                 // Update dist from each cell to nearest factory of each team
                 for (Cell &cell : this->cells) {
@@ -194,13 +189,14 @@ void Board::init(json &obs, int agent_step, bool is_player0) {
 	}
     }
 
-    if (board_info.find("valid_spawns_mask") != board_info.end()) {
-	for (int16_t x = 0; x < SIZE; x++) {
-	    for (int16_t y = 0; y < SIZE; y++) {
-		this->cell(x, y)->valid_spawn = board_info.at("valid_spawns_mask").at(x).at(y);
-	    }
+    if (obs.has_valid_spawns_mask) {
+	for (int16_t cell_id = 0; cell_id < SIZE2; cell_id++) {
+	    this->cells[cell_id].valid_spawn = obs.valid_spawns_mask[cell_id];
 	}
     }
+
+    this->_bits_dirty = true;
+    if (terrain_changed) this->terrain_epoch += 1;
 }
 
 string Board::summary() {
@@ -227,9 +223,9 @@ string Board::summary() {
 
     int plt = 0, olt = 0, plc = 0, olc = 0;
     for (Cell &c : this->cells) {
-        if (c.lichen > 0) {
-            if (this->player->is_strain(c.lichen_strain)) { plt += c.lichen; plc++; }
-            else { olt += c.lichen; olc++; }
+        if (c.lichen() > 0) {
+            if (this->player->is_strain(c.lichen_strain())) { plt += c.lichen(); plc++; }
+            else { olt += c.lichen(); olc++; }
         }
     }
 
@@ -238,13 +234,14 @@ string Board::summary() {
 
     int unit_steps = 0;
     int aq_count = 0;
-    for (Unit &u : board.units) {
-        if (u.player == board.player) {
+    for (Unit &u : board().units) {
+        if (u.player == board().player) {
             unit_steps += (u.alive_step - u.build_step);
             aq_count += u.action_queue_update_count;
         }
     }
     double aqlen = (aq_count > 0 ? unit_steps / (double)aq_count : 0);
+    ObjectPoolStats pool = pool_stats();  // role/mode allocations, total-from heap
 
     return (
         ""
@@ -254,15 +251,34 @@ string Board::summary() {
         + to_string(pp) + "-" + to_string(op) + "kP, "
         + to_string(plt) + "-" + to_string(olt) + "L, "
         + to_string((int)pi) + "-" + to_string((int)oi) + "I, "
-        + to_string(aqlen) + "/aq");
+        + to_string(aqlen) + "/aq, "
+        + to_string(this->changed_cell_count) + "dC, "
+        + to_string(pool.allocs) + "-" + to_string(pool.heap_allocs) + "oA");
 }
 
 void Board::save_begin() {
     // Save some stats e.g. position for each unit
     this->_save_units_len = this->units.size();
-    for (Cell &cell : this->cells) {
-	cell.save_begin();
-    }
+    // Save these values at beginning of step 0 simulation because they will be updated via diff.
+    // Since the last save_begin or load, the planes only differ from the saved ones where init applied diffs
+    if (this->_save_all) {
+        memcpy(this->_save_rubble, this->planes.rubble, sizeof(this->_save_rubble));
+        memcpy(this->_save_lichen, this->planes.lichen, sizeof(this->_save_lichen));
+        memcpy(this->_save_lichen_strain, this->planes.lichen_strain, sizeof(this->_save_lichen_strain));
+    } else {
+        for (int16_t cell_id : this->_changed_cells) {
+            this->_save_rubble[cell_id] = this->planes.rubble[cell_id];
+            this->_save_lichen[cell_id] = this->planes.lichen[cell_id];
+            this->_save_lichen_strain[cell_id] = this->planes.lichen_strain[cell_id];
+        }
+    }
+    this->_changed_cells.clear();
+    this->_save_all = false;
+#ifdef DEBUG_BUILD
+    LUX_ASSERT(!memcmp(this->_save_rubble, this->planes.rubble, sizeof(this->_save_rubble)));
+    LUX_ASSERT(!memcmp(this->_save_lichen, this->planes.lichen, sizeof(this->_save_lichen)));
+    LUX_ASSERT(!memcmp(this->_save_lichen_strain, this->planes.lichen_strain, sizeof(this->_save_lichen_strain)));
+#endif
 }
 
 void Board::save_end() {
@@ -273,13 +289,13 @@ void Board::save_end() {
     for (Factory *factory : this->player->factories()) {
         factory->save_end();
     }
-    for (Cell &cell : this->cells) {
-        cell.save_end();
-    }
+    this->_assign_undo.begin();
 }
 
 void Board::load() {
     // Load saved roles, routes, modes, stats, assignments, etc
+    this->booking_version += 1;
+    this->_assign_undo.rollback();  // before dropping units created while simulating
     this->units.resize(this->_save_units_len);
     for (Unit *unit : this->player->units()) {
         unit->load();
@@ -287,11 +303,82 @@ void Board::load() {
     for (Factory *factory : this->player->factories()) {
         factory->load();
     }
-    for (Cell &cell : this->cells) {
-	cell.load();
+    this->load_cells();
+}
+
+void Board::reset_ff_safe(Cell *cell, int radius) {
+    for (int y = MAX(0, cell->y - radius); y <= MIN(SIZE - 1, cell->y + radius); y++) {
+        int x_radius = radius - abs(y - cell->y);
+        Unit **row = this->planes.unit + y * SIZE;
+        for (int x = MAX(0, cell->x - x_radius); x <= MIN(SIZE - 1, cell->x + x_radius); x++) {
+            Unit *unit = row[x];
+            if (unit && unit->player == this->player) {
+                memset(unit->_ff_safe_version, 0, sizeof(unit->_ff_safe_version));
+            }
+        }
     }
 }
 
+BoardBits &Board::bits() {
+    if (this->_bits_dirty) this->_update_bits();
+    return this->_bits;
+}
+
+void Board::_update_bits() {
+    // ice/ore are static and set once by init
+    BoardBits &bits = this->_bits;
+    for (int y = 0; y < SIZE; y++) {
+        uint64_t factory = 0, flat = 0;
+        for (int x = 0; x < SIZE; x++) {
+            int cell_id = y * SIZE + x;
+            uint64_t bit = (uint64_t)1 << x;
+            if (this->planes.factory[cell_id]) factory |= bit;
+            if (this->planes.rubble[cell_id] <= 0) flat |= bit;
+        }
+        bits.factory.rows[y] = factory;
+        bits.flat.rows[y] = flat;
+    }
+    this->_bits_dirty = false;
+}
+
+Unit *Board::history_unit(int past_step, int cell_id) {
+    int16_t index = this->planes.unit_history[past_step % UNIT_HISTORY_STEPS][cell_id];
+    return (index >= 0 ? &this->units[index] : NULL);
+}
+
+bool Board::history_any_unit(Cell *cell, int max_radius, int past_steps, Player *unit_player,
+                             bool heavies, bool lights) {
+    int y_min = MAX(0, cell->y - max_radius);
+    int y_max = MIN(SIZE - 1, cell->y + max_radius);
+    for (int past_step = this->step; past_step >= MAX(0, this->step - past_steps + 1); past_step--) {
+        int16_t *history = this->planes.unit_history[past_step % UNIT_HISTORY_STEPS];
+        for (int y = y_min; y <= y_max; y++) {
+            int x_radius = max_radius - abs(y - cell->y);
+            int16_t *row = history + y * SIZE;
+            for (int x = MAX(0, cell->x - x_radius); x <= MIN(SIZE - 1, cell->x + x_radius); x++) {
+                if (row[x] < 0) continue;
+                Unit *unit = &this->units[row[x]];
+                if (unit->player == unit_player
+                    && unit->alive()
+                    && ((unit->heavy && heavies) || (!unit->heavy && lights))) return true;
+            }
+        }
+    }
+    return false;
+}
+
+void Board::load_cells() {
+    this->_bits_dirty = true;
+    for (int16_t cell_id : this->_unit_cells) {
+        this->planes.unit[cell_id] = NULL;
+        this->planes.unit_next[cell_id] = NULL;
+    }
+    this->_unit_cells.clear();
+    memcpy(this->planes.rubble, this->_save_rubble, sizeof(this->_save_rubble));
+    memcpy(this->planes.lichen, this->_save_lichen, sizeof(this->_save_lichen));
+    memcpy(this->planes.lichen_strain, this->_save_lichen_strain, sizeof(this->_save_lichen_strain));
+}
+
 Cell *Board::cell(int x, int y) {
     if (x < 0 || y < 0 || x >= SIZE || y >= SIZE) return NULL;
     return &this->cells[y * SIZE + x];
@@ -310,6 +397,8 @@ Player *Board::get_player(int player_id) {
 }
 
 void Board::begin_step_simulation() {
+    this->booking_version += 1;  // units have moved
+
     if ((this->step % 100 == 0) && this->sim0()) {  // Only sometimes; TODO: after factories explode?
         this->update_flatlands();
         this->update_lowlands();
@@ -349,19 +438,14 @@ void Board::begin_step_simulation() {
         unit->assigned_unit = NULL;
         if (unit->assigned_factory == NULL) {
             // must be before f.update_units
-            unit->assigned_factory = unit->cell()->nearest_home_factory;
+            this->set_assigned_factory(unit, unit->cell()->nearest_home_factory);
             unit->assigned_factory->add_unit(unit);
         }
         unit->normalize_action_queue();
     }
 
     if (this->sim0()) {  // Only once per step
-        for (Cell &cell : this->cells) {  // all cells
-            cell.update_unit_history(cell.unit);
-            cell.future_heavy_dig_step = INT_MAX;
-            cell.future_light_dig_step = INT_MAX;
-            cell.lichen_dist = INT_MAX;
-        }
+        this->begin_step_cells();
 
         for (Unit &unit : this->units) {  // all units
             unit.update_stats_begin();  // must be before f.update_units
@@ -369,7 +453,7 @@ void Board::begin_step_simulation() {
 
         for (Factory &factory : this->factories) {  // all factories
             factory.update_units();  // must be after u.assigned_factory, u.last_factory
-            if (factory.player == board.opp) factory.update_lichen_info(/*is_begin_step*/true);
+            if (factory.player == board().opp) factory.update_lichen_info(/*is_begin_step*/true);
             factory.update_lichen_bottleneck_info();
         }
 
@@ -440,7 +524,7 @@ void Board::end_step_simulation() {
                 if (role_miner
                     && role_miner->resource_cell->ice
                     && role_miner->resource_cell->assigned_factory == NULL) {
-                    role_miner->resource_cell->assigned_factory = role_miner->get_factory();
+                    this->set_assigned_factory(role_miner->resource_cell, role_miner->get_factory());
                 }
             }
 
@@ -449,23 +533,50 @@ void Board::end_step_simulation() {
         }
     }
 
+    this->end_step_cells();
+}
+
+void Board::abandon_step_simulation() {
+    // Roles set this sim_step still hold cell/unit/factory assignments that load does not restore
+    for (Unit *unit : this->player->units()) {
+        if (unit->role && unit->build_step <= this->sim_step) unit->role->unset();
+    }
+}
+
+void Board::begin_step_cells() {
+    int16_t *history = this->planes.unit_history[this->step % UNIT_HISTORY_STEPS];
+    Unit *units_data = this->units.data();
+    for (int cell_id = 0; cell_id < SIZE2; cell_id++) {
+        Unit *unit = this->planes.unit[cell_id];
+        LUX_ASSERT(!unit || (units_data <= unit && unit < units_data + this->units.size()));
+        history[cell_id] = (unit ? (int16_t)(unit - units_data) : -1);
+    }
+    std::fill_n(this->planes.future_heavy_dig_step, SIZE2, INT_MAX);
+    std::fill_n(this->planes.future_light_dig_step, SIZE2, INT_MAX);
+    std::fill_n(this->planes.lichen_dist, SIZE2, INT_MAX);
+}
+
+void Board::end_step_cells() {
     // Assume opp lichen will grow, decrement everything else.
-    for (Cell &cell : this->cells) {
-        if (this->player->is_strain(cell.lichen_strain)) {
-            cell.lichen -= LICHEN_LOST_WITHOUT_WATER;
-        } else if (cell.lichen > 0) {
+    int8_t *lichen = this->planes.lichen;
+    int8_t *lichen_strain = this->planes.lichen_strain;
+    for (int cell_id = 0; cell_id < SIZE2; cell_id++) {
+        if (this->player->is_strain(lichen_strain[cell_id])) {
+            lichen[cell_id] -= LICHEN_LOST_WITHOUT_WATER;
+        } else if (lichen[cell_id] > 0) {
             // TODO: instead of this growing up-but-not-out logic, we could just have simple logic
             //       for calling factory.do_water for each opp factory each step (e.g. over 100 water).
             //       We would have to call update_lichen_info for opp factories (maybe via can_water())
             //       and would have to apply water_delta to opp factory's water
-            cell.lichen += LICHEN_GAINED_WITH_WATER;
+            lichen[cell_id] += LICHEN_GAINED_WITH_WATER;
         }
-        cell.lichen = MAX(MIN(cell.lichen, MAX_LICHEN_PER_TILE), 0);
-        if (cell.lichen == 0) cell.lichen_strain = -1;
-
-        cell.unit = cell.unit_next;
-        cell.unit_next = NULL;
+        lichen[cell_id] = MAX(MIN(lichen[cell_id], MAX_LICHEN_PER_TILE), 0);
+        if (lichen[cell_id] == 0) lichen_strain[cell_id] = -1;
     }
+
+    memcpy(this->planes.unit, this->planes.unit_next, sizeof(this->planes.unit));
+    memset(this->planes.unit_next, 0, sizeof(this->planes.unit_next));
+    this->_bits_dirty = true;
 }
 
 void Board::update_roles_and_goals() {
@@ -530,16 +641,22 @@ void Board::update_roles_and_goals() {
     }
 
     // Set roles for units without one, continue until all units have roles
+    // Units can keep displacing each other, so after MAX_ROLE_LOOPS the rest recharge, which displaces no one
     LUX_LOG_DEBUG("URG E");
     for (int loop_count = 0, new_role_count = -1; new_role_count != 0; loop_count++) {
         LUX_LOG_DEBUG("URG E " << loop_count << ' ' << new_role_count);
-        LUX_ASSERT(loop_count < 50);
+        LUX_ASSERT(loop_count <= MAX_ROLE_LOOPS + 1);
+        agent().time_budget.check_watchdog();
+        bool const capped = (loop_count >= MAX_ROLE_LOOPS);
+        if (capped) { LUX_LOG("URG E role loop capped at step " << this->sim_step); }
         new_role_count = 0;
 
         for (Unit *unit : this->player->units()) {
             if (unit->role) continue;
             LUX_LOG_DEBUG("URG E1 " << *unit);
-            Role *r = unit->assigned_factory->mode->get_new_role(unit);
+            Role *r;
+            if (capped) RoleRecharge::from_unit(&r, unit);
+            else r = unit->assigned_factory->mode->get_new_role(unit);
             unit->new_role(r);
             LUX_LOG_DEBUG("URG E2 " << *unit << ' ' << *r);
             new_role_count += 1;
@@ -554,60 +671,29 @@ void Board::update_roles_and_goals() {
 }
 
 void Board::update_flatlands() {
+    BoardBits &bits = this->bits();
+    BitBoard flatland = bits.flat.and_not(bits.factory | bits.ore | bits.ice);
+    int16_t labels[SIZE2], sizes[SIZE2];
+    flatland.label_regions(/*first_label*/1, labels, sizes);
     for (Cell &cell : this->cells) {
-        cell.flatland_id = -1; cell.flatland_size = -1;
-    }
-
-    vector<Cell*> flatland_cells;
-    auto cell_cond = [&](Cell *c) {
-        if (c->rubble <= 0 && !c->factory && !c->ore && !c->ice) {
-            flatland_cells.push_back(c);
-            return true;
-        } return false;
-    };
-
-    int16_t next_id = 1;
-    for (Cell &cell : this->cells) {
-        if (cell.flatland_id == -1 && cell_cond(&cell)) {
-            flatland_cells.clear();
-            this->flood_fill(&cell, cell_cond);
-            for (Cell *fcell : flatland_cells) {
-                fcell->flatland_id = next_id;
-                fcell->flatland_size = flatland_cells.size();
-            }
-            next_id += 1;
-            //LUX_LOG("Board::update_flatlands " << cell << ' '
-            //        << cell.flatland_id << ' ' << cell.flatland_size);
-        }
+        cell.flatland_id = labels[cell.id];
+        cell.flatland_size = sizes[cell.id];
     }
 }
 
 void Board::update_lowlands() {
-    for (Cell &cell : this->cells) {
-        cell.lowland_id = -1; cell.lowland_size = -1;
+    BitBoard &lowland = this->bits().lowland;
+    lowland.clear();
+    for (int cell_id = 0; cell_id < SIZE2; cell_id++) {
+        if (this->planes.rubble[cell_id] <= 19) lowland.set(cell_id);
     }
+    lowland = lowland.and_not(this->_bits.factory);  // Allow own factories?
 
-    vector<Cell*> lowland_cells;
-    auto cell_cond = [&](Cell *c) {
-        if (c->rubble <= 19 && !c->factory) {  // Allow own factories?
-            lowland_cells.push_back(c);
-            return true;
-        } return false;
-    };
-
-    int16_t next_id = 10000;
+    int16_t labels[SIZE2], sizes[SIZE2];
+    lowland.label_regions(/*first_label*/10000, labels, sizes);
     for (Cell &cell : this->cells) {
-        if (cell.lowland_id == -1 && cell_cond(&cell)) {
-            lowland_cells.clear();
-            this->flood_fill(&cell, cell_cond);
-            for (Cell *lcell : lowland_cells) {
-                lcell->lowland_id = next_id;
-                lcell->lowland_size = lowland_cells.size();
-            }
-            next_id += 1;
-            //LUX_LOG("Board::update_lowlands " << cell << ' '
-            //        << cell.lowland_id << ' ' << cell.lowland_size);
-        }
+        cell.lowland_id = labels[cell.id];
+        cell.lowland_size = sizes[cell.id];
     }
 }
 
@@ -618,57 +704,28 @@ bool Board::low_iceland() {
     // 517525016: 8, 8
     // 682050041: 6, 14
     // 917281543: 3, 12
-    return 2 * this->iceland_count <= 2*agent.factories_per_team;
+    return 2 * this->iceland_count <= 2*agent().factories_per_team;
 }
 
 void Board::update_icelands() {
-    this->iceland_count = 0;
+    // Ice cells plus cells with at least 2 adjacent ice cells
+    BitBoard &ice = this->_bits.ice;
+    BitBoard iceland = ice | ice.two_neighbors();
+    int16_t labels[SIZE2], sizes[SIZE2];
+    vector<int> region_sizes;
+    iceland.label_regions(/*first_label*/1, labels, sizes, &region_sizes);
     for (Cell &cell : this->cells) {
-        cell.iceland_id = -1; cell.iceland_size = -1;
+        cell.iceland_id = labels[cell.id];
+        cell.iceland_size = sizes[cell.id];
     }
 
-    vector<Cell*> iceland_cells;
-    auto cell_cond = [&](Cell *c) {
-        //for (Cell *neighbor : c->neighbors_plus) {
-        //    if (neighbor->ice) {
-        //        iceland_cells.push_back(c);
-        //        return true;
-        //    }
-        //}
-        //return false;
-
-        bool has_ice = c->ice;
-        if (!has_ice) {
-            int ice_count = 0;
-            for (Cell *neighbor : c->neighbors) {
-                if (neighbor->ice) ice_count++;
-            }
-            if (ice_count >= 2) has_ice = true;
-        }
-        if (has_ice) {
-            iceland_cells.push_back(c);
-            return true;
-        }
-        return false;
-    };
-
-    int16_t next_id = 1;
-    for (Cell &cell : this->cells) {
-        if (cell.iceland_id == -1 && cell_cond(&cell)) {
-            iceland_cells.clear();
-            this->flood_fill(&cell, cell_cond);
-            for (Cell *fcell : iceland_cells) {
-                fcell->iceland_id = next_id;
-                fcell->iceland_size = iceland_cells.size();
-            }
-            next_id += 1;
-            this->iceland_count += 1 + iceland_cells.size() / 9;
-            LUX_LOG("Board::update_icelands " << cell << ' '
-                    << cell.iceland_id << ' ' << cell.iceland_size);
-        }
+    this->iceland_count = 0;
+    for (int size : region_sizes) {
+        this->iceland_count += 1 + size / 9;
+        LUX_LOG("Board::update_icelands " << this->iceland_count << ' ' << size);
     }
 
-    LUX_LOG("Ice regions: " << this->iceland_count << ' ' << 2*agent.factories_per_team);
+    LUX_LOG("Ice regions: " << this->iceland_count << ' ' << 2*agent().factories_per_team);
 }
 
 void Board::update_disconnected_lichen() {
@@ -676,15 +733,15 @@ void Board::update_disconnected_lichen() {
     this->opp->lichen_disconnected_cells.clear();
 
     for (Cell &cell : this->cells) {  // all cells
-        if (cell.lichen && cell.lichen_connected_step != this->step) {
-            Player *player = (this->player->is_strain(cell.lichen_strain) ? this->player : this->opp);
+        if (cell.lichen() && cell.lichen_connected_step != this->step) {
+            Player *player = (this->player->is_strain(cell.lichen_strain()) ? this->player : this->opp);
             player->lichen_disconnected_cells.push_back(&cell);
         }
     }
 }
 
 void Board::update_future_mines() {
-    LUX_ASSERT(board.step == board.sim_step);
+    LUX_ASSERT(board().step == board().sim_step);
 
     this->future_heavy_mine_cell_steps.clear();
     this->future_light_mine_cell_steps.clear();
@@ -702,7 +759,7 @@ void Board::update_future_mines() {
         Cell *cell = opp_unit->cell();
         for (int i = 0; i < opp_unit->aq_len; i++) {
             if (!cell) break;
-            int s = board.step + i;
+            int s = board().step + i;
             ActionSpec &spec = opp_unit->action_queue[i];
             if (spec.action == UnitAction_MOVE) {
                 cell = cell->neighbor(spec.direction);
@@ -710,11 +767,11 @@ void Board::update_future_mines() {
                 if (cell->ice || cell->ore) {
                     mine_cell_steps.push_back(make_pair(cell, s));
                     opp_unit->future_mine_cell_steps.push_back(make_pair(cell, s));
-                } else if (cell->rubble) {
+                } else if (cell->rubble()) {
                     cow_cell_steps.push_back(make_pair(cell, s));
                 }
-                if (opp_unit->heavy) cell->future_heavy_dig_step = MIN(cell->future_heavy_dig_step, s);
-                else cell->future_light_dig_step = MIN(cell->future_light_dig_step, s);
+                if (opp_unit->heavy) cell->future_heavy_dig_step() = MIN(cell->future_heavy_dig_step(), s);
+                else cell->future_light_dig_step() = MIN(cell->future_light_dig_step(), s);
             }
         }
     }
@@ -760,8 +817,8 @@ void Board::update_opp_chains() {
     // find new chains, and update existing chains if they've changed
     vector<Cell*> chain_route;
     for (Factory *opp_factory : this->opp->factories()) {
-        int cost = this->pathfind(
-            opp_factory->cell, NULL,
+        int cost = this->pathfind_t<PathQueue_BFS>(
+            NULL, opp_factory->cell, NULL,
             [&](Cell *c) {
                 return ((c->ice || c->ore)
                         && c->man_dist_factory(opp_factory) > 1
@@ -771,7 +828,7 @@ void Board::update_opp_chains() {
                 Unit *u = c->opp_unit();
                 return !(u
                          && !u->heavy
-                         && !c->factory
+                         && !c->factory()
                          && u->is_chain()); },
             [&](Cell *c, Unit *u) { (void)c; (void)u; return 1; },
             &chain_route);
@@ -795,15 +852,17 @@ void Board::update_opp_chains() {
 }
 
 void Board::flood_fill(Cell *src, function<bool(Cell*)> const& cell_cond) {
-    this->_flood_fill_call_id += 1;
+    SearchScope scope;
+    SearchWorkspace *ws = scope.ws;
+    ws->begin();
     stack<Cell*> stack;
-    stack.push(src); src->flood_fill_call_id = this->_flood_fill_call_id;
+    stack.push(src); ws->path_info[src->id].call_id = ws->call_id;
     while (!stack.empty()) {
         Cell *cell = stack.top(); stack.pop();
         if (cell_cond(cell)) {
             for (Cell *neighbor : cell->neighbors) {
-                if (neighbor->flood_fill_call_id != this->_flood_fill_call_id) {
-                    stack.push(neighbor); neighbor->flood_fill_call_id = this->_flood_fill_call_id;
+                if (!ws->reached(neighbor->id)) {
+                    stack.push(neighbor); ws->path_info[neighbor->id].call_id = ws->call_id;
                 }
             }
         }
@@ -867,11 +926,11 @@ int Board::naive_cost(Unit *unit, Cell *src, Cell *dest_cell) {
     Cell *opp_factory_prev_cell = NULL;
 
     while ((cell != dest_cell)
-           && !(dest_cell->factory_center && cell->factory == dest_cell->factory)) {
+           && !(dest_cell->factory_center && cell->factory() == dest_cell->factory())) {
         // Entered opp factory
         if (!opp_factory && cell->opp_factory(unit->player)) {
             LUX_ASSERT(prev_cell);  // should not be called from opp factory
-            opp_factory = cell->factory;
+            opp_factory = cell->factory();
             opp_factory_prev_cell = prev_cell;
             cost -= unit->cfg->MOVE_COST;
         }
@@ -880,8 +939,8 @@ int Board::naive_cost(Unit *unit, Cell *src, Cell *dest_cell) {
         Cell *best_cell = NULL;
         int min_rubble = INT_MAX;
         for (Cell *neighbor : cell->neighbors) {
-            if (neighbor->rubble < min_rubble && neighbor->man_dist(dest_cell) < cur_dist) {
-                best_cell = neighbor; min_rubble = neighbor->rubble;
+            if (neighbor->rubble() < min_rubble && neighbor->man_dist(dest_cell) < cur_dist) {
+                best_cell = neighbor; min_rubble = neighbor->rubble();
             }
         }
 
@@ -892,7 +951,7 @@ int Board::naive_cost(Unit *unit, Cell *src, Cell *dest_cell) {
         if (!opp_factory) cost += unit->move_basic_cost(cell);
 
         // Exited opp factory
-        if (opp_factory && !cell->factory) {
+        if (opp_factory && !cell->factory()) {
             cost += _naive_cost_around_factory(unit, opp_factory, opp_factory_prev_cell, cell);
             opp_factory = NULL;
         }
@@ -900,7 +959,6 @@ int Board::naive_cost(Unit *unit, Cell *src, Cell *dest_cell) {
     return cost;
 }
 
-// Note: Always check or assert that return value is not INT_MAX
 int Board::pathfind(Unit *unit, Cell *src, Cell *dest_cell,
                     function<bool(Cell*)> const& dest_cond,
                     function<bool(Cell*)> const& avoid_cond,
@@ -908,125 +966,7 @@ int Board::pathfind(Unit *unit, Cell *src, Cell *dest_cell,
                     vector<Cell*> *route,
                     int max_dist,
                     vector<Cell*> *src_cells) {
-    LUX_ASSERT(dest_cell || dest_cond);
-
-    this->_pathfind_call_id += 1;
-    int const move_cost = (unit == NULL ? 20 : unit->cfg->MOVE_COST);
-    double const rubble_movement_cost = (unit == NULL ? 1 : unit->cfg->RUBBLE_MOVEMENT_COST);
-    bool const a_star = (dest_cell && !custom_cost);
-
-    int cost = 0;
-    auto cost_pair = make_pair(cost, cost);
-    priority_queue<PIII, vector<PIII>, greater<PIII> > queue;
-    if (src_cells) {
-        LUX_ASSERT(!src);
-        LUX_ASSERT(!src_cells->empty());
-        for (Cell *scell : *src_cells) {
-            cost_pair = make_pair(cost, cost);
-            if (a_star) cost_pair.first += move_cost * scell->man_dist(dest_cell);
-            scell->path_info = {
-                .cost = cost,
-                .dist = 0,
-                .prev_cell = NULL,
-                .call_id = this->_pathfind_call_id};
-            queue.push(make_pair(cost_pair, scell->id));  // cost, id
-        }
-    } else if (!unit && src->factory_center) {
-        // If src is a factory_center, start from outer factory cells
-        for (Cell *fcell : src->factory->cells) {
-            cost_pair = make_pair(cost, cost);
-            if (a_star) cost_pair.first += move_cost * fcell->man_dist(dest_cell);
-            fcell->path_info = {
-                .cost = cost,
-                .dist = 0,
-                .prev_cell = NULL,
-                .call_id = this->_pathfind_call_id};
-            queue.push(make_pair(cost_pair, fcell->id));  // cost, id
-        }
-    } else {
-        if (a_star) cost_pair.first += move_cost * src->man_dist(dest_cell);
-        src->path_info = {
-            .cost = cost,
-            .dist = 0,
-            .prev_cell = NULL,
-            .call_id = this->_pathfind_call_id};
-        queue.push(make_pair(cost_pair, src->id));  // cost, id
-    }
-
-    while (!queue.empty()) {
-	auto top = queue.top();
-	queue.pop();
-	Cell *cell = this->cell(top.second);
-	if (top.first.second > cell->path_info.cost) continue;  // outdated duplicate
-
-	// Check for terminal condition
-	if (cell == dest_cell
-            || (dest_cond && dest_cond(cell))
-            || (!dest_cond  // Implied-factory destination
-                && dest_cell->factory_center
-                && cell->factory == dest_cell->factory
-                && ((unit && unit->player == board.opp)
-                    || !cell->assigned_unit
-                    || cell->assigned_unit == unit))) {
-	    cost = cell->path_info.cost;
-	    if (route) {
-		route->clear();
-		while (cell) {
-		    route->push_back(cell);
-		    cell = cell->path_info.prev_cell;
-		}
-		reverse(route->begin(), route->end());
-	    }
-	    return cost;
-	}
-
-        // Check for distance limit
-        if (cell->path_info.dist >= max_dist) continue;
-
-        // Check if cell cannot be passed through
-        //  - src can always be passed through
-        //  - Always avoid opp factory cells
-        if (cell->path_info.cost
-            && ((avoid_cond && avoid_cond(cell))
-                || (unit && cell->opp_factory(unit->player)))) continue;
-
-        // Don't wander through factory when implied-factory destination
-        if (cell->path_info.cost && !avoid_cond
-            && dest_cell->factory_center && cell->factory == dest_cell->factory) continue;
-
-	// Update neighbors
-	for (Cell *new_cell : cell->neighbors) {
-	    // Init new_cell if first time this invocation
-	    if (new_cell->path_info.call_id != this->_pathfind_call_id) {
-		new_cell->path_info = {
-		    .cost = INT_MAX,
-                    .dist = INT_MAX,
-                    .prev_cell = NULL,
-                    .call_id = this->_pathfind_call_id};
-	    }
-
-            if (custom_cost) cost = cell->path_info.cost + custom_cost(new_cell, unit);
-            else cost = (cell->path_info.cost
-                         + move_cost
-                         + static_cast<int>(rubble_movement_cost * new_cell->rubble));
-            int seed = board.sim_step + cell->id + new_cell->id + (unit ? unit->id : 0);
-            if (cost < new_cell->path_info.cost) {
-                new_cell->path_info.cost = cost;
-                new_cell->path_info.dist = cell->path_info.dist + 1;
-                new_cell->path_info.prev_cell = cell;
-                cost_pair = make_pair(cost, cost);
-                if (a_star) cost_pair.first += move_cost * new_cell->man_dist(dest_cell);
-                queue.push(make_pair(cost_pair, new_cell->id));
-	    } else if (cost == new_cell->path_info.cost
-                       && (!unit || !RoleBlockade::cast(unit->role))
-                       && prandom(seed, 0.5)) {
-                new_cell->path_info.dist = cell->path_info.dist + 1;
-                new_cell->path_info.prev_cell = cell;
-            }
-	}
-    }
-
-    return INT_MAX;
+    return this->pathfind_t(unit, src, dest_cell, dest_cond, avoid_cond, custom_cost, route, max_dist, src_cells);
 }
 
 int Board::pathfind(Cell *src, Cell *dest_cell,
@@ -1037,3 +977,26 @@ int Board::pathfind(Cell *src, Cell *dest_cell,
                     int max_dist) {
     return this->pathfind(NULL, src, dest_cell, dest_cond, avoid_cond, custom_cost, route, max_dist);
 }
+
+CostField *Board::cost_field(Factory *factory, CostFieldKind kind) {
+    size_t index = factory->id * CostField_COUNT + kind;
+    if (this->_cost_fields.size() <= index) this->_cost_fields.resize(index + 1);
+    unique_ptr<CostField> &field = this->_cost_fields[index];
+    if (!field) {
+        field.reset(new CostField());
+        field->epoch = -1;
+    }
+    if (field->epoch != this->terrain_epoch) field->fill(factory, kind);
+    return field.get();
+}
+
+void Board::invalidate_cost_fields() {
+    for (unique_ptr<CostField> &field : this->_cost_fields) {
+        if (field) field->epoch = -1;
+    }
+}
+
+// Equal-cost predecessors are picked pseudo-randomly, except for blockade routes which must be stable
+bool Board::_pathfind_random_ties(Unit *unit) {
+    return (!unit || !RoleBlockade::cast(unit->role));
+}
@@ -1,27 +1,56 @@
 #pragma once
 
+#include "lux/bitboard.hpp"
 #include "lux/cell.hpp"
+#include "lux/cost_field.hpp"
 #include "lux/defs.hpp"
 #include "lux/factory.hpp"
 #include "lux/json.hpp"
+#include "lux/observation.hpp"
+#include "lux/search_workspace.hpp"
 #include "lux/team.hpp"
+#include "lux/undo_log.hpp"
 #include "lux/unit.hpp"
 
 #include <climits>
 #include <functional>  // function
+#include <memory>  // unique_ptr
 #include <string>
 #include <vector>
 
 
 struct Player;
 
+// Boolean layers of the board as of the last init/end_step_simulation/load, see Board::bits()
+typedef struct BoardBits {
+    BitBoard ice;
+    BitBoard ore;
+    BitBoard factory;
+    BitBoard flat;  // no rubble
+    BitBoard lowland;  // as labeled by the last update_lowlands
+} BoardBits;
+
+// Placeholder for an unused pathfind_t condition/cost, the checks for it compile away
+typedef struct PathNone {} PathNone;
+
+// Open-list implementation for pathfind_t. All pop in the same (f, g, cell id) order, so routes do not depend on it.
+typedef enum PathQueue : int8_t {
+    PathQueue_HEAP = 0,  // binary heap
+    PathQueue_BUCKET,    // Dial bucket queue over integer f, no heap churn outside the current bucket (default)
+    PathQueue_BFS,       // layer ring, only for unit-cost searches (custom_cost always 1)
+} PathQueue;
+
 typedef struct Board {
     int step;
     int sim_step;
     int real_env_step;
+    int changed_cell_count;  // cells with rubble/lichen diffs applied this step (all cells on full init)
     Team home;
     Team away;
     Cell cells[SIZE2];
+    CellPlanes planes;
+    BoardBits _bits;
+    bool _bits_dirty;
     std::vector<Factory> factories;
     std::vector<Unit> units;
     struct Player *player;
@@ -45,29 +74,71 @@ typedef struct Board {
 
     std::map<struct Unit*, std::vector<struct Cell*>*> opp_chains;
 
+    int terrain_epoch;  // bumped by init when rubble or factories change, see CostField
+    std::vector<std::unique_ptr<CostField> > _cost_fields;  // factory id * CostField_COUNT + kind
+
+    int booking_version;  // bumped each sim step and on load, see Unit::_ff_safe
+
     int _factories_per_team;
     int _ice_vuln_count;
-    int _flood_fill_call_id;
-    int _pathfind_call_id;
     int _save_units_len;
+    UndoLog _assign_undo;  // open from save_end until load: cell/unit assigned_factory
+    std::vector<int16_t> _unit_cells;  // cells set in the unit/unit_next planes since the last load_cells
+    std::vector<int16_t> _changed_cells;  // cells with diffs applied by init since the last save_begin
+    bool _save_all;  // full init since the last save_begin
+    // Byte planes are restored whole: cheaper than logging, as the sim rewrites lichen every step
+    int8_t _save_rubble[SIZE2];  // also the observed rubble for CostField
+    int8_t _save_lichen[SIZE2];
+    int8_t _save_lichen_strain[SIZE2];
 
     // ~~~ Methods:
 
-    void init(json &obs, int agent_step, bool is_player0);
+    void init(Observation &obs, int agent_step, bool is_player0);
     std::string summary();
     void save_begin();
     void save_end();
     void load();
+    void load_cells();
+
+    // Writers of state restored by load without a full copy go through these
+    inline void set_assigned_factory(Cell *cell, Factory *factory) {
+        this->_assign_undo.record(&cell->assigned_factory);
+        cell->assigned_factory = factory;
+    }
+    inline void set_assigned_factory(Unit *unit, Factory *factory) {
+        this->_assign_undo.record(&unit->assigned_factory);
+        unit->assigned_factory = factory;
+    }
+    inline void set_unit(Cell *cell, Unit *unit) {
+        cell->unit() = unit;
+        this->_unit_cells.push_back(cell->id);
+    }
+    inline void set_unit_next(Cell *cell, Unit *unit) {
+        cell->unit_next() = unit;
+        this->_unit_cells.push_back(cell->id);
+    }
+
+    Unit *history_unit(int past_step, int cell_id);  // unit on cell_id at past_step, see CellPlanes::unit_history
+    bool history_any_unit(Cell *cell, int max_radius, int past_steps, Player *unit_player,
+                          bool heavies, bool lights);  // over the last past_steps steps up to step
 
     inline bool sim0() { return this->step == this->sim_step; }  // is it currently sim step index 0?
     inline bool final_night() { return this->sim_step >= FINAL_NIGHT_PHASE; }
 
+    void reset_ff_safe(Cell *cell, int radius);  // drop memoized friendly fire checks of own units nearby
+
+    BoardBits &bits();  // rebuilt from the planes on first use after a change
+    void _update_bits();
+
     Cell *cell(int x, int y);
     Cell *cell(int cell_id);
     Player *get_player(int player_id);
 
     void begin_step_simulation();
     void end_step_simulation();
+    void abandon_step_simulation();  // instead of end_step_simulation when a step is cut short, before load
+    void begin_step_cells();  // full-board sweeps of the above
+    void end_step_cells();
     void update_roles_and_goals();
 
     void update_flatlands();
@@ -96,6 +167,10 @@ typedef struct Board {
 
     void flood_fill(Cell *src, std::function<bool(Cell*)> const& cell_cond);
 
+    // Whole-board costs from factory, filled on first use after terrain_epoch changes
+    CostField *cost_field(Factory *factory, CostFieldKind kind);
+    void invalidate_cost_fields();  // refill all on next use without a terrain change, for benchmarks
+
     int naive_cost(Unit *unit, Cell *src, Cell *dest_cell);
     int pathfind(Unit *unit, Cell *src, Cell *dest_cell,
                  std::function<bool(Cell*)> const& dest_cond = NULL,
@@ -110,6 +185,20 @@ typedef struct Board {
                  std::function<int(Cell*,Unit*)> const& custom_cost = NULL,
                  std::vector<Cell*> *route = NULL,
                  int max_dist = INT_MAX);
+
+    // Same search with the conditions/cost passed as any callable (or PathNone), specialized per call site.
+    // Defined in lux/pathfind.hpp; pathfind above is a wrapper instantiated with std::function.
+    template <PathQueue Queue = PathQueue_BUCKET,
+              typename DestCond = PathNone, typename AvoidCond = PathNone, typename CustomCost = PathNone>
+    int pathfind_t(Unit *unit, Cell *src, Cell *dest_cell,
+                   DestCond const& dest_cond = DestCond(),
+                   AvoidCond const& avoid_cond = AvoidCond(),
+                   CustomCost const& custom_cost = CustomCost(),
+                   std::vector<Cell*> *route = NULL,
+                   int max_dist = INT_MAX,
+                   std::vector<Cell*> *src_cells = NULL,
+                   SearchWorkspace *workspace = NULL);  // to read per-cell results afterwards, else a scratch one
+    bool _pathfind_random_ties(Unit *unit);
 } Board;
-extern Board board;
-extern bool g_prod;
+extern thread_local Board *g_board;  // owned by the current MatchContext
+inline Board &board() { return *g_board; }  // the calling thread's match, see MatchContext::bind
@@ -7,28 +7,30 @@
 #include "lux/defs.hpp"
 #include "lux/exception.hpp"
 #include "lux/log.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/player.hpp"
 #include "lux/team.hpp"
 using namespace std;
 
 
-void Cell::init(int16_t cell_id, int16_t _x, int16_t _y, bool _ice, bool _ore, int8_t _rubble) {
+void Cell::init(int16_t cell_id, int16_t _x, int16_t _y, bool _ice, bool _ore, int8_t _rubble,
+                CellPlanes *_planes) {
     this->id = cell_id;
     this->x = _x;
     this->y = _y;
     this->ice = _ice;
     this->ore = _ore;
-    this->rubble = _rubble;
-    this->lichen = 0;
-    this->lichen_strain = -1;
+    this->planes = _planes;
+    this->rubble() = _rubble;
+    this->lichen() = 0;
+    this->lichen_strain() = -1;
     this->valid_spawn = false;
     this->ice1_spawn = false;
     this->factory_center = false;
-    this->factory = NULL;
-    this->flood_fill_call_id = 0;
-    this->path_info = {};
-    this->unit = NULL;
-    this->unit_next = NULL;
+    this->factory() = NULL;
+    this->unit() = NULL;
+    this->unit_next() = NULL;
+    for (int i = 0; i < UNIT_HISTORY_STEPS; i++) this->planes->unit_history[i][cell_id] = -1;
     this->assigned_unit = NULL;
     this->assigned_factory = NULL;
     this->flatland_id = -1;
@@ -40,13 +42,13 @@ void Cell::init(int16_t cell_id, int16_t _x, int16_t _y, bool _ice, bool _ore, i
     this->step0_score = INT_MIN;
     this->_ice_vulnerable_cells_ready = false;
     this->_is_contested_step = -1;
-    this->future_heavy_dig_step = INT_MAX;
-    this->future_light_dig_step = INT_MAX;
+    this->future_heavy_dig_step() = INT_MAX;
+    this->future_light_dig_step() = INT_MAX;
     this->lichen_connected_step = -1;
     this->lichen_opp_boundary_step = -1;
     this->lichen_frontier_step = -1;
     this->lichen_bottleneck_step = -1;
-    this->lichen_dist = INT_MAX;
+    this->lichen_dist() = INT_MAX;
 }
 
 void Cell::init_neighbors() {
@@ -69,68 +71,44 @@ void Cell::init_neighbors() {
 }
 
 void Cell::reinit_rubble(int8_t _rubble) {
-    this->rubble = _rubble;
+    this->rubble() = _rubble;
 }
 
 void Cell::reinit_lichen(int8_t _lichen) {
-    this->lichen = _lichen;
+    this->lichen() = _lichen;
 }
 
 void Cell::reinit_lichen_strain(int8_t _lichen_strain) {
-    this->lichen_strain = _lichen_strain;
-}
-
-void Cell::save_begin() {
-    // Save these values at beginning of step 0 simulation because they will be updated via diff.
-    this->_save_rubble = this->rubble;
-    this->_save_lichen = this->lichen;
-    this->_save_lichen_strain = this->lichen_strain;
-}
-
-void Cell::save_end() {
-    this->_save_assigned_factory = this->assigned_factory;
-}
-
-void Cell::load() {
-    this->unit = NULL;
-    this->unit_next = NULL;
-    this->rubble = this->_save_rubble;
-    this->lichen = this->_save_lichen;
-    this->lichen_strain = this->_save_lichen_strain;
-    this->assigned_factory = this->_save_assigned_factory;
+    this->lichen_strain() = _lichen_strain;
 }
 
 Factory *Cell::own_factory(Player *player) {
-    player = player ? player : board.player;
-    return (this->factory && this->factory->player == player) ? this->factory : NULL;
+    player = player ? player : board().player;
+    return (this->factory() && this->factory()->player == player) ? this->factory() : NULL;
 }
 
 Factory *Cell::opp_factory(Player *player) {
-    player = player ? player : board.player;
-    return (this->factory && this->factory->player->team != player->team) ? this->factory : NULL;
-}
-
-void Cell::update_unit_history(struct Unit *_unit) {
-    this->_unit_history[board.step % 100] = _unit;
+    player = player ? player : board().player;
+    return (this->factory() && this->factory()->player->team != player->team) ? this->factory() : NULL;
 }
 
 Unit *Cell::get_unit_history(int step, Player *player) {
-    LUX_ASSERT(0 <= step && board.step - 100 < step && step <= board.step);
-    Unit *_unit = this->_unit_history[step % 100];
+    LUX_ASSERT(0 <= step && board().step - UNIT_HISTORY_STEPS < step && step <= board().step);
+    Unit *_unit = board().history_unit(step, this->id);
     return (_unit && (player == NULL || _unit->player == player)) ? _unit : NULL;
 }
 
 // Returns current unit for player, otherwise i=0 unit
 Unit *Cell::own_unit(Player *player) {
-    player = player ? player : board.player;
-    Unit *_unit = (player == board.player) ? this->unit : this->get_unit_history(board.step);
+    player = player ? player : board().player;
+    Unit *_unit = (player == board().player) ? this->unit() : this->get_unit_history(board().step);
     return (_unit && _unit->player == player) ? _unit : NULL;
 }
 
 // Always returns i=0 unit
 Unit *Cell::opp_unit(Player *player) {
-    player = player ? player : board.player;
-    return this->get_unit_history(board.step, (player == board.player ? board.opp : board.player));
+    player = player ? player : board().player;
+    return this->get_unit_history(board().step, (player == board().player ? board().opp : board().player));
 }
 
 bool Cell::is_surrounded() {
@@ -142,13 +120,13 @@ bool Cell::is_surrounded() {
 
 bool Cell::is_contested() {
     // Check for cached value
-    if (board.step / 100 == this->_is_contested_step / 100) return this->_is_contested;
+    if (board().step / 100 == this->_is_contested_step / 100) return this->_is_contested;
 
     this->_is_contested = false;
-    this->_is_contested_step = board.step;
+    this->_is_contested_step = board().step;
 
-    Factory *f0 = this->nearest_factory(board.player);
-    Factory *f1 = this->nearest_factory(board.opp);
+    Factory *f0 = this->nearest_factory(board().player);
+    Factory *f1 = this->nearest_factory(board().opp);
     LUX_ASSERT(f0);
     LUX_ASSERT(f1);
 
@@ -156,8 +134,8 @@ bool Cell::is_contested() {
     int f1_dist = this->man_dist_factory(f1);
 
     if (MIN(f0_dist, f1_dist) <= 8 && abs(f0_dist - f1_dist) <= 4) {
-        int f0_cost = board.pathfind(this, f0->cell, [&](Cell *c) { return c->factory == f0; });
-        int f1_cost = board.pathfind(this, f1->cell, [&](Cell *c) { return c->factory == f1; });
+        int f0_cost = board().cost_field(f0, CostField_NEUTRAL)->cost_from(this);
+        int f1_cost = board().cost_field(f1, CostField_NEUTRAL)->cost_from(this);
         if (abs(f0_cost - f1_cost) <= 180) this->_is_contested = true;
     }
 
@@ -165,7 +143,7 @@ bool Cell::is_contested() {
 }
 
 Cell *Cell::neighbor(int dx, int dy) {
-    return board.cell(this->x + dx, this->y + dy);
+    return board().cell(this->x + dx, this->y + dy);
 }
 
 Cell *Cell::neighbor(Direction direction) {
@@ -304,7 +282,7 @@ int Cell::man_dist_factory(Cell *other) const {
 Factory *Cell::_nearest_factory(Player *player, Factory *ignore_factory) {  // default: any factory
     int nearest_dist = INT_MAX;
     Factory *nearest_factory = NULL;
-    for (Factory &_factory : board.factories) {
+    for (Factory &_factory : board().factories) {
         if (_factory.alive()
             && (player == NULL || _factory.player == player)) {
             if (ignore_factory == &_factory) continue;
@@ -320,8 +298,8 @@ Factory *Cell::_nearest_factory(Player *player, Factory *ignore_factory) {  // d
 
 Factory *Cell::nearest_factory(Player *player) {  // default: any factory
     // NOTE: Would need to change for multi-player teams
-    if (player->team == &board.home) return this->nearest_home_factory;
-    if (player->team == &board.away) return this->nearest_away_factory;
+    if (player->team == &board().home) return this->nearest_home_factory;
+    if (player->team == &board().away) return this->nearest_away_factory;
     return ((this->home_dist < this->away_dist)
             ? this->nearest_home_factory
             : this->nearest_away_factory);
@@ -333,8 +311,8 @@ int Cell::nearest_factory_dist(Player *player) {
 
 void Cell::update_factory_dists() {
     // TODO: only recalculate if prev factory is destroyed?
-    this->nearest_home_factory = this->_nearest_factory(board.player);
-    this->nearest_away_factory = this->_nearest_factory(board.opp);
+    this->nearest_home_factory = this->_nearest_factory(board().player);
+    this->nearest_away_factory = this->_nearest_factory(board().opp);
     // Note: nearest factory may not exist during bidding/placement
     this->home_dist = (this->nearest_home_factory
                        ? this->man_dist_factory(this->nearest_home_factory)
@@ -380,7 +358,7 @@ double Cell::get_antagonize_score(bool heavy) {
 
 // Returns heavy/light pair: 1.0 for constant presence, 0.0 for none, etc
 PDD Cell::get_traffic_score(Player *player, bool include_neighbors) {
-    player = player ? player : board.opp;
+    player = player ? player : board().opp;
 
     double heavy_score = 0;
     double light_score = 0;
@@ -395,7 +373,7 @@ PDD Cell::get_traffic_score(Player *player, bool include_neighbors) {
     }
 
     int history_len = 50;
-    for (int step = board.step; step >= MAX(0, board.step - history_len); step--) {
+    for (int step = board().step; step >= MAX(0, board().step - history_len); step--) {
         Unit *u = this->get_unit_history(step, player);
         if (u && u->heavy) heavy_score += 1;
         else if (u) light_score += 1;
@@ -474,8 +452,8 @@ double Cell::get_spawn_score(double ore_mult, bool verbose) {
             if (dist <= 5) ice5_count = MIN(1, ice5_count + 1);
         }
 
-        if (cell->rubble == 0 && !cell->ice && !cell->ore) dflat[dist] += 1;
-        if (cell->rubble < 20 && !cell->ice && !cell->ore) dlow[dist] += 1;
+        if (cell->rubble() == 0 && !cell->ice && !cell->ore) dflat[dist] += 1;
+        if (cell->rubble() < 20 && !cell->ice && !cell->ore) dlow[dist] += 1;
 
         cell = this->radius_cell_factory(MAX_RADIUS, cell);
     }
@@ -498,8 +476,8 @@ double Cell::get_spawn_score(double ore_mult, bool verbose) {
     // ~ secure_other_factory_bonus ~
     // Small bonus for placing in such a way as to prevent an IC attack on a friendly factory
     int secure_other_factory_bonus = 0;
-    if (board.step > 0) {
-        for (Factory *factory : board.player->factories()) {
+    if (board().step > 0) {
+        for (Factory *factory : board().player->factories()) {
             vector<Cell*> &ice_vuln_cells = factory->cell->ice_vulnerable_cells();
             if (!ice_vuln_cells.empty()) {
                 bool all_close = true;
@@ -521,20 +499,20 @@ double Cell::get_spawn_score(double ore_mult, bool verbose) {
     // Large bonus for late factories if they can pressure an opp factory's ice
     double ice_conflict_bonus = 0;
     double desperate_ice_conflict_bonus = 0;
-    int remaining_factories = agent.factories_per_team - ((board.step - 1) / 2);
-    int max_ice_vuln_count = agent.factories_per_team / 2;
+    int remaining_factories = agent().factories_per_team - ((board().step - 1) / 2);
+    int max_ice_vuln_count = agent().factories_per_team / 2;
     if (this->away_dist <= 10
         && !this->nearest_away_factory->_ice_vuln_covered
-        && ((board._ice_vuln_count + remaining_factories <= max_ice_vuln_count)
-            || (board.step >= 2 * agent.factories_per_team - 1))) {
+        && ((board()._ice_vuln_count + remaining_factories <= max_ice_vuln_count)
+            || (board().step >= 2 * agent().factories_per_team - 1))) {
         vector<Cell*> &ice_vuln_cells = this->nearest_away_factory->cell->ice_vulnerable_cells();
         if (count(ice_vuln_cells.begin(), ice_vuln_cells.end(), this)) {
 
             // Check dists to existing opp/own factories from the target factory
             Factory *nearest_opp_factory = this->nearest_away_factory->cell->_nearest_factory(
-                board.opp, this->nearest_away_factory);
+                board().opp, this->nearest_away_factory);
             Factory *nearest_own_factory = this->nearest_away_factory->cell->_nearest_factory(
-                board.player);
+                board().player);
             int opp_factory_dist = (
                 nearest_opp_factory
                 ? this->nearest_away_factory->cell->man_dist_factory(nearest_opp_factory)
@@ -572,7 +550,7 @@ double Cell::get_spawn_score(double ore_mult, bool verbose) {
             }
 
             // Allow over-limit ice conflicts for last placement, but reduce bonus
-            if (board._ice_vuln_count + remaining_factories > max_ice_vuln_count) {
+            if (board()._ice_vuln_count + remaining_factories > max_ice_vuln_count) {
                 ice_conflict_bonus /= 2.0;
                 desperate_ice_conflict_bonus /= 2.0;
             } else if (opp_factory_dist < 10) {
@@ -649,7 +627,7 @@ double Cell::get_spawn_score(double ore_mult, bool verbose) {
         ore_mult = 0.5;
     }
 
-    if (board.low_iceland()) {
+    if (board().low_iceland()) {
         ice2_mult = 3;
         ore_mult = 0.25;
     }
@@ -699,7 +677,7 @@ double Cell::get_spawn_score(double ore_mult, bool verbose) {
 
 double Cell::get_spawn_security_score() {
     int ice_security_bonus = this->ice_vulnerable() ? 0 : 1;
-    //if (board.step == 0 && this->ice_vulnerable()) LUX_LOG("Vuln: " << *this);
+    //if (board().step == 0 && this->ice_vulnerable()) LUX_LOG("Vuln: " << *this);
     return ice_security_bonus * 4;
 }
 
@@ -733,15 +711,15 @@ bool Cell::ice_vulnerable(Cell *other_factory_cell) {
 
     // Check move cost of ice cells to both factory locations
     for (Cell *ice_cell : ice_cells) {
-        int this_cost = board.pathfind(
-            ice_cell, this,
+        int this_cost = board().pathfind_t(
+            NULL, ice_cell, this,
             [&](Cell *c) { return c->man_dist_factory(this) == 0; },
-            [&](Cell *c) { return c->factory; });
+            [&](Cell *c) { return c->factory(); });
         //LUX_ASSERT(this_cost != INT_MAX);
-        int other_cost = board.pathfind(
-            ice_cell, other_factory_cell,
+        int other_cost = board().pathfind_t(
+            NULL, ice_cell, other_factory_cell,
             [&](Cell *c) { return c->man_dist_factory(other_factory_cell) == 0; },
-            [&](Cell *c) { return c->factory; });
+            [&](Cell *c) { return c->factory(); });
         //LUX_ASSERT(other_cost != INT_MAX);
 
         // Shouldn't happen and yet..
@@ -765,7 +743,7 @@ bool Cell::ice_vulnerable(Cell *other_factory_cell) {
 
 vector<Cell*> &Cell::ice_vulnerable_cells() {
     if (!this->_ice_vulnerable_cells_ready) {
-        board.flood_fill(
+        board().flood_fill(
             this,
             [&](Cell *c) {
                 int dist = this->man_dist(c);
@@ -14,12 +14,22 @@ struct Factory;
 struct Player;
 struct Unit;
 
-typedef struct CellPathInfo {
-    int cost;  // stores best cost per cell during each pathfind call
-    int dist;  // stores dist associated with best cost route
-    struct Cell *prev_cell;  // so we can unwind routes
-    int call_id;  // so we can skip per-call all-cell initialization
-} CellPathInfo;
+#define UNIT_HISTORY_STEPS 100
+
+// Per-step cell state, kept in one contiguous plane per field (indexed by cell id) so that the
+// full-board sweeps each step are a few sequential passes instead of a walk over every Cell.
+typedef struct CellPlanes {
+    int8_t rubble[SIZE2];
+    int8_t lichen[SIZE2];
+    int8_t lichen_strain[SIZE2];
+    struct Factory *factory[SIZE2];
+    struct Unit *unit[SIZE2];  // unit located here now
+    struct Unit *unit_next[SIZE2];  // unit located here next simulated step
+    int future_heavy_dig_step[SIZE2];  // Next time opp plans to dig here with heavy
+    int future_light_dig_step[SIZE2];  // Next time opp plans to dig here with light
+    int lichen_dist[SIZE2];  // Dist of cell from factory via lichen
+    int16_t unit_history[UNIT_HISTORY_STEPS][SIZE2];  // ring of per-step Board::units indices, -1 if empty
+} CellPlanes;
 
 typedef struct Cell {
     int16_t id;
@@ -27,24 +37,17 @@ typedef struct Cell {
     int16_t y;
     bool ice;
     bool ore;
-
-    int8_t rubble;
-    int8_t lichen;
-    int8_t lichen_strain;
+    CellPlanes *planes;  // hot per-step fields, see accessors below
 
     bool valid_spawn;
     bool ice1_spawn;  // If a factory was placed here, there would be a dist-1 ice
     bool factory_center;
-    struct Factory *factory;
 
     int16_t home_dist;  // man_dist to nearest "home team" factory
     int16_t away_dist;  // man_dist to nearest "away team" factory
     struct Factory *nearest_home_factory;
     struct Factory *nearest_away_factory;
 
-    int flood_fill_call_id;
-    CellPathInfo path_info;
-
     std::vector<Cell*> neighbors;
     std::vector<Cell*> neighbors_plus;  // includes self
     Cell *north;
@@ -52,10 +55,6 @@ typedef struct Cell {
     Cell *south;
     Cell *west;
 
-    struct Unit *unit;  // unit located here now
-    struct Unit *unit_next;  // unit located here next simulated step
-    struct Unit *_unit_history[100];  // recent history of units located here
-
     struct Unit *assigned_unit;  // unit assigned to this cell
     struct Factory *assigned_factory;  // factory assigned to this (resource) cell
 
@@ -74,36 +73,35 @@ typedef struct Cell {
     bool _is_contested;
     int _is_contested_step;
 
-    int future_heavy_dig_step;  // Next time opp plans to dig here with heavy
-    int future_light_dig_step;  // Next time opp plans to dig here with light
     int lichen_connected_step;
     int lichen_opp_boundary_step;  // Cell has opp lichen and blocks own lichen at this step
     int lichen_frontier_step;  // Cell has lichen and is adjacent to flatland
     int lichen_bottleneck_step;  // Can cut off outer cells at this step
     int lichen_bottleneck_cell_count;
     int lichen_bottleneck_lichen_count;
-    int lichen_dist;  // Dist of cell from factory via lichen
-
-    int8_t _save_rubble;
-    int8_t _save_lichen;
-    int8_t _save_lichen_strain;
-    struct Factory *_save_assigned_factory;
 
     // ~~~ Methods:
 
-    void init(int16_t cell_id, int16_t x, int16_t y, bool ice, bool ore, int8_t rubble);
+    inline int8_t &rubble() { return this->planes->rubble[this->id]; }
+    inline int8_t &lichen() { return this->planes->lichen[this->id]; }
+    inline int8_t &lichen_strain() { return this->planes->lichen_strain[this->id]; }
+    inline struct Factory *&factory() { return this->planes->factory[this->id]; }
+    inline struct Unit *&unit() { return this->planes->unit[this->id]; }
+    inline struct Unit *&unit_next() { return this->planes->unit_next[this->id]; }
+    inline int &future_heavy_dig_step() { return this->planes->future_heavy_dig_step[this->id]; }
+    inline int &future_light_dig_step() { return this->planes->future_light_dig_step[this->id]; }
+    inline int &lichen_dist() { return this->planes->lichen_dist[this->id]; }
+
+    void init(int16_t cell_id, int16_t x, int16_t y, bool ice, bool ore, int8_t rubble,
+              CellPlanes *planes);
     void init_neighbors();
     void reinit_rubble(int8_t rubble);
     void reinit_lichen(int8_t lichen);
     void reinit_lichen_strain(int8_t lichen_strain);
-    void save_begin();
-    void save_end();
-    void load();
 
     struct Factory *own_factory(struct Player *player = NULL);
     struct Factory *opp_factory(struct Player *player = NULL);
 
-    void update_unit_history(struct Unit *unit);
     struct Unit *get_unit_history(int step, struct Player *player = NULL);
     struct Unit *own_unit(struct Player *player = NULL);
     struct Unit *opp_unit(struct Player *player = NULL);
@@ -0,0 +1,82 @@
+#include "lux/cost_field.hpp"
+
+#include <algorithm>  // reverse
+#include <climits>
+
+#include "lux/board.hpp"
+#include "lux/cell.hpp"
+#include "lux/exception.hpp"
+#include "lux/factory.hpp"
+#include "lux/pathfind.hpp"
+#include "lux/player.hpp"
+#include "lux/search_workspace.hpp"
+#include "lux/unit.hpp"
+using namespace std;
+
+
+// Same as pathfind with a NULL unit for NEUTRAL
+static int _move_cost(CostFieldKind kind) {
+    if (kind == CostField_LIGHT) return g_light_cfg.MOVE_COST;
+    if (kind == CostField_HEAVY) return g_heavy_cfg.MOVE_COST;
+    if (kind == CostField_ROUTE) return 100;  // see Factory::update_resource_routes
+    return 20;
+}
+
+static double _rubble_movement_cost(CostFieldKind kind) {
+    if (kind == CostField_LIGHT) return g_light_cfg.RUBBLE_MOVEMENT_COST;
+    if (kind == CostField_HEAVY) return g_heavy_cfg.RUBBLE_MOVEMENT_COST;
+    return 1;
+}
+
+void CostField::fill(Factory *_factory, CostFieldKind _kind) {
+    this->factory = _factory;
+    this->kind = _kind;
+    this->epoch = board().terrain_epoch;
+
+    // Costs use the observed rubble even if filled mid-simulation, so the field is good for the whole turn
+    int8_t const *rubble = (board().sim0() ? board().planes.rubble : board()._save_rubble);
+    Player *player = _factory->player;
+    auto no_dest_cond = [&](Cell *c) { (void)c; return false; };
+    int const move_cost = _move_cost(_kind);
+    double const rubble_movement_cost = _rubble_movement_cost(_kind);
+    SearchScope scope;
+    (void)board().pathfind_t(
+        NULL, _factory->cell, NULL, no_dest_cond,
+        [&](Cell *c) {
+            if (_kind == CostField_ROUTE) return (c->factory() || c->ore || c->ice || c->away_dist <= 1);
+            return _kind != CostField_NEUTRAL && c->opp_factory(player); },
+        [&](Cell *c, Unit *u) { (void)u;
+            return move_cost + static_cast<int>(rubble_movement_cost * rubble[c->id]); },
+        NULL, INT_MAX, NULL, scope.ws);
+
+    for (Cell &cell : board().cells) {
+        if (scope.ws->reached(cell.id)) {
+            CellPathInfo &info = scope.ws->path_info[cell.id];
+            this->cost[cell.id] = info.cost;
+            this->prev[cell.id] = info.prev_cell ? info.prev_cell->id : -1;
+        } else {
+            this->cost[cell.id] = INT_MAX;
+            this->prev[cell.id] = -1;
+        }
+    }
+}
+
+// Step costs only depend on the cell entered, so walking the same route backwards pays for the factory cell
+// (no rubble) instead of this cell.
+int CostField::cost_from(Cell *cell) const {
+    if (cell->factory() == this->factory) return 0;
+    int cost_to = this->cost[cell->id];
+    if (cost_to == INT_MAX) return INT_MAX;
+
+    int8_t const *rubble = (board().sim0() ? board().planes.rubble : board()._save_rubble);
+    return cost_to - static_cast<int>(_rubble_movement_cost(this->kind) * rubble[cell->id]);
+}
+
+void CostField::route_to(Cell *cell, vector<Cell*> *route) const {
+    route->clear();
+    if (this->cost[cell->id] == INT_MAX) return;
+    for (int cell_id = cell->id; cell_id != -1; cell_id = this->prev[cell_id]) {
+        route->push_back(board().cell(cell_id));
+    }
+    reverse(route->begin(), route->end());
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "lux/cell.hpp"
+#include "lux/defs.hpp"
+
+
+struct Factory;
+
+typedef enum CostFieldKind : int8_t {
+    CostField_NEUTRAL = 0,  // unit-less move costs (20 + rubble), nothing avoided
+    CostField_LIGHT,        // light move costs, avoiding the factory owner's opp factories
+    CostField_HEAVY,        // heavy move costs, avoiding the factory owner's opp factories
+    CostField_ROUTE,        // 100 + rubble, not through factories, resources or cells next to away factories
+    CostField_COUNT,
+} CostFieldKind;
+
+// Result of one multi-source search from a factory's outer cells over the whole board, see Board::cost_field.
+// Stays valid until Board::terrain_epoch changes, i.e. across sim steps and turns without rubble/factory changes.
+typedef struct CostField {
+    int cost[SIZE2];  // factory -> cell, INT_MAX if unreachable
+    int16_t prev[SIZE2];  // previous cell id on the route from the factory, -1 at the factory or unreachable
+    struct Factory *factory;
+    CostFieldKind kind;
+    int epoch;  // Board::terrain_epoch when filled, -1 if never
+
+    // ~~~ Methods:
+
+    // Reads the observed rubble: the live planes at sim step 0, Board::_save_rubble at later sim steps, never the
+    // simulated rubble
+    void fill(struct Factory *factory, CostFieldKind kind);
+
+    inline int cost_to(struct Cell *cell) const { return this->cost[cell->id]; }  // as pathfind from factory->cell
+    int cost_from(struct Cell *cell) const;  // cell -> factory
+    void route_to(struct Cell *cell, std::vector<struct Cell*> *route) const;  // factory -> cell, empty if unreachable
+} CostField;
@@ -59,6 +59,8 @@
 
 #define MIN_FACTORY_DIST 7
 
+#define MAX_ROLE_LOOPS 40  // rounds of role assignment per step before remaining units just recharge
+
 #define PROTECTOR_STRIKE_CHANCE 0.4
 
 #define FUTURE_SIM_DEV 5
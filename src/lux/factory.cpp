@@ -2,16 +2,20 @@
 
 #include <algorithm>  // stable_sort
 #include <set>
+#include <utility>  // pair
 
 #include "lux/action.hpp"
+#include "lux/bitboard.hpp"
 #include "lux/board.hpp"
 #include "lux/cell.hpp"
 #include "lux/defs.hpp"
 #include "lux/exception.hpp"
 #include "lux/log.hpp"
 #include "lux/mode.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/role.hpp"
 #include "lux/role_miner.hpp"
+#include "lux/search_workspace.hpp"
 #include "lux/unit.hpp"
 using namespace std;
 
@@ -19,7 +23,7 @@ using namespace std;
 // Can be called multiple times (placement steps and step 0)
 void Factory::init(int factory_id, int _player_id, int _x, int _y, int _water, int _metal) {
     this->id = factory_id;
-    this->player = board.get_player(_player_id);
+    this->player = board().get_player(_player_id);
     this->x = _x;
     this->y = _y;
     this->ice = 0;
@@ -30,8 +34,8 @@ void Factory::init(int factory_id, int _player_id, int _x, int _y, int _water, i
     this->mode = NULL;
     this->_save_mode = NULL;
 
-    this->cell = board.cell(_x, _y);
-    this->alive_step = board.step;
+    this->cell = board().cell(_x, _y);
+    this->alive_step = board().step;
     this->last_action_step = -1;
 
     // Only run once:
@@ -44,15 +48,15 @@ void Factory::init(int factory_id, int _player_id, int _x, int _y, int _water, i
 
         for (int dx = -1; dx <= 1; dx++) {
             for (int dy = -1; dy <= 1; dy++) {
-                Cell *_cell = board.cell(this->x + dx, this->y + dy);
-                _cell->rubble = 0;
-                _cell->factory = this;
+                Cell *_cell = board().cell(this->x + dx, this->y + dy);
+                _cell->rubble() = 0;
+                _cell->factory() = this;
                 this->cells_plus.push_back(_cell);  // includes center cell
                 if (dx || dy) this->cells.push_back(_cell);  // do not include center cell
             }
         }
-        this->ice_cells = board.ice_cells;
-        this->ore_cells = board.ore_cells;
+        this->ice_cells = board().ice_cells;
+        this->ore_cells = board().ore_cells;
         stable_sort(this->ice_cells.begin(), this->ice_cells.end(),
                     [&](const Cell *a, const Cell *b) {
                         return a->man_dist_factory(this) < b->man_dist_factory(this); });
@@ -68,7 +72,7 @@ void Factory::reinit(int _ice, int _ore, int _water, int _metal, int _power) {
     this->water = _water;
     this->metal = _metal;
     this->power = _power;
-    this->alive_step = board.step;
+    this->alive_step = board().step;
     this->last_action_step = -1;
 }
 
@@ -85,27 +89,27 @@ void Factory::handle_destruction() {
     if (this->mode) {
         LUX_LOG("died: " << *this << ' ' << *this->mode);
     } else {
-        LUX_ASSERT(this->player == board.opp);
+        LUX_ASSERT(this->player == board().opp);
         LUX_LOG("died: " << *this);
     }
 
     this->cell->factory_center = false;
     for (int dx = -1; dx <= 1; dx++) {
         for (int dy = -1; dy <= 1; dy++) {
-            board.cell(this->x + dx, this->y + dy)->factory = NULL;
-            board.cell(this->x + dx, this->y + dy)->factory_center = false;
+            board().cell(this->x + dx, this->y + dy)->factory() = NULL;
+            board().cell(this->x + dx, this->y + dy)->factory_center = false;
         }
     }
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->assigned_factory == this) unit->assigned_factory = NULL;
     }
-    for (Cell &_cell : board.cells) {
+    for (Cell &_cell : board().cells) {
         if (_cell.assigned_factory == this) _cell.assigned_factory = NULL;
     }
 }
 
 bool Factory::alive() {
-    return this->alive_step == board.step;
+    return this->alive_step == board().step;
 }
 
 string Factory::id_str() {
@@ -116,7 +120,7 @@ Cell *Factory::cell_toward(Cell *other_cell) {
     LUX_ASSERT(other_cell);
 
     // Inside factory
-    if (other_cell->factory == this) return other_cell;
+    if (other_cell->factory() == this) return other_cell;
 
     // Diagonal
     if (other_cell->y < this->y && other_cell->x < this->x) return this->cell->north->west;
@@ -139,7 +143,7 @@ Cell *Factory::cell_toward(Cell *other_cell) {
 }
 
 Cell *Factory::neighbor_toward(struct Cell *other_cell) {
-    LUX_ASSERT(other_cell->factory != this);
+    LUX_ASSERT(other_cell->factory() != this);
     return this->cell_toward(other_cell)->neighbor_toward(other_cell);
 }
 
@@ -153,16 +157,16 @@ Cell *Factory::radius_cell(int min_radius, int max_radius, Cell *prev_cell) {
 
 void Factory::new_mode(Mode *new_mode) {
     if (this->mode) {
-        if (board.sim0()) LUX_LOG("X! " << *this << ' ' << *this->mode);
+        if (board().sim0()) LUX_LOG("X! " << *this << ' ' << *this->mode);
         this->delete_mode();
     }
     this->mode = new_mode;
-    if (board.sim0()) LUX_LOG("   " << *this << ' ' << *this->mode);
+    if (board().sim0()) LUX_LOG("   " << *this << ' ' << *this->mode);
     this->mode->set();
 }
 
 void Factory::delete_mode() {
-    if (board.sim0()) LUX_LOG("X  " << *this << ' ' << *this->mode);
+    if (board().sim0()) LUX_LOG("X  " << *this << ' ' << *this->mode);
     this->mode->unset();
     delete this->mode;
     this->mode = NULL;
@@ -223,40 +227,40 @@ void Factory::update_lichen_info(bool is_begin_step) {
 
     auto cell_cond = [&](Cell *c) {
         // Within factory
-        if (c->factory == this) return true;
+        if (c->factory() == this) return true;
 
         // Connected lichen area
-        if (c->lichen_strain == this->id) {
-            if (board.sim0()) c->lichen_connected_step = board.step;
+        if (c->lichen_strain() == this->id) {
+            if (board().sim0()) c->lichen_connected_step = board().step;
             this->lichen_connected_cells.push_back(c);
             this->lichen_growth_cells.push_back(c);
             return true;
         }
 
         // Beyond
-        if (this->player == board.player
-            && board.opp->is_strain(c->lichen_strain)) {
-            c->lichen_opp_boundary_step = board.step;
+        if (this->player == board().player
+            && board().opp->is_strain(c->lichen_strain())) {
+            c->lichen_opp_boundary_step = board().step;
         }
-        else if (c->lichen == 0 && !c->ice && !c->ore && !c->factory) {
+        else if (c->lichen() == 0 && !c->ice && !c->ore && !c->factory()) {
             // Check for growth constraints i.e. pushing up against lichen/factories
             int max_adj_lichen = 0;
             for (Cell *neighbor : c->neighbors) {
-                if (neighbor->lichen_strain != -1 && neighbor->lichen_strain != this->id) {
-                    if (this->player == board.player
-                        && board.opp->is_strain(neighbor->lichen_strain)) {
-                        neighbor->lichen_opp_boundary_step = board.step;
+                if (neighbor->lichen_strain() != -1 && neighbor->lichen_strain() != this->id) {
+                    if (this->player == board().player
+                        && board().opp->is_strain(neighbor->lichen_strain())) {
+                        neighbor->lichen_opp_boundary_step = board().step;
                     }
                     return false;
                 }
-                if (neighbor->factory && neighbor->factory->id != this->id) return false;
-                if (neighbor->lichen_strain == this->id && neighbor->lichen > max_adj_lichen) {
-                    max_adj_lichen = neighbor->lichen;
+                if (neighbor->factory() && neighbor->factory()->id != this->id) return false;
+                if (neighbor->lichen_strain() == this->id && neighbor->lichen() > max_adj_lichen) {
+                    max_adj_lichen = neighbor->lichen();
                 }
             }
 
             int factory_dist = c->man_dist_factory(this);
-            if (c->rubble) {
+            if (c->rubble()) {
                 if (factory_dist == 1 || max_adj_lichen > 0) {
                     this->lichen_rubble_boundary_cells.push_back(c);
                 }
@@ -270,9 +274,9 @@ void Factory::update_lichen_info(bool is_begin_step) {
                 if (max_adj_lichen > 0) {
                     // Neighbor(s) may be frontier
                     for (Cell *neighbor : c->neighbors) {
-                        if (neighbor->lichen_strain == this->id) {
+                        if (neighbor->lichen_strain() == this->id) {
                             this->lichen_frontier_cells.push_back(c);  // NOTE: can double-count
-                            c->lichen_frontier_step = board.step;
+                            c->lichen_frontier_step = board().step;
                         }
                     }
                 }
@@ -282,64 +286,105 @@ void Factory::update_lichen_info(bool is_begin_step) {
         return false;
     };
 
-    board.flood_fill(this->cell, cell_cond);
+    board().flood_fill(this->cell, cell_cond);
     if (is_begin_step) {
         this->lichen_connected_count = (int)this->lichen_connected_cells.size();
     }
 }
 
+// Per-cell state of the articulation point DFS in update_lichen_bottleneck_info
+typedef struct LichenDfsNode {
+    int stamp;  // DFS this entry belongs to
+    int order;  // preorder index, the factory is 0
+    int low;  // lowest order reachable from the subtree via one non-tree edge
+    int cells;  // subtree cell count
+    int lichen;  // subtree lichen sum
+    int cut_cells;  // cells cut off from the factory without this cell
+    int cut_lichen;
+} LichenDfsNode;
+
 void Factory::update_lichen_bottleneck_info() {
     this->lichen_bottleneck_cells.clear();
 
     // No lichen, nothing to do
     if (this->lichen_connected_count == 0) return;
 
-    (void)board.pathfind(NULL, NULL, NULL,
-                         [&](Cell *c) { (void)c; return false; },
-                         [&](Cell *c) { return c->lichen_strain != this->id; },
-                         [&](Cell *c, Unit *u) { (void)c; (void)u; return 1; },
-                         NULL, INT_MAX,
-                         &this->cells);
+    SearchScope scope;
+    (void)board().pathfind_t<PathQueue_BFS>(NULL, NULL, NULL,
+                                          [&](Cell *c) { (void)c; return false; },
+                                          [&](Cell *c) { return c->lichen_strain() != this->id; },
+                                          [&](Cell *c, Unit *u) { (void)c; (void)u; return 1; },
+                                          NULL, INT_MAX,
+                                          &this->cells,
+                                          scope.ws);
+
+    for (Cell *cell : this->cells) cell->lichen_dist() = 0;
+    for (Cell *cell : this->lichen_connected_cells) cell->lichen_dist() = scope.ws->path_info[cell->id].dist;
+
+    // Articulation points of the lichen graph, with all factory cells as the root (Hopcroft-Tarjan). A cell cuts
+    // off each DFS child subtree that has no edge to above the cell, so one pass yields every cut-off count.
+    static thread_local vector<LichenDfsNode> nodes(SIZE2);
+    static thread_local vector<pair<Cell*, int> > stack;  // cell, next neighbor index
+    static thread_local int stamp = 0;
+    stamp += 1;
+    int order = 1;
+
+    auto visit = [&](Cell *c) {
+        nodes[c->id] = {
+            .stamp = stamp,
+            .order = order,
+            .low = order,
+            .cells = 1,
+            .lichen = c->lichen(),
+            .cut_cells = 0,
+            .cut_lichen = 0};
+        order += 1;
+        stack.push_back({c, 0});
+    };
 
-    for (Cell *cell : this->cells) cell->lichen_dist = 0;
-    for (Cell *cell : this->lichen_connected_cells) cell->lichen_dist = cell->path_info.dist;
+    for (Cell *factory_cell : this->cells) {
+        for (Cell *start : factory_cell->neighbors) {
+            if (start->lichen_strain() != this->id || nodes[start->id].stamp == stamp) continue;
+            visit(start);
+            while (!stack.empty()) {
+                Cell *c = stack.back().first;
+                LichenDfsNode &node = nodes[c->id];
+                if (stack.back().second < (int)c->neighbors.size()) {
+                    Cell *neighbor = c->neighbors[stack.back().second++];
+                    if (neighbor->factory() == this) {
+                        node.low = 0;
+                    } else if (neighbor->lichen_strain() == this->id) {
+                        if (nodes[neighbor->id].stamp != stamp) visit(neighbor);
+                        else node.low = MIN(node.low, nodes[neighbor->id].order);
+                    }
+                    continue;
+                }
 
-    for (Cell *cell : this->lichen_connected_cells) {
-        if (cell->lichen_dist > 10) continue;
-        vector<Cell*> outer_cells;
-        for (Cell *neighbor : cell->neighbors) {
-            if (neighbor->lichen_strain == this->id && neighbor->lichen_dist > cell->lichen_dist) {
-                outer_cells.push_back(neighbor);
-            }
-        }
-        int cell_count = 0;
-        int lichen_count = 0;
-        for (Cell *outer_cell : outer_cells) {
-            int cost = board.pathfind(NULL, outer_cell, NULL,
-                                      [&](Cell *c) { return ((c->lichen_strain == this->id
-                                                              || (c->factory == this))
-                                                             && c->lichen_dist < cell->lichen_dist); },
-                                      [&](Cell *c) { return (c == cell
-                                                             || c->lichen_strain != this->id); });
-            if (cost == INT_MAX) {
-                auto cell_cond = [&](Cell *c) {
-                    if (c->lichen_strain == this->id && c != cell) {
-                        cell_count += 1;
-                        lichen_count += c->lichen;
-                        return true;
-                    } return false;
-                };
-                board.flood_fill(outer_cell, cell_cond);
+                stack.pop_back();
+                if (stack.empty()) break;
+                LichenDfsNode &parent = nodes[stack.back().first->id];
+                parent.low = MIN(parent.low, node.low);
+                parent.cells += node.cells;
+                parent.lichen += node.lichen;
+                if (node.low >= parent.order) {
+                    parent.cut_cells += node.cells;
+                    parent.cut_lichen += node.lichen;
+                }
             }
         }
-        if (cell_count) {
+    }
+
+    for (Cell *cell : this->lichen_connected_cells) {
+        if (cell->lichen_dist() > 10) continue;
+        LichenDfsNode &node = nodes[cell->id];
+        if (node.stamp == stamp && node.cut_cells) {
             this->lichen_bottleneck_cells.push_back(cell);
-            cell->lichen_bottleneck_step = board.step;
-            cell->lichen_bottleneck_cell_count = cell_count;
-            cell->lichen_bottleneck_lichen_count = lichen_count;
-            //if (board.step % 100 == 0)
+            cell->lichen_bottleneck_step = board().step;
+            cell->lichen_bottleneck_cell_count = node.cut_cells;
+            cell->lichen_bottleneck_lichen_count = node.cut_lichen;
+            //if (board().step % 100 == 0)
             //    LUX_LOG("Bottleneck! " << *this << ' ' << *cell << ' '
-            //            << cell_count << ' ' << lichen_count);
+            //            << node.cut_cells << ' ' << node.cut_lichen);
         }
     }
 }
@@ -348,7 +393,8 @@ void Factory::update_lowland_routes(int max_dist, int min_lowland_size) {
     for (auto route : this->lowland_routes) delete route;
     this->lowland_routes.clear();
 
-    int magic_number = -(10 + this->id);
+    BitBoard processed;
+    processed.clear();
     set<int> checked = { -1 };
     Cell *rc = this->radius_cell(max_dist);
     while (rc) {
@@ -364,37 +410,33 @@ void Factory::update_lowland_routes(int max_dist, int min_lowland_size) {
                 new_route = true;
             } else {  // seen
                 // How near to a processed cell of same region are we (via that region)?
-                // Check neighbors first to try to determine quickly
-                bool neighbor_processed = false;
-                for (Cell *neighbor : rc->neighbors) {
-                    if (neighbor->flood_fill_call_id == magic_number) {
-                        neighbor_processed = true;
-                        break;
-                    }
-                }
-                if (!neighbor_processed) {
-                    int dist = board.pathfind(
-                        rc, NULL,
-                        [&](Cell *c) { return c->flood_fill_call_id == magic_number; },
-                        [&](Cell *c) {
-                            return !((rc->flatland_id != -1 && rc->flatland_id == c->flatland_id)
-                                     || (rc->lowland_id != -1 && rc->lowland_id == c->lowland_id)); },
-                        [&](Cell *c, Unit *u) { (void)c; (void)u; return 1; });
-                    LUX_ASSERT(dist != INT_MAX);
-                    new_route = (dist >= max_dist);
+                // The flatland layer is within the lowland layer, so rc's flatland region is within its lowland
+                // region: grow rc's reach through the lowland layer, which stays in rc's region if rc is in it
+                BitBoard region;
+                region.clear();
+                if (rc->lowland_id != -1) region = board().bits().lowland;
+                BitBoard reach;
+                reach.clear();
+                reach.set(rc->id);
+                int dist = 0;
+                while (!(reach & processed).any() && ++dist < max_dist) {
+                    BitBoard expand = reach & region;
+                    expand.set(rc->id);
+                    reach = reach | expand.dilate();
                 }
+                new_route = (dist >= max_dist);
             }
 
-            rc->flood_fill_call_id = magic_number;  // hack
+            processed.set(rc->id);
             if (new_route) {
                 vector<Cell*> *route = new vector<Cell*>();
-                int cost = board.pathfind(
-                    this->cell, rc, NULL,
-                    [&](Cell *c) { return (c->factory
+                int cost = board().pathfind_t(
+                    NULL, this->cell, rc, PathNone(),
+                    [&](Cell *c) { return (c->factory()
                                            || c->ore
                                            || c->ice
                                            || c->away_dist <= 2); },
-                    [&](Cell *c, Unit *u) {(void)u; return 150 + c->rubble - 5*MIN(10, c->away_dist);},
+                    [&](Cell *c, Unit *u) {(void)u; return 150 + c->rubble() - 5*MIN(10, c->away_dist);},
                     route);
                 if (cost != INT_MAX) {
                     this->lowland_routes.push_back(route);
@@ -409,7 +451,7 @@ void Factory::update_lowland_routes(int max_dist, int min_lowland_size) {
 
 void Factory::update_resource_routes(Resource resource, int max_dist, int max_count) {
     // re-sort resource cells based on current opp factory dists
-    if (board.real_env_step == 0) {
+    if (board().real_env_step == 0) {
         stable_sort(this->ice_cells.begin(), this->ice_cells.end(),
                     [&](const Cell *a, const Cell *b) {
                         int adist = a->man_dist_factory(this);
@@ -434,20 +476,16 @@ void Factory::update_resource_routes(Resource resource, int max_dist, int max_co
     for (auto route : routes) delete route;
     routes.clear();
 
+    // One search from the factory serves every resource cell, ice and ore alike
+    CostField const *field = board().cost_field(this, CostField_ROUTE);
     for (Cell *resource_cell : resource_cells) {
         int dist = resource_cell->man_dist_factory(this);
         if (dist > max_dist) break;
+        if (field->cost_to(resource_cell) == INT_MAX) continue;
 
         vector<Cell*> *route = new vector<Cell*>();
-        int cost = board.pathfind(
-            this->cell, resource_cell, NULL,
-            [&](Cell *c) { return (c->factory
-                                   || c->ore
-                                   || c->ice
-                                   || c->away_dist <= 1); },
-            [&](Cell *c, Unit *u) { (void)u; return 100 + c->rubble; },
-            route);
-        if (cost != INT_MAX && (int)route->size() - 1 <= max_dist) {
+        field->route_to(resource_cell, route);
+        if ((int)route->size() - 1 <= max_dist) {
             routes.push_back(route);
             if ((int)routes.size() >= max_count) break;
         } else {
@@ -461,7 +499,7 @@ void Factory::update_units() {  // called at beginning of sim0
     this->heavies.clear();
     this->lights.clear();
 
-    if (this->player == board.player) {
+    if (this->player == board().player) {
         // Use assigned_factory for my units. Then call add/remove_unit if necessary after sim steps
         for (Unit *unit : this->player->units()) {
             if (unit->assigned_factory == this) {
@@ -483,14 +521,14 @@ void Factory::update_units() {  // called at beginning of sim0
 }
 
 void Factory::add_unit(Unit *unit) {
-    LUX_ASSERT(unit->player == board.player);
+    LUX_ASSERT(unit->player == board().player);
     this->units.push_back(unit);
     if (unit->heavy) this->heavies.push_back(unit);
     else this->lights.push_back(unit);
 }
 
 void Factory::remove_unit(Unit *unit) {
-    LUX_ASSERT(unit->player == board.player);
+    LUX_ASSERT(unit->player == board().player);
     this->units.remove(unit);
     if (unit->heavy) this->heavies.remove(unit);
     else this->lights.remove(unit);
@@ -507,35 +545,35 @@ int Factory::get_similar_unit_count(Unit *unit, function<bool(Role*)> const& sim
 }
 
 void _create_new_unit(Factory *factory, bool heavy) {
-    int unit_id = board.units.size();
-    if (board.units.capacity() <= (size_t)unit_id) {
+    int unit_id = board().units.size();
+    if (board().units.capacity() <= (size_t)unit_id) {
         LUX_ASSERT(false);
     }
-    board.units.resize(unit_id + 1);
-    board.units[unit_id].init(
+    board().units.resize(unit_id + 1);
+    board().units[unit_id].init(
         unit_id,
         factory->player->id,
         factory->x,
         factory->y,
         heavy,
-        board.sim_step + 1,
+        board().sim_step + 1,
         0, 0, 0, 0,
         heavy ? g_heavy_cfg.POWER_COST : g_light_cfg.POWER_COST,
-        NULL);
+        NULL, 0);
 }
 
 bool Factory::_can_build_safely() {
     // Unit here next turn: not safe
-    if (this->cell->unit_next) return false;
+    if (this->cell->unit_next()) return false;
 
     // Unit here now, no move planned, insufficient power: not safe
-    Unit *unit = this->cell->unit;
+    Unit *unit = this->cell->unit();
     if (unit
         && !unit->cell_next()
         && unit->power < unit->cfg->ACTION_QUEUE_POWER_COST + unit->cfg->MOVE_COST) return false;
 
     // Too crowded
-    if (this->cell->unit
+    if (this->cell->unit()
         && this->cell->is_surrounded()) return false;
 
     return true;
@@ -548,7 +586,7 @@ bool Factory::can_build_light() {
 }
 
 void Factory::do_build_light() {
-    //if (board.sim0() && this->id == 2) LUX_LOG(*this << " build light");
+    //if (board().sim0() && this->id == 2) LUX_LOG(*this << " build light");
     this->action = FactoryAction_BUILD_LIGHT;
     this->power_delta -= g_light_cfg.POWER_COST;
     this->metal_delta -= g_light_cfg.METAL_COST;
@@ -579,8 +617,8 @@ bool Factory::can_water() {
 
 void Factory::do_water() {
     for (Cell *_cell : this->lichen_growth_cells) {
-        _cell->lichen += LICHEN_GAINED_WITH_WATER + LICHEN_LOST_WITHOUT_WATER;
-        _cell->lichen_strain = this->id;
+        _cell->lichen() += LICHEN_GAINED_WITH_WATER + LICHEN_LOST_WITHOUT_WATER;
+        _cell->lichen_strain() = this->id;
     }
     this->water_delta -= this->water_cost();
     this->action = FactoryAction_WATER;
@@ -591,7 +629,7 @@ void Factory::do_none() {
 }
 
 ostream& operator<<(ostream &os, const struct Factory &f) {
-    if (f.player == &board.home.player) os << "F." << f.id;
+    if (f.player == &board().home.player) os << "F." << f.id;
     else                                os << "F!" << f.id;
     return os;
 }
@@ -9,13 +9,13 @@ using namespace std;
 
 // Can assume only called on step idx 0
 void FactoryGroup::finalize() {
-    for (Factory *factory : board.player->factories()) {
+    for (Factory *factory : board().player->factories()) {
         factory->new_action = factory->action;
     }
 }
 
 void FactoryGroup::do_build() {
-    for (Factory *factory : board.player->factories()) {
+    for (Factory *factory : board().player->factories()) {
         if (factory->last_action_step < this->step
             && factory->mode->do_build()) {
             factory->last_action_step = this->step;
@@ -24,7 +24,7 @@ void FactoryGroup::do_build() {
 }
 
 void FactoryGroup::do_water() {
-    for (Factory *factory : board.player->factories()) {
+    for (Factory *factory : board().player->factories()) {
         if (factory->last_action_step < this->step
             && factory->mode->do_water()) {
             factory->last_action_step = this->step;
@@ -33,7 +33,7 @@ void FactoryGroup::do_water() {
 }
 
 void FactoryGroup::do_none() {
-    for (Factory *factory : board.player->factories()) {
+    for (Factory *factory : board().player->factories()) {
         if (factory->last_action_step < this->step) {
             factory->do_none();
             factory->last_action_step = this->step;
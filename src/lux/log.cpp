@@ -7,10 +7,10 @@ using namespace std;
 
 
 string log_prefix() {
-    if (board.step == board.sim_step) {
-        return to_string(board.step) + " ";
+    if (board().step == board().sim_step) {
+        return to_string(board().step) + " ";
     } else {
-        return to_string(board.step) + "@" + to_string(board.sim_step) + " ";
+        return to_string(board().step) + "@" + to_string(board().sim_step) + " ";
     }
 }
 
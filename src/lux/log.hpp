@@ -17,8 +17,17 @@
  * Example usage: LUX_LOG("this should be 5: " << aValue);
  */
 
-extern bool LUX_LOG_ON;
-extern bool LUX_LOG_DEBUG_ON;
+typedef struct LogState {
+    bool on;
+    bool debug_on;
+    std::string player;  // dev builds only log for this player
+} LogState;
+
+extern thread_local LogState *g_log;  // owned by the current MatchContext
+
+#define LUX_LOG_ON (g_log->on)
+#define LUX_LOG_DEBUG_ON (g_log->debug_on)
+#define LUX_LOG_PLAYER (g_log->player)
 #ifdef DEBUG_BUILD
 #    define LUX_LOG(...) if (LUX_LOG_ON) { std::cerr << log_prefix() << __VA_ARGS__ << std::endl; }
 #    define LUX_LOGF(...) if (LUX_LOG_ON) { std::cerr << log_prefix(); printf(__VA_ARGS__); std::cerr << std::endl; }
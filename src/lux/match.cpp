@@ -0,0 +1,26 @@
+#include "lux/match.hpp"
+
+#include "agent.hpp"
+#include "lux/board.hpp"
+#include "lux/log.hpp"
+#include "lux/object_pool.hpp"
+using namespace std;
+
+
+thread_local MatchContext *g_match = NULL;
+thread_local Board *g_board = NULL;
+thread_local Agent *g_agent = NULL;
+thread_local LogState *g_log = NULL;
+
+
+MatchContext::~MatchContext() {
+    if (g_match == this) pool_bind_stats(NULL);  // the thread's pool outlives this match
+}
+
+void MatchContext::bind() {
+    g_match = this;
+    g_board = &this->_board;
+    g_agent = &this->_agent;
+    g_log = &this->log;
+    pool_bind_stats(&this->pool_stats);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+#include "agent.hpp"
+#include "lux/board.hpp"
+#include "lux/log.hpp"
+#include "lux/object_pool.hpp"
+
+
+// All per-game state. Game code reaches it through `board()`, `agent()`, `prod()` and the LUX_LOG_*
+// flags, which resolve to the context bound on the calling thread, so one process can run several
+// matches side by side as long as each is only ever driven by one thread at a time.
+typedef struct MatchContext {
+    Board _board;  // reached as `board()` once bound
+    Agent _agent;  // reached as `agent()` once bound
+    bool prod;  // reached as `prod()` once bound
+    LogState log;
+    ObjectPoolStats pool_stats;  // reached as `pool_stats()` once bound
+
+    // ~~~ Methods:
+
+    ~MatchContext();
+
+    void bind();  // make this the current match of the calling thread
+} MatchContext;
+
+extern thread_local MatchContext *g_match;
+inline bool prod() { return g_match->prod; }  // the calling thread's match, see MatchContext::bind
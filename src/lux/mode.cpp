@@ -74,7 +74,7 @@ Role *Mode::_get_new_role(Unit *unit) {
     if (unit->heavy) {
         success = (
             false
-            || (board.sim_step >= 200
+            || (board().sim_step >= 200
                 && RoleCow::from_lichen_frontier(&r, unit, /*dist*/1, /*rubble*/20))
             || RoleMiner::from_resource(&r, unit, Resource_ORE, /*dist*/1, /*cdist*/5, /*count*/1)
             || RoleMiner::from_resource(&r, unit, Resource_ICE, /*dist*/1, /*cdist*/5, /*count*/1)
@@ -110,7 +110,7 @@ Role *Mode::_get_new_role(Unit *unit) {
 
             || (unit->power >= 2950
                 && RolePillager::from_lichen(&r, unit, /*dist*/45))
-            || (board.sim_step >= 750
+            || (board().sim_step >= 750
                 && RoleRelocate::from_idle(&r, unit))
             || RoleDefender::from_unit(&r, unit, /*dist*/25)
             || RoleRecharge::from_unit(&r, unit)
@@ -142,7 +142,7 @@ Role *Mode::_get_new_role(Unit *unit) {
             || RoleAttacker::from_transition_defend_territory(&r, unit, /*count*/4)
             || RoleAntagonizer::from_chain(&r, unit, /*dist*/20, /*count*/4)
             || RoleCow::from_lichen_repair(&r, unit, /*dist*/10)
-            || (board.sim_step < 750
+            || (board().sim_step < 750
                 && RoleRelocate::from_power_surplus(&r, unit))
 
             || RoleCow::from_lowland_route(&r, unit, /*dist*/8, /*size*/100, /*count*/2)
@@ -160,7 +160,7 @@ Role *Mode::_get_new_role(Unit *unit) {
             || RoleAttacker::from_transition_defend_territory(&r, unit, /*count*/8)
             || RoleCow::from_resource_route(&r, unit, Resource_ICE,/*dist*/10, /*routes*/3, /*count*/4)
 
-            || (board.sim_step >= 750
+            || (board().sim_step >= 750
                 && RoleRelocate::from_idle(&r, unit))
             || RoleDefender::from_unit(&r, unit, /*dist*/25)
             || RoleRecharge::from_unit(&r, unit)
@@ -173,9 +173,9 @@ Role *Mode::_get_new_role(Unit *unit) {
 
 // TODO: consider # of chain miners (and # of chain miners still needed)
 bool Mode::_build_heavy_next() {
-    if (board.sim_step >= END_PHASE + 30) return false;
+    if (board().sim_step >= END_PHASE + 30) return false;
 
-    int light_lim = 14 + board.sim_step / 100;
+    int light_lim = 14 + board().sim_step / 100;
     int heavy_count = this->factory->heavies.size();
     int light_count = this->factory->lights.size();
 
@@ -195,7 +195,7 @@ bool Mode::_build_heavy_next() {
 }
 
 bool Mode::_do_build() {
-    if (board.sim_step >= ICE_RUSH_PHASE) {
+    if (board().sim_step >= ICE_RUSH_PHASE) {
         return false;
     }
 
@@ -223,7 +223,7 @@ bool Mode::_do_water() {
     return false;*/
 
     // Always water last step, even if fatal
-    if (board.sim_step == 999) {
+    if (board().sim_step == 999) {
         this->factory->do_water();
         return true;
     }
@@ -235,11 +235,11 @@ bool Mode::_do_water() {
     }
 
     // Skip watering if not growing anywhere new
-    if (board.sim_step < END_PHASE
+    if (board().sim_step < END_PHASE
         && this->factory->lichen_flat_boundary_cells.empty()) {
         int min_growth_cell_lichen = INT_MAX;
         for (Cell *c : this->factory->lichen_growth_cells) {
-            if (c->lichen < min_growth_cell_lichen) min_growth_cell_lichen = c->lichen;
+            if (c->lichen() < min_growth_cell_lichen) min_growth_cell_lichen = c->lichen();
         }
         if (min_growth_cell_lichen >= 15) {
             return false;
@@ -249,7 +249,7 @@ bool Mode::_do_water() {
     // Go for broke at the end
     int water = this->factory->total_water();
     int broke_water_threshold = (  1                           * (1 + water_cost)
-                                 + (1000 - board.sim_step - 2) * (1 + water_cost + 1)
+                                 + (1000 - board().sim_step - 2) * (1 + water_cost + 1)
                                  + 1                           * 0);
     if (water >= broke_water_threshold) {
         this->factory->do_water();
@@ -268,7 +268,7 @@ bool Mode::_do_water() {
     if (water_remaining >= USUALLY_WATER_THRESHOLD) {
         if (water_remaining >= ALWAYS_WATER_THRESHOLD
             || this->factory->heavy_ice_miner_count > 0
-            || board.sim_step % 2 == 0) {
+            || board().sim_step % 2 == 0) {
             this->factory->do_water();
             return true;
         }
@@ -279,7 +279,7 @@ bool Mode::_do_water() {
     double percent_do_water = (water_income - 1) / water_cost;
     //LUX_LOG("do_water " << *this->factory << ' ' << water_income << ' '
     //        << water_cost << ' ' << percent_do_water);
-    if (prandom(board.sim_step + this->factory->id, percent_do_water)) {
+    if (prandom(board().sim_step + this->factory->id, percent_do_water)) {
         this->factory->do_water();
         return true;
     }
@@ -288,7 +288,7 @@ bool Mode::_do_water() {
 }
 
 void Mode::set() {
-    this->_set_step = 1000 * board.step + board.sim_step;
+    this->_set_step = 1000 * board().step + board().sim_step;
 }
 
 void Mode::unset() {
@@ -296,5 +296,5 @@ void Mode::unset() {
 }
 
 bool Mode::is_set() {
-    return this->_set_step == 1000 * board.step + board.sim_step;
+    return this->_set_step == 1000 * board().step + board().sim_step;
 }
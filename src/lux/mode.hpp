@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "lux/object_pool.hpp"
+
 
 struct Factory;
 struct Role;
@@ -17,6 +19,10 @@ typedef struct Mode {
     Mode(struct Factory *_factory);
     virtual ~Mode() = default;
 
+    // Modes are copied and deleted every turn, see pool_alloc
+    static void *operator new(size_t size) { return pool_alloc(size); }
+    static void operator delete(void *ptr, size_t size) { pool_free(ptr, size); }
+
     bool is_set();
 
     // Default implementations available to all modes
@@ -27,13 +27,13 @@ bool ModeIceConflict::from_transition_antagonized(Mode **new_mode, Factory *_fac
     LUX_ASSERT(new_mode);
     LUX_ASSERT(_factory);
 
-    if (!board.sim0()) return false;
+    if (!board().sim0()) return false;
 
     // Skip factories that are already in ice conflict mode
     if (ModeIceConflict::cast(_factory->mode)) return false;
 
     // Really need a friendly factory to pull this off
-    if (board.player->factories().size() == 1) return false;
+    if (board().player->factories().size() == 1) return false;
 
     // Only applicable for single-heavy factories
     if (_factory->heavies.size() != 1) return false;
@@ -93,14 +93,14 @@ bool ModeIceConflict::from_ice_superiority(Mode **new_mode, Factory *_factory) {
     LUX_ASSERT(_factory);
 
     // Start of game only
-    if (board.sim_step != 0) return false;
+    if (board().sim_step != 0) return false;
 
     bool ice1 = _factory->ice_cells[0]->man_dist_factory(_factory) == 1;
-    for (Factory *opp_factory : board.opp->factories()) {
+    for (Factory *opp_factory : board().opp->factories()) {
         // If non-desperate, avoid double-attacking opp factories
         bool already_handled = false;
         if (ice1) {
-            for (Factory *own_factory : board.player->factories()) {
+            for (Factory *own_factory : board().player->factories()) {
                 ModeIceConflict *mode = ModeIceConflict::cast(own_factory->mode);
                 if (mode && mode->opp_factory == opp_factory) already_handled = true;
             }
@@ -132,7 +132,7 @@ bool ModeIceConflict::from_desperation(Mode **new_mode, Factory *_factory,
         desperate = true;
 
         // Start of game only
-        if (board.sim_step != 0) return false;
+        if (board().sim_step != 0) return false;
 
         // If there is adjacent ice, this factory is not desperate
         if (_factory->ice_cells[0]->man_dist_factory(_factory) <= 1) return false;
@@ -140,7 +140,7 @@ bool ModeIceConflict::from_desperation(Mode **new_mode, Factory *_factory,
 
     Factory *_opp_factory = (attacking_factory
                              ? attacking_factory
-                             : _factory->cell->nearest_factory(board.opp));
+                             : _factory->cell->nearest_factory(board().opp));
     *new_mode = new ModeIceConflict(_factory, _opp_factory, defensive, desperate);
     return true;
 }
@@ -165,15 +165,15 @@ bool ModeIceConflict::is_valid() {
 
     // Quickly abort non-critical ice conflict battles if there are too many
     if (is_valid
-        && board.sim0()
+        && board().sim0()
         && this->offensive
         && this->factory->ice_cells[0]->man_dist_factory(this->factory) == 1
         && (this->opp_factory->ice_cells[0]->man_dist_factory(this->opp_factory) == 1
-            || board.step >= 2)) {
+            || board().step >= 2)) {
         int ice_conflict_count = 0;
         int default_count = 0;
         ModeIceConflict *mode;
-        for (Factory *f : board.player->factories()) {
+        for (Factory *f : board().player->factories()) {
             if ((mode = ModeIceConflict::cast(f->mode))
                 && mode->opp_factory->alive()
                 && mode->opp_factory->water > 15) {
@@ -190,7 +190,7 @@ bool ModeIceConflict::is_valid() {
 
     // Invalidate defensive conflict when a second heavy arrives
     if (is_valid
-        && board.sim0()
+        && board().sim0()
         && this->defensive
         && this->factory->heavies.size() > 1) {
         is_valid = false;
@@ -198,7 +198,7 @@ bool ModeIceConflict::is_valid() {
 
     // Invalidate defensive conflict if nearest ice cell is unthreatened
     if (is_valid
-        && board.sim0()
+        && board().sim0()
         && this->defensive
         && this->factory->heavies.size() == 1) {
         Unit *heavy_unit = this->factory->heavies.back();
@@ -209,7 +209,7 @@ bool ModeIceConflict::is_valid() {
 
     // Invalidate defensive conflict if attacking factory has 0 remaining heavies
     if (is_valid
-        && board.sim0()
+        && board().sim0()
         && this->defensive
         && this->opp_factory->heavies.empty()
         && this->opp_factory->total_metal() < g_heavy_cfg.METAL_COST) {
@@ -230,7 +230,7 @@ bool ModeIceConflict::is_valid() {
 
         // Ensure at least one ice cell is assigned to this factory
         map<Factory*, int> ice_cell_counts;
-        for (Cell *ice_cell : board.ice_cells) {
+        for (Cell *ice_cell : board().ice_cells) {
             if (ice_cell->assigned_factory) ice_cell_counts[ice_cell->assigned_factory] += 1;
         }
         if (!ice_cell_counts.count(this->factory)) {
@@ -238,7 +238,7 @@ bool ModeIceConflict::is_valid() {
                 if (!ice_cell->assigned_factory
                     || (ice_cell_counts.count(ice_cell->assigned_factory)
                         && ice_cell_counts[ice_cell->assigned_factory] > 1)) {
-                    ice_cell->assigned_factory = this->factory;
+                    board().set_assigned_factory(ice_cell, this->factory);
                     break;
                 }
             }
@@ -287,10 +287,10 @@ Role *ModeIceConflict::get_new_role(Unit *unit) {
         success = (
             false
             || RoleWaterTransporter::from_ice_conflict(&r, unit)
-            || (board.step >= 3
+            || (board().step >= 3
                 && RoleCow::from_custom_route(&r, unit, heavy_ant_target_cell, /*count*/1))
             || RoleAntagonizer::from_chain(&r, unit, /*dist*/12, /*count*/2)
-            || (board.low_iceland()
+            || (board().low_iceland()
                 && RoleMiner::from_resource(&r, unit,Resource_ICE, /*dist*/20, /*cdist*/0, /*count*/3))
             || RoleAntagonizer::from_mine(&r, unit, Resource_ICE, /*dist*/15, /*count*/1)
             || (this->factory->power >= 1000
@@ -324,7 +324,7 @@ bool ModeIceConflict::do_build() {
 }
 
 bool ModeIceConflict::do_water() {
-    if (this->factory->water >= ALWAYS_WATER_THRESHOLD || board.sim_step >= END_PHASE) {
+    if (this->factory->water >= ALWAYS_WATER_THRESHOLD || board().sim_step >= END_PHASE) {
         return this->_do_water();
     }
     return false;
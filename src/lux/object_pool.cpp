@@ -0,0 +1,75 @@
+#include "lux/object_pool.hpp"
+
+#include <new>  // operator new
+using namespace std;
+
+
+#define OBJECT_POOL_CLASSES (OBJECT_POOL_MAX_SIZE / OBJECT_POOL_GRAIN)
+
+typedef struct FreeBlock {
+    struct FreeBlock *next;
+} FreeBlock;
+
+typedef struct ObjectPool {
+    FreeBlock *free_lists[OBJECT_POOL_CLASSES];
+    ObjectPoolStats unbound_stats;  // until pool_bind_stats
+    ObjectPoolStats *stats;
+
+    // ~~~ Methods:
+
+    ObjectPool() : free_lists(), unbound_stats(), stats(&unbound_stats) {}
+
+    ~ObjectPool() {
+        for (FreeBlock *block : this->free_lists) {
+            while (block) {
+                FreeBlock *next = block->next;
+                ::operator delete(block);
+                block = next;
+            }
+        }
+    }
+} ObjectPool;
+
+static thread_local ObjectPool t_pool;
+
+static inline int _size_class(size_t size) {
+    return (size + OBJECT_POOL_GRAIN - 1) / OBJECT_POOL_GRAIN - 1;
+}
+
+void *pool_alloc(size_t size) {
+    t_pool.stats->allocs += 1;
+    if (size > OBJECT_POOL_MAX_SIZE) {
+        t_pool.stats->heap_allocs += 1;
+        return ::operator new(size);
+    }
+
+    int size_class = _size_class(size);
+    FreeBlock *block = t_pool.free_lists[size_class];
+    if (!block) {
+        t_pool.stats->heap_allocs += 1;
+        return ::operator new((size_class + 1) * OBJECT_POOL_GRAIN);
+    }
+    t_pool.free_lists[size_class] = block->next;
+    return block;
+}
+
+void pool_free(void *ptr, size_t size) {
+    if (!ptr) return;
+    if (size > OBJECT_POOL_MAX_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    int size_class = _size_class(size);
+    FreeBlock *block = static_cast<FreeBlock*>(ptr);
+    block->next = t_pool.free_lists[size_class];
+    t_pool.free_lists[size_class] = block;
+}
+
+void pool_bind_stats(ObjectPoolStats *stats) {
+    t_pool.stats = (stats ? stats : &t_pool.unbound_stats);
+}
+
+ObjectPoolStats pool_stats() {
+    return *t_pool.stats;
+}
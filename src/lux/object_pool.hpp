@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>  // size_t
+
+
+#define OBJECT_POOL_GRAIN 16  // size classes are multiples of this
+#define OBJECT_POOL_MAX_SIZE 1024  // larger objects always come from the heap
+
+// Allocation counts, kept by the calling thread's pool in the stats bound with pool_bind_stats
+typedef struct ObjectPoolStats {
+    long allocs;  // pool_alloc calls
+    long heap_allocs;  // of those, served by a new heap block
+} ObjectPoolStats;
+
+// Per-thread free lists by size class for the small polymorphic objects recreated every sim step, see Role and
+// Mode operator new. Freed blocks are kept for reuse, so once warm a turn no longer touches the heap. A block
+// freed on another thread than it was allocated on joins that thread's lists.
+void *pool_alloc(size_t size);
+void pool_free(void *ptr, size_t size);
+void pool_bind_stats(ObjectPoolStats *stats);  // count the calling thread's allocations there (NULL: unbound)
+ObjectPoolStats pool_stats();
@@ -0,0 +1,754 @@
+#include "lux/observation.hpp"
+
+#include <cstring>  // memcpy
+
+#include "lux/exception.hpp"
+#include "lux/log.hpp"
+#include "lux/wire.hpp"
+using namespace std;
+
+
+typedef enum ObsCtx : int8_t {
+    ObsCtx_SKIP = 0,
+    ObsCtx_ROOT,
+    ObsCtx_OBS,
+    ObsCtx_UNITS,
+    ObsCtx_PLAYER_UNITS,
+    ObsCtx_UNIT,
+    ObsCtx_UNIT_POS,
+    ObsCtx_UNIT_CARGO,
+    ObsCtx_UNIT_AQ,
+    ObsCtx_UNIT_AQ_ITEM,
+    ObsCtx_TEAMS,
+    ObsCtx_TEAM,
+    ObsCtx_TEAM_STRAINS,
+    ObsCtx_FACTORIES,
+    ObsCtx_PLAYER_FACTORIES,
+    ObsCtx_FACTORY,
+    ObsCtx_FACTORY_POS,
+    ObsCtx_FACTORY_CARGO,
+    ObsCtx_BOARD,
+    ObsCtx_PLANE,
+    ObsCtx_PLANE_ROW,
+    ObsCtx_DELTAS,
+} ObsCtx;
+
+typedef enum ObsKey : int8_t {
+    ObsKey_OTHER = 0,
+    ObsKey_OBS,
+    ObsKey_STEP,
+    ObsKey_REMAINING_OVERAGE_TIME,
+    ObsKey_PLAYER,
+    ObsKey_UNITS,
+    ObsKey_TEAMS,
+    ObsKey_FACTORIES,
+    ObsKey_BOARD,
+    ObsKey_REAL_ENV_STEPS,
+    ObsKey_TEAM_ID,
+    ObsKey_UNIT_ID,
+    ObsKey_UNIT_TYPE,
+    ObsKey_STRAIN_ID,
+    ObsKey_POS,
+    ObsKey_POWER,
+    ObsKey_CARGO,
+    ObsKey_ACTION_QUEUE,
+    ObsKey_ICE,
+    ObsKey_ORE,
+    ObsKey_WATER,
+    ObsKey_METAL,
+    ObsKey_PLACE_FIRST,
+    ObsKey_FACTORY_STRAINS,
+    ObsKey_RUBBLE,
+    ObsKey_LICHEN,
+    ObsKey_LICHEN_STRAINS,
+    ObsKey_VALID_SPAWNS_MASK,
+    ObsKey_FACTORIES_PER_TEAM,
+} ObsKey;
+
+static ObsKey _obs_key(const string &k) {
+    switch (k.size()) {
+    case 3:
+        if (k == "obs") return ObsKey_OBS;
+        if (k == "pos") return ObsKey_POS;
+        if (k == "ice") return ObsKey_ICE;
+        if (k == "ore") return ObsKey_ORE;
+        break;
+    case 4:
+        if (k == "step") return ObsKey_STEP;
+        break;
+    case 5:
+        if (k == "units") return ObsKey_UNITS;
+        if (k == "teams") return ObsKey_TEAMS;
+        if (k == "board") return ObsKey_BOARD;
+        if (k == "power") return ObsKey_POWER;
+        if (k == "cargo") return ObsKey_CARGO;
+        if (k == "water") return ObsKey_WATER;
+        if (k == "metal") return ObsKey_METAL;
+        break;
+    case 6:
+        if (k == "player") return ObsKey_PLAYER;
+        if (k == "rubble") return ObsKey_RUBBLE;
+        if (k == "lichen") return ObsKey_LICHEN;
+        break;
+    case 7:
+        if (k == "team_id") return ObsKey_TEAM_ID;
+        if (k == "unit_id") return ObsKey_UNIT_ID;
+        break;
+    case 9:
+        if (k == "factories") return ObsKey_FACTORIES;
+        if (k == "unit_type") return ObsKey_UNIT_TYPE;
+        if (k == "strain_id") return ObsKey_STRAIN_ID;
+        break;
+    case 11:
+        if (k == "place_first") return ObsKey_PLACE_FIRST;
+        break;
+    case 12:
+        if (k == "action_queue") return ObsKey_ACTION_QUEUE;
+        break;
+    case 14:
+        if (k == "real_env_steps") return ObsKey_REAL_ENV_STEPS;
+        if (k == "lichen_strains") return ObsKey_LICHEN_STRAINS;
+        break;
+    case 15:
+        if (k == "factory_strains") return ObsKey_FACTORY_STRAINS;
+        break;
+    case 17:
+        if (k == "valid_spawns_mask") return ObsKey_VALID_SPAWNS_MASK;
+        break;
+    case 18:
+        if (k == "factories_per_team") return ObsKey_FACTORIES_PER_TEAM;
+        break;
+    case 20:
+        if (k == "remainingOverageTime") return ObsKey_REMAINING_OVERAGE_TIME;
+        break;
+    }
+    return ObsKey_OTHER;
+}
+
+bool parse_cell_key(const char *key, size_t len, int16_t *x, int16_t *y) {
+    int16_t vals[2] = {0, 0};
+    int digits[2] = {0, 0};
+    int part = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = key[i];
+        if (c >= '0' && c <= '9') {
+            vals[part] = vals[part] * 10 + (c - '0');
+            if (vals[part] >= SIZE) return false;
+            digits[part]++;
+        } else if (c == ',' && part == 0) {
+            part = 1;
+        } else if (c != ' ') {
+            return false;
+        }
+    }
+    if (part != 1 || !digits[0] || !digits[1]) return false;
+    *x = vals[0];
+    *y = vals[1];
+    return true;
+}
+
+static int _obs_team_index(const string &k) {  // "player_0" -> 0
+    if (k.size() != 8 || k.compare(0, 7, "player_") != 0) return -1;
+    if (k[7] == '0') return 0;
+    if (k[7] == '1') return 1;
+    return -1;
+}
+
+static int16_t _obs_unit_id(const string &s) {  // "unit_12" -> 12
+    return static_cast<int16_t>(stoi(s.substr(s.find("_") + 1)));
+}
+
+// Streams tokens from the input line straight into an Observation without building a DOM.
+// Each open object/array pushes a frame describing what its members are; scalars are written
+// according to the innermost frame and the most recent key.
+typedef struct ObservationSax {
+    typedef struct Frame {
+        ObsCtx ctx;
+        ObsKey key;
+        int8_t team;
+        int16_t idx;  // array element index
+        int16_t x;
+        int16_t y;
+        int8_t *plane;
+        CellDeltaField field;
+    } Frame;
+
+    Observation *obs;
+    Frame stack[16];
+    int depth;
+    bool ok;
+
+    // ~~~ Methods:
+
+    Frame *top() { return &this->stack[this->depth - 1]; }
+
+    bool push(ObsCtx ctx) {
+        if (this->depth >= 16) return (this->ok = false);
+        Frame *f = &this->stack[this->depth++];
+        f->ctx = ctx;
+        f->key = ObsKey_OTHER;
+        f->team = -1;
+        f->idx = 0;
+        f->x = 0;
+        f->y = 0;
+        f->plane = NULL;
+        f->field = CellDelta_RUBBLE;
+        return true;
+    }
+
+    bool pop() {
+        this->depth--;
+        if (this->depth > 0) this->top()->idx++;  // harmless for object frames
+        return true;
+    }
+
+    bool start_container(bool is_array) {
+        if (this->depth == 0) return this->push(is_array ? ObsCtx_SKIP : ObsCtx_ROOT);
+
+        Frame *p = this->top();
+        ObsCtx ctx = ObsCtx_SKIP;
+        int8_t *plane = NULL;
+        int8_t field = 0;
+        int16_t x = 0;
+
+        switch (p->ctx) {
+        case ObsCtx_ROOT:
+            if (!is_array && p->key == ObsKey_OBS) ctx = ObsCtx_OBS;
+            break;
+        case ObsCtx_OBS:
+            if (is_array) break;
+            if (p->key == ObsKey_UNITS) ctx = ObsCtx_UNITS;
+            else if (p->key == ObsKey_TEAMS) ctx = ObsCtx_TEAMS;
+            else if (p->key == ObsKey_FACTORIES) ctx = ObsCtx_FACTORIES;
+            else if (p->key == ObsKey_BOARD) ctx = ObsCtx_BOARD;
+            break;
+        case ObsCtx_UNITS:
+            if (!is_array) ctx = ObsCtx_PLAYER_UNITS;
+            break;
+        case ObsCtx_PLAYER_UNITS:
+            if (!is_array) {
+                ctx = ObsCtx_UNIT;
+                this->obs->units.emplace_back();
+                this->obs->units.back().aq_len = 0;
+            }
+            break;
+        case ObsCtx_UNIT:
+            if (is_array && p->key == ObsKey_POS) ctx = ObsCtx_UNIT_POS;
+            else if (!is_array && p->key == ObsKey_CARGO) ctx = ObsCtx_UNIT_CARGO;
+            else if (is_array && p->key == ObsKey_ACTION_QUEUE) ctx = ObsCtx_UNIT_AQ;
+            break;
+        case ObsCtx_UNIT_AQ:
+            if (is_array) {
+                ObsUnit *unit = &this->obs->units.back();
+                if (unit->aq_len >= UNIT_ACTION_QUEUE_SIZE) return (this->ok = false);
+                unit->aq[unit->aq_len++] = ActionSpec{};
+                ctx = ObsCtx_UNIT_AQ_ITEM;
+            }
+            break;
+        case ObsCtx_TEAMS:
+            if (!is_array && p->team >= 0) ctx = ObsCtx_TEAM;
+            break;
+        case ObsCtx_TEAM:
+            if (is_array && p->key == ObsKey_FACTORY_STRAINS) ctx = ObsCtx_TEAM_STRAINS;
+            break;
+        case ObsCtx_FACTORIES:
+            if (!is_array) ctx = ObsCtx_PLAYER_FACTORIES;
+            break;
+        case ObsCtx_PLAYER_FACTORIES:
+            if (!is_array) {
+                ctx = ObsCtx_FACTORY;
+                this->obs->factories.emplace_back();
+            }
+            break;
+        case ObsCtx_FACTORY:
+            if (is_array && p->key == ObsKey_POS) ctx = ObsCtx_FACTORY_POS;
+            else if (!is_array && p->key == ObsKey_CARGO) ctx = ObsCtx_FACTORY_CARGO;
+            break;
+        case ObsCtx_BOARD:
+            if (is_array) {
+                if (p->key == ObsKey_ICE) { plane = this->obs->ice; this->obs->has_ice = true; }
+                else if (p->key == ObsKey_ORE) { plane = this->obs->ore; this->obs->has_ore = true; }
+                else if (p->key == ObsKey_RUBBLE) { plane = this->obs->rubble; this->obs->has_rubble = true; }
+                else if (p->key == ObsKey_VALID_SPAWNS_MASK) {
+                    plane = this->obs->valid_spawns_mask;
+                    this->obs->has_valid_spawns_mask = true;
+                }
+                if (plane) ctx = ObsCtx_PLANE;
+            } else {
+                if (p->key == ObsKey_RUBBLE) field = CellDelta_RUBBLE;
+                else if (p->key == ObsKey_LICHEN) field = CellDelta_LICHEN;
+                else if (p->key == ObsKey_LICHEN_STRAINS) field = CellDelta_LICHEN_STRAIN;
+                if (field) ctx = ObsCtx_DELTAS;
+            }
+            break;
+        case ObsCtx_PLANE:
+            if (is_array) {
+                if (p->idx >= SIZE) return (this->ok = false);
+                ctx = ObsCtx_PLANE_ROW;
+                plane = p->plane;
+                x = p->idx;
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (!this->push(ctx)) return false;
+        Frame *f = this->top();
+        f->plane = plane;
+        if (field) f->field = (CellDeltaField)field;
+        f->x = x;
+        return true;
+    }
+
+    bool value(int64_t v) {
+        if (this->depth == 0) return (this->ok = false);
+        Frame *f = this->top();
+        switch (f->ctx) {
+        case ObsCtx_ROOT:
+            if (f->key == ObsKey_STEP) this->obs->step = v;
+            else if (f->key == ObsKey_REMAINING_OVERAGE_TIME) this->obs->remainingOverageTime = v;
+            break;
+        case ObsCtx_OBS:
+            if (f->key == ObsKey_REAL_ENV_STEPS) this->obs->real_env_steps = v;
+            break;
+        case ObsCtx_UNIT: {
+            ObsUnit *unit = &this->obs->units.back();
+            if (f->key == ObsKey_TEAM_ID) unit->team_id = v;
+            else if (f->key == ObsKey_POWER) unit->power = v;
+            break;
+        }
+        case ObsCtx_UNIT_POS:
+            if (f->idx == 0) this->obs->units.back().x = v;
+            else if (f->idx == 1) this->obs->units.back().y = v;
+            break;
+        case ObsCtx_UNIT_CARGO: {
+            ObsUnit *unit = &this->obs->units.back();
+            if (f->key == ObsKey_ICE) unit->ice = v;
+            else if (f->key == ObsKey_ORE) unit->ore = v;
+            else if (f->key == ObsKey_WATER) unit->water = v;
+            else if (f->key == ObsKey_METAL) unit->metal = v;
+            break;
+        }
+        case ObsCtx_UNIT_AQ_ITEM: {
+            ObsUnit *unit = &this->obs->units.back();
+            ActionSpec *spec = &unit->aq[unit->aq_len - 1];
+            if (f->idx == 0) spec->action = (UnitAction)v;
+            else if (f->idx == 1) spec->direction = (Direction)v;
+            else if (f->idx == 2) spec->resource = (Resource)v;
+            else if (f->idx == 3) spec->amount = v;
+            else if (f->idx == 4) spec->repeat = v;
+            else if (f->idx == 5) spec->n = v;
+            break;
+        }
+        case ObsCtx_TEAM: {
+            ObsTeam *team = &this->obs->teams[this->stack[this->depth - 2].team];
+            if (f->key == ObsKey_WATER) team->water = v;
+            else if (f->key == ObsKey_METAL) team->metal = v;
+            else if (f->key == ObsKey_PLACE_FIRST) team->place_first = v;
+            break;
+        }
+        case ObsCtx_TEAM_STRAINS:
+            this->obs->teams[this->stack[this->depth - 3].team].factory_strains.push_back(v);
+            break;
+        case ObsCtx_FACTORY: {
+            ObsFactory *factory = &this->obs->factories.back();
+            if (f->key == ObsKey_STRAIN_ID) factory->id = v;
+            else if (f->key == ObsKey_TEAM_ID) factory->team_id = v;
+            else if (f->key == ObsKey_POWER) factory->power = v;
+            break;
+        }
+        case ObsCtx_FACTORY_POS:
+            if (f->idx == 0) this->obs->factories.back().x = v;
+            else if (f->idx == 1) this->obs->factories.back().y = v;
+            break;
+        case ObsCtx_FACTORY_CARGO: {
+            ObsFactory *factory = &this->obs->factories.back();
+            if (f->key == ObsKey_ICE) factory->ice = v;
+            else if (f->key == ObsKey_ORE) factory->ore = v;
+            else if (f->key == ObsKey_WATER) factory->water = v;
+            else if (f->key == ObsKey_METAL) factory->metal = v;
+            break;
+        }
+        case ObsCtx_BOARD:
+            if (f->key == ObsKey_FACTORIES_PER_TEAM) this->obs->factories_per_team = v;
+            break;
+        case ObsCtx_PLANE_ROW:
+            if (f->idx >= SIZE) return (this->ok = false);
+            f->plane[f->idx * SIZE + f->x] = v;
+            break;
+        case ObsCtx_DELTAS:
+            this->obs->add_cell_delta(f->y * SIZE + f->x, f->field, v);
+            break;
+        default:
+            break;
+        }
+        f->idx++;
+        return true;
+    }
+
+    bool string_value(std::string &s) {
+        if (this->depth == 0) return (this->ok = false);
+        Frame *f = this->top();
+        if (f->ctx == ObsCtx_ROOT && f->key == ObsKey_PLAYER) {
+            this->obs->player = s;
+        } else if (f->ctx == ObsCtx_UNIT && f->key == ObsKey_UNIT_ID) {
+            this->obs->units.back().id = _obs_unit_id(s);
+        } else if (f->ctx == ObsCtx_UNIT && f->key == ObsKey_UNIT_TYPE) {
+            this->obs->units.back().heavy = (s.at(0) == 'H');
+        }
+        f->idx++;
+        return true;
+    }
+
+    // nlohmann SAX interface:
+
+    bool null() { if (this->depth) this->top()->idx++; return true; }
+    bool boolean(bool v) { return this->value(v); }
+    bool number_integer(json::number_integer_t v) { return this->value(v); }
+    bool number_unsigned(json::number_unsigned_t v) { return this->value(v); }
+    bool number_float(json::number_float_t v, const json::string_t &) { return this->value((int64_t)v); }
+    bool string(json::string_t &s) { return this->string_value(s); }
+    bool binary(json::binary_t &) { return (this->ok = false); }
+    bool start_object(std::size_t) { return this->start_container(false); }
+    bool start_array(std::size_t) { return this->start_container(true); }
+    bool end_object() { return this->pop(); }
+    bool end_array() { return this->pop(); }
+
+    bool key(json::string_t &k) {
+        Frame *f = this->top();
+        if (f->ctx == ObsCtx_DELTAS) {
+            if (!parse_cell_key(k.data(), k.size(), &f->x, &f->y)) return (this->ok = false);
+        } else if (f->ctx == ObsCtx_UNITS || f->ctx == ObsCtx_TEAMS || f->ctx == ObsCtx_FACTORIES) {
+            f->team = _obs_team_index(k);
+        } else if (f->ctx != ObsCtx_SKIP && f->ctx != ObsCtx_PLAYER_UNITS
+                   && f->ctx != ObsCtx_PLAYER_FACTORIES) {
+            f->key = _obs_key(k);
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) {
+        return (this->ok = false);
+    }
+} ObservationSax;
+
+void Observation::clear() {
+    this->step = 0;
+    this->remainingOverageTime = 0;
+    this->real_env_steps = 0;
+    this->factories_per_team = 0;
+    for (ObsTeam &team : this->teams) {
+        team.water = 0;
+        team.metal = 0;
+        team.place_first = false;
+        team.factory_strains.clear();
+    }
+    this->has_ice = false;
+    this->has_ore = false;
+    this->has_rubble = false;
+    this->has_valid_spawns_mask = false;
+    for (ObsCellDelta &delta : this->cell_deltas) this->_cell_delta_index[delta.cell_id] = -1;
+    this->cell_deltas.clear();
+    this->units.clear();
+    this->factories.clear();
+    this->parse_time = 0;
+}
+
+void Observation::add_cell_delta(int16_t cell_id, CellDeltaField field, int value) {
+    int16_t idx = this->_cell_delta_index[cell_id];
+    if (idx < 0
+        || idx >= (int16_t)this->cell_deltas.size()
+        || this->cell_deltas[idx].cell_id != cell_id) {
+        idx = this->cell_deltas.size();
+        this->_cell_delta_index[cell_id] = idx;
+        this->cell_deltas.push_back(ObsCellDelta{cell_id, 0, 0, 0, 0});
+    }
+
+    ObsCellDelta *delta = &this->cell_deltas[idx];
+    delta->fields |= field;
+    if (field == CellDelta_RUBBLE) delta->rubble = value;
+    else if (field == CellDelta_LICHEN) delta->lichen = value;
+    else delta->lichen_strain = value;
+}
+
+bool Observation::parse(const string &line) {
+    this->clear();
+    ObservationSax sax{.obs = this, .stack = {}, .depth = 0, .ok = true};
+    try {
+        bool res = json::sax_parse(line, &sax);
+        return res && sax.ok && sax.depth == 0;
+    } catch (std::exception &e) {
+        LUX_LOG("Observation::parse failed: " << e.what());
+        return false;
+    }
+}
+
+static void _load_plane(json &plane_info, int8_t *plane) {
+    for (int16_t x = 0; x < SIZE; x++) {
+        for (int16_t y = 0; y < SIZE; y++) {
+            plane[y * SIZE + x] = plane_info.at(x).at(y);
+        }
+    }
+}
+
+static void _load_deltas(json &deltas_info, Observation *obs, CellDeltaField field) {
+    for (const auto &[k, v] : deltas_info.items()) {
+        int16_t x, y;
+        LUX_ASSERT(parse_cell_key(k.data(), k.size(), &x, &y));
+        obs->add_cell_delta(y * SIZE + x, field, v.get<int>());
+    }
+}
+
+void Observation::load_json(json &input) {
+    this->clear();
+    input.at("step").get_to(this->step);
+    input.at("remainingOverageTime").get_to(this->remainingOverageTime);
+    input.at("player").get_to(this->player);
+
+    json &obs = input.at("obs");
+    json &board_info = obs.at("board");
+    obs.at("real_env_steps").get_to(this->real_env_steps);
+    if (board_info.contains("factories_per_team")) {
+        board_info.at("factories_per_team").get_to(this->factories_per_team);
+    }
+
+    for (auto &[player_id_str, team_info] : obs.at("teams").items()) {
+        int team_index = _obs_team_index(player_id_str);
+        if (team_index < 0) continue;
+        ObsTeam *team = &this->teams[team_index];
+        team_info.at("water").get_to(team->water);
+        team_info.at("metal").get_to(team->metal);
+        team_info.at("place_first").get_to(team->place_first);
+        team_info.at("factory_strains").get_to(team->factory_strains);
+    }
+
+    const char *plane_keys[] = { "ice", "ore", "rubble", "valid_spawns_mask" };
+    int8_t *planes[] = { this->ice, this->ore, this->rubble, this->valid_spawns_mask };
+    bool *has_planes[] = { &this->has_ice, &this->has_ore, &this->has_rubble, &this->has_valid_spawns_mask };
+    for (int i = 0; i < 4; i++) {
+        auto it = board_info.find(plane_keys[i]);
+        if (it != board_info.end() && it->is_array()) {
+            _load_plane(*it, planes[i]);
+            *has_planes[i] = true;
+        }
+    }
+
+    const char *delta_keys[] = { "rubble", "lichen", "lichen_strains" };
+    CellDeltaField delta_fields[] = { CellDelta_RUBBLE, CellDelta_LICHEN, CellDelta_LICHEN_STRAIN };
+    for (int i = 0; i < 3; i++) {
+        auto it = board_info.find(delta_keys[i]);
+        if (it != board_info.end() && it->is_object()) _load_deltas(*it, this, delta_fields[i]);
+    }
+
+    for (auto &[_, units_info] : obs.at("units").items()) {
+        for (auto &[__, unit_info] : units_info.items()) {
+            ObsUnit *unit = &this->units.emplace_back();
+            json &cargo_info = unit_info.at("cargo");
+            unit->id = _obs_unit_id(unit_info.at("unit_id"));
+            unit->team_id = unit_info.at("team_id");
+            unit->x = unit_info.at("pos").at(0);
+            unit->y = unit_info.at("pos").at(1);
+            unit->heavy = (unit_info.at("unit_type").get<string>().at(0) == 'H');
+            unit->ice = cargo_info.at("ice");
+            unit->ore = cargo_info.at("ore");
+            unit->water = cargo_info.at("water");
+            unit->metal = cargo_info.at("metal");
+            unit->power = unit_info.at("power");
+            unit->aq_len = 0;
+            for (auto &a_json : unit_info.at("action_queue")) {
+                LUX_ASSERT(unit->aq_len < UNIT_ACTION_QUEUE_SIZE);
+                ActionSpec *spec = &unit->aq[unit->aq_len++];
+                spec->action = a_json.at(0);
+                spec->direction = a_json.at(1);
+                spec->resource = a_json.at(2);
+                spec->amount = a_json.at(3);
+                spec->repeat = a_json.at(4);
+                spec->n = a_json.at(5);
+            }
+        }
+    }
+
+    for (auto &[_, factories_info] : obs.at("factories").items()) {
+        for (auto &[__, factory_info] : factories_info.items()) {
+            ObsFactory *factory = &this->factories.emplace_back();
+            json &cargo_info = factory_info.at("cargo");
+            factory->id = factory_info.at("strain_id");
+            factory->team_id = factory_info.at("team_id");
+            factory->x = factory_info.at("pos").at(0);
+            factory->y = factory_info.at("pos").at(1);
+            factory->ice = cargo_info.at("ice");
+            factory->ore = cargo_info.at("ore");
+            factory->water = cargo_info.at("water");
+            factory->metal = cargo_info.at("metal");
+            factory->power = factory_info.at("power");
+        }
+    }
+}
+
+bool Observation::parse_binary(const string &payload) {
+    return this->parse_binary(payload.data(), payload.size());
+}
+
+bool Observation::parse_binary(const char *data, size_t len) {
+    this->clear();
+    WireReader r{.pos = data, .end = data + len, .ok = true};
+
+    this->step = r.get<int32_t>();
+    this->remainingOverageTime = r.get<int32_t>();
+    this->real_env_steps = r.get<int32_t>();
+    this->player = (r.get<int8_t>() == 0 ? "player_0" : "player_1");
+    this->factories_per_team = r.get<int32_t>();
+
+    for (ObsTeam &team : this->teams) {
+        if (!r.get<int8_t>()) continue;
+        team.water = r.get<int32_t>();
+        team.metal = r.get<int32_t>();
+        team.place_first = r.get<int8_t>();
+        uint8_t strain_count = r.get<uint8_t>();
+        for (int i = 0; i < strain_count; i++) team.factory_strains.push_back(r.get<int16_t>());
+    }
+
+    uint8_t plane_flags = r.get<uint8_t>();
+    bool *has_planes[] = { &this->has_ice, &this->has_ore, &this->has_rubble, &this->has_valid_spawns_mask };
+    int8_t *planes[] = { this->ice, this->ore, this->rubble, this->valid_spawns_mask };
+    for (int i = 0; i < 4; i++) {
+        if (!(plane_flags & (1 << i))) continue;
+        const char *plane = r.take(SIZE2);
+        if (!plane) return false;
+        memcpy(planes[i], plane, SIZE2);
+        *has_planes[i] = true;
+    }
+
+    uint16_t delta_count = r.get<uint16_t>();
+    for (int i = 0; i < delta_count && r.ok; i++) {
+        int16_t cell_id = r.get<int16_t>();
+        int8_t fields = r.get<int8_t>();
+        int8_t _rubble = r.get<int8_t>();
+        int8_t _lichen = r.get<int8_t>();
+        int8_t _lichen_strain = r.get<int8_t>();
+        if (cell_id < 0 || cell_id >= SIZE2) return false;
+        if (fields & CellDelta_RUBBLE) this->add_cell_delta(cell_id, CellDelta_RUBBLE, _rubble);
+        if (fields & CellDelta_LICHEN) this->add_cell_delta(cell_id, CellDelta_LICHEN, _lichen);
+        if (fields & CellDelta_LICHEN_STRAIN) this->add_cell_delta(cell_id, CellDelta_LICHEN_STRAIN, _lichen_strain);
+    }
+
+    uint16_t unit_count = r.get<uint16_t>();
+    this->units.resize(unit_count);
+    for (ObsUnit &unit : this->units) {
+        unit.id = r.get<int16_t>();
+        unit.team_id = r.get<int8_t>();
+        unit.heavy = r.get<int8_t>();
+        unit.x = r.get<int16_t>();
+        unit.y = r.get<int16_t>();
+        unit.ice = r.get<int32_t>();
+        unit.ore = r.get<int32_t>();
+        unit.water = r.get<int32_t>();
+        unit.metal = r.get<int32_t>();
+        unit.power = r.get<int32_t>();
+        unit.aq_len = r.get<uint8_t>();
+        if (unit.aq_len > UNIT_ACTION_QUEUE_SIZE) return false;
+        for (int i = 0; i < unit.aq_len; i++) {
+            ActionSpec *spec = &unit.aq[i];
+            spec->action = (UnitAction)r.get<int8_t>();
+            spec->direction = (Direction)r.get<int8_t>();
+            spec->resource = (Resource)r.get<int8_t>();
+            spec->amount = r.get<int16_t>();
+            spec->repeat = r.get<int16_t>();
+            spec->n = r.get<int16_t>();
+        }
+        if (!r.ok) return false;
+    }
+
+    uint16_t factory_count = r.get<uint16_t>();
+    this->factories.resize(factory_count);
+    for (ObsFactory &factory : this->factories) {
+        factory.id = r.get<int16_t>();
+        factory.team_id = r.get<int8_t>();
+        factory.x = r.get<int16_t>();
+        factory.y = r.get<int16_t>();
+        factory.ice = r.get<int32_t>();
+        factory.ore = r.get<int32_t>();
+        factory.water = r.get<int32_t>();
+        factory.metal = r.get<int32_t>();
+        factory.power = r.get<int32_t>();
+    }
+
+    return r.ok && r.pos == r.end;
+}
+
+void Observation::write_binary(string *payload, bool static_planes) {
+    wire_put<int32_t>(payload, this->step);
+    wire_put<int32_t>(payload, this->remainingOverageTime);
+    wire_put<int32_t>(payload, this->real_env_steps);
+    wire_put<int8_t>(payload, this->player == "player_0" ? 0 : 1);
+    wire_put<int32_t>(payload, this->factories_per_team);
+
+    for (ObsTeam &team : this->teams) {
+        // Teams are absent during bidding; absent and default-valued teams decode identically
+        wire_put<int8_t>(payload, 1);
+        wire_put<int32_t>(payload, team.water);
+        wire_put<int32_t>(payload, team.metal);
+        wire_put<int8_t>(payload, team.place_first);
+        wire_put<uint8_t>(payload, team.factory_strains.size());
+        for (int strain : team.factory_strains) wire_put<int16_t>(payload, strain);
+    }
+
+    bool has_planes[] = { this->has_ice, this->has_ore, this->has_rubble, this->has_valid_spawns_mask };
+    int8_t *planes[] = { this->ice, this->ore, this->rubble, this->valid_spawns_mask };
+    uint8_t plane_flags = 0;
+    for (int i = 0; i < 4; i++) {
+        // valid_spawns_mask changes between placement steps, the others are only needed once
+        if (has_planes[i] && (static_planes || i == 3)) plane_flags |= (1 << i);
+    }
+    wire_put<uint8_t>(payload, plane_flags);
+    for (int i = 0; i < 4; i++) {
+        if (plane_flags & (1 << i)) payload->append(reinterpret_cast<const char*>(planes[i]), SIZE2);
+    }
+
+    wire_put<uint16_t>(payload, this->cell_deltas.size());
+    for (ObsCellDelta &delta : this->cell_deltas) {
+        wire_put<int16_t>(payload, delta.cell_id);
+        wire_put<int8_t>(payload, delta.fields);
+        wire_put<int8_t>(payload, delta.rubble);
+        wire_put<int8_t>(payload, delta.lichen);
+        wire_put<int8_t>(payload, delta.lichen_strain);
+    }
+
+    wire_put<uint16_t>(payload, this->units.size());
+    for (ObsUnit &unit : this->units) {
+        wire_put<int16_t>(payload, unit.id);
+        wire_put<int8_t>(payload, unit.team_id);
+        wire_put<int8_t>(payload, unit.heavy);
+        wire_put<int16_t>(payload, unit.x);
+        wire_put<int16_t>(payload, unit.y);
+        wire_put<int32_t>(payload, unit.ice);
+        wire_put<int32_t>(payload, unit.ore);
+        wire_put<int32_t>(payload, unit.water);
+        wire_put<int32_t>(payload, unit.metal);
+        wire_put<int32_t>(payload, unit.power);
+        wire_put<uint8_t>(payload, unit.aq_len);
+        for (int i = 0; i < unit.aq_len; i++) {
+            ActionSpec *spec = &unit.aq[i];
+            wire_put<int8_t>(payload, spec->action);
+            wire_put<int8_t>(payload, spec->direction);
+            wire_put<int8_t>(payload, spec->resource);
+            wire_put<int16_t>(payload, spec->amount);
+            wire_put<int16_t>(payload, spec->repeat);
+            wire_put<int16_t>(payload, spec->n);
+        }
+    }
+
+    wire_put<uint16_t>(payload, this->factories.size());
+    for (ObsFactory &factory : this->factories) {
+        wire_put<int16_t>(payload, factory.id);
+        wire_put<int8_t>(payload, factory.team_id);
+        wire_put<int16_t>(payload, factory.x);
+        wire_put<int16_t>(payload, factory.y);
+        wire_put<int32_t>(payload, factory.ice);
+        wire_put<int32_t>(payload, factory.ore);
+        wire_put<int32_t>(payload, factory.water);
+        wire_put<int32_t>(payload, factory.metal);
+        wire_put<int32_t>(payload, factory.power);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lux/action.hpp"
+#include "lux/defs.hpp"
+#include "lux/json.hpp"
+
+
+typedef enum CellDeltaField : int8_t {
+    CellDelta_RUBBLE = 1,
+    CellDelta_LICHEN = 2,
+    CellDelta_LICHEN_STRAIN = 4,
+} CellDeltaField;
+
+// All diffs for one cell, merged from the separate rubble/lichen/lichen_strains maps
+typedef struct ObsCellDelta {
+    int16_t cell_id;
+    int8_t fields;  // CellDeltaField bits
+    int8_t rubble;
+    int8_t lichen;
+    int8_t lichen_strain;
+} ObsCellDelta;
+
+typedef struct ObsTeam {
+    int water;
+    int metal;
+    bool place_first;
+    std::vector<int> factory_strains;
+} ObsTeam;
+
+typedef struct ObsUnit {
+    int16_t id;
+    int8_t team_id;
+    int16_t x;
+    int16_t y;
+    bool heavy;
+    int ice;
+    int ore;
+    int water;
+    int metal;
+    int power;
+    int8_t aq_len;
+    ActionSpec aq[UNIT_ACTION_QUEUE_SIZE];
+} ObsUnit;
+
+typedef struct ObsFactory {
+    int16_t id;  // strain_id
+    int8_t team_id;
+    int16_t x;
+    int16_t y;
+    int ice;
+    int ore;
+    int water;
+    int metal;
+    int power;
+} ObsFactory;
+
+// Flat staging area for one turn of input. The runner sends "step"/"player" after the obs body and
+// "real_env_steps" after "units", so values are collected here first and applied by Board::init.
+typedef struct Observation {
+    int64_t step;
+    int64_t remainingOverageTime;
+    std::string player;
+    int real_env_steps;
+    int factories_per_team;
+    ObsTeam teams[2];
+
+    // Full planes (indexed by cell id), only sent for bidding/placement steps
+    bool has_ice;
+    bool has_ore;
+    bool has_rubble;
+    bool has_valid_spawns_mask;
+    int8_t ice[SIZE2];
+    int8_t ore[SIZE2];
+    int8_t rubble[SIZE2];
+    int8_t valid_spawns_mask[SIZE2];
+
+    // Sparse "x,y"-keyed diffs sent every real step, one record per changed cell
+    std::vector<ObsCellDelta> cell_deltas;
+    int16_t _cell_delta_index[SIZE2];  // sparse set: only valid if it points back to the same cell
+
+    std::vector<ObsUnit> units;
+    std::vector<ObsFactory> factories;
+
+    double parse_time;
+
+    // ~~~ Methods:
+
+    void clear();
+    void add_cell_delta(int16_t cell_id, CellDeltaField field, int value);
+    bool parse(const std::string &line);  // streaming (SAX), returns false on unexpected input
+    bool parse_binary(const std::string &payload);  // --binary frames, see lux/wire.hpp
+    bool parse_binary(const char *data, size_t len);
+    void write_binary(std::string *payload, bool static_planes = true);  // inverse of parse_binary
+    void load_json(json &input);  // DOM fallback
+} Observation;
+
+bool parse_cell_key(const char *key, size_t len, int16_t *x, int16_t *y);  // "x,y" without allocating
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <algorithm>  // fill_n, push_heap, pop_heap, reverse, sort
+#include <climits>
+#include <queue>  // priority_queue
+#include <type_traits>  // conditional_t, is_same_v, is_constructible_v
+#include <utility>  // make_pair
+#include <vector>
+
+#include "lux/board.hpp"
+#include "lux/cell.hpp"
+#include "lux/defs.hpp"
+#include "lux/exception.hpp"
+#include "lux/factory.hpp"
+#include "lux/search_workspace.hpp"
+#include "lux/unit.hpp"
+
+
+// PathNone is never set, std::function may be empty, lambdas are always set
+template <typename F>
+inline bool _path_has(F const& f) {
+    if constexpr (std::is_same_v<F, PathNone>) { (void)f; return false; }
+    else if constexpr (std::is_constructible_v<bool, F const&>) return static_cast<bool>(f);
+    else { (void)f; return true; }
+}
+
+template <typename F>
+inline bool _path_test(F const& f, Cell *cell) {
+    if constexpr (std::is_same_v<F, PathNone>) { (void)f; (void)cell; return false; }
+    else return f(cell);
+}
+
+template <typename F>
+inline int _path_cost(F const& f, Cell *cell, Unit *unit) {
+    if constexpr (std::is_same_v<F, PathNone>) { (void)f; (void)cell; (void)unit; return 0; }
+    else return f(cell, unit);
+}
+
+// ~~~ Open lists for pathfind_t, see PathQueue. Entries are (f = cost + heuristic, g = cost, cell id); pop
+// returns the min by (f, g, id) and leaves skipping outdated duplicates to the caller.
+
+typedef struct PathHeapQueue {
+    std::priority_queue<PIII, std::vector<PIII>, std::greater<PIII> > heap;
+
+    // ~~~ Methods:
+
+    inline void push(int f, int g, int id) { this->heap.push(std::make_pair(std::make_pair(f, g), id)); }
+    inline bool pop(int *g, int *id) {
+        if (this->heap.empty()) return false;
+        *g = this->heap.top().first.second;
+        *id = this->heap.top().second;
+        this->heap.pop();
+        return true;
+    }
+} PathHeapQueue;
+
+#define PATH_BUCKETS 256  // ring window of f values, power of 2; costlier steps go through overflow
+
+typedef struct PathBucketEntry {
+    int g;
+    int16_t id;
+    int next;  // next entry index in the same bucket, -1 at end
+} PathBucketEntry;
+
+// f only grows with non-negative costs and a consistent heuristic, so buckets are drained in ring order.
+// Within the current bucket a small (g, id) heap keeps the pop order identical to PathHeapQueue.
+typedef struct PathBucketQueue {
+    int head[PATH_BUCKETS];  // first entry per bucket of the window [cur_f, cur_f + PATH_BUCKETS), -1 if empty
+    std::vector<PathBucketEntry> entries;
+    std::vector<PII> cur;  // (g, id) of bucket cur_f, min-heap
+    std::vector<PIII> overflow;  // beyond the window or pushed before the first pop
+    int overflow_min;
+    int cur_f;
+    int ring_count;
+    bool started;
+
+    // ~~~ Methods:
+
+    PathBucketQueue() : overflow_min(INT_MAX), cur_f(0), ring_count(0), started(false) {
+        std::fill_n(this->head, PATH_BUCKETS, -1);
+    }
+
+    inline void push(int f, int g, int id) {
+        if (this->started && f <= this->cur_f) {
+            this->cur.push_back(std::make_pair(g, id));
+            std::push_heap(this->cur.begin(), this->cur.end(), std::greater<PII>());
+        } else if (this->started && f < this->cur_f + PATH_BUCKETS) {
+            this->_push_ring(f, g, id);
+        } else {
+            this->overflow.push_back(std::make_pair(std::make_pair(f, g), id));
+            this->overflow_min = MIN(this->overflow_min, f);
+        }
+    }
+
+    inline bool pop(int *g, int *id) {
+        while (this->cur.empty()) {
+            if (this->ring_count > 0) this->cur_f += 1;
+            else if (!this->overflow.empty()) this->cur_f = this->overflow_min;
+            else return false;
+            this->started = true;
+            this->_load_bucket();
+        }
+        std::pop_heap(this->cur.begin(), this->cur.end(), std::greater<PII>());
+        *g = this->cur.back().first;
+        *id = this->cur.back().second;
+        this->cur.pop_back();
+        return true;
+    }
+
+    inline void _push_ring(int f, int g, int id) {
+        int &bucket = this->head[f & (PATH_BUCKETS - 1)];
+        this->entries.push_back({.g = g, .id = (int16_t)id, .next = bucket});
+        bucket = this->entries.size() - 1;
+        this->ring_count += 1;
+    }
+
+    // Moves bucket cur_f (plus any overflow now inside the window) into the cur heap
+    void _load_bucket() {
+        if (this->overflow_min == this->cur_f) {
+            int new_min = INT_MAX;
+            size_t kept = 0;
+            for (size_t i = 0; i < this->overflow.size(); i++) {
+                PIII &item = this->overflow[i];
+                if (item.first.first < this->cur_f + PATH_BUCKETS) {
+                    this->_push_ring(MAX(item.first.first, this->cur_f), item.first.second, item.second);
+                } else {
+                    new_min = MIN(new_min, item.first.first);
+                    this->overflow[kept++] = item;
+                }
+            }
+            this->overflow.resize(kept);
+            this->overflow_min = new_min;
+        }
+        int &bucket = this->head[this->cur_f & (PATH_BUCKETS - 1)];
+        for (int i = bucket; i != -1; i = this->entries[i].next) {
+            this->cur.push_back(std::make_pair(this->entries[i].g, this->entries[i].id));
+            this->ring_count -= 1;
+        }
+        bucket = -1;
+        std::make_heap(this->cur.begin(), this->cur.end(), std::greater<PII>());
+    }
+} PathBucketQueue;
+
+// Unit costs: every push while expanding layer g is for layer g + 1, so a layer sorted by id is the heap order
+typedef struct PathBfsQueue {
+    std::vector<int16_t> cur;
+    std::vector<int16_t> next;
+    size_t pos;
+    int cur_g;
+    int next_g;
+
+    // ~~~ Methods:
+
+    PathBfsQueue() : pos(0), cur_g(0), next_g(0) {}
+
+    inline void push(int f, int g, int id) {
+        (void)f;
+        LUX_ASSERT(this->next.empty() || g == this->next_g);
+        this->next_g = g;
+        this->next.push_back(id);
+    }
+
+    inline bool pop(int *g, int *id) {
+        if (this->pos == this->cur.size()) {
+            if (this->next.empty()) return false;
+            this->cur.swap(this->next);
+            this->next.clear();
+            std::sort(this->cur.begin(), this->cur.end());
+            this->pos = 0;
+            this->cur_g = this->next_g;
+        }
+        *g = this->cur_g;
+        *id = this->cur[this->pos++];
+        return true;
+    }
+} PathBfsQueue;
+
+// Note: Always check or assert that return value is not INT_MAX
+template <PathQueue Queue, typename DestCond, typename AvoidCond, typename CustomCost>
+int Board::pathfind_t(Unit *unit, Cell *src, Cell *dest_cell,
+                      DestCond const& dest_cond,
+                      AvoidCond const& avoid_cond,
+                      CustomCost const& custom_cost,
+                      std::vector<Cell*> *route,
+                      int max_dist,
+                      std::vector<Cell*> *src_cells,
+                      SearchWorkspace *workspace) {
+    bool const has_dest_cond = _path_has(dest_cond);
+    bool const has_avoid_cond = _path_has(avoid_cond);
+    bool const has_custom_cost = _path_has(custom_cost);
+    LUX_ASSERT(dest_cell || has_dest_cond);
+
+    SearchScope scope(workspace);
+    scope.ws->begin();
+    CellPathInfo *const path_info = scope.ws->path_info;
+    int const call_id = scope.ws->call_id;
+    int const move_cost = (unit == NULL ? 20 : unit->cfg->MOVE_COST);
+    double const rubble_movement_cost = (unit == NULL ? 1 : unit->cfg->RUBBLE_MOVEMENT_COST);
+    bool const a_star = (dest_cell && !has_custom_cost);
+    bool const random_ties = this->_pathfind_random_ties(unit);
+    Factory *const dest_factory = ((dest_cell && dest_cell->factory_center) ? dest_cell->factory() : NULL);
+    Factory *const implied_factory = (has_dest_cond ? NULL : dest_factory);
+
+    int cost = 0;
+    int f = 0;
+    std::conditional_t<Queue == PathQueue_BFS, PathBfsQueue,
+                       std::conditional_t<Queue == PathQueue_BUCKET, PathBucketQueue, PathHeapQueue> > queue;
+    if (src_cells) {
+        LUX_ASSERT(!src);
+        LUX_ASSERT(!src_cells->empty());
+        for (Cell *scell : *src_cells) {
+            f = cost + (a_star ? move_cost * scell->man_dist(dest_cell) : 0);
+            path_info[scell->id] = {
+                .cost = cost,
+                .dist = 0,
+                .prev_cell = NULL,
+                .call_id = call_id};
+            queue.push(f, cost, scell->id);
+        }
+    } else if (!unit && src->factory_center) {
+        // If src is a factory_center, start from outer factory cells
+        for (Cell *fcell : src->factory()->cells) {
+            f = cost + (a_star ? move_cost * fcell->man_dist(dest_cell) : 0);
+            path_info[fcell->id] = {
+                .cost = cost,
+                .dist = 0,
+                .prev_cell = NULL,
+                .call_id = call_id};
+            queue.push(f, cost, fcell->id);
+        }
+    } else {
+        f = cost + (a_star ? move_cost * src->man_dist(dest_cell) : 0);
+        path_info[src->id] = {
+            .cost = cost,
+            .dist = 0,
+            .prev_cell = NULL,
+            .call_id = call_id};
+        queue.push(f, cost, src->id);
+    }
+
+    int g, id;
+    while (queue.pop(&g, &id)) {
+        Cell *cell = &this->cells[id];
+        CellPathInfo &info = path_info[id];
+        if (g > info.cost) continue;  // outdated duplicate
+
+        // Check for terminal condition
+        if (cell == dest_cell
+            || (has_dest_cond && _path_test(dest_cond, cell))
+            || (implied_factory  // Implied-factory destination
+                && cell->factory() == implied_factory
+                && ((unit && unit->player == this->opp)
+                    || !cell->assigned_unit
+                    || cell->assigned_unit == unit))) {
+            cost = info.cost;
+            if (route) {
+                route->clear();
+                while (cell) {
+                    route->push_back(cell);
+                    cell = path_info[cell->id].prev_cell;
+                }
+                std::reverse(route->begin(), route->end());
+            }
+            return cost;
+        }
+
+        // Check for distance limit
+        if (info.dist >= max_dist) continue;
+
+        // Check if cell cannot be passed through
+        //  - src can always be passed through
+        //  - Always avoid opp factory cells
+        if (info.cost
+            && ((has_avoid_cond && _path_test(avoid_cond, cell))
+                || (unit && cell->opp_factory(unit->player)))) continue;
+
+        // Don't wander through factory when implied-factory destination
+        if (info.cost && !has_avoid_cond
+            && dest_factory && cell->factory() == dest_factory) continue;
+
+        // Update neighbors
+        for (Cell *new_cell : cell->neighbors) {
+            // Init new_cell if first time this invocation
+            CellPathInfo &new_info = path_info[new_cell->id];
+            if (new_info.call_id != call_id) {
+                new_info = {
+                    .cost = INT_MAX,
+                    .dist = INT_MAX,
+                    .prev_cell = NULL,
+                    .call_id = call_id};
+            }
+
+            if (has_custom_cost) cost = info.cost + _path_cost(custom_cost, new_cell, unit);
+            else cost = (info.cost
+                         + move_cost
+                         + static_cast<int>(rubble_movement_cost * new_cell->rubble()));
+            if (cost < new_info.cost) {
+                new_info.cost = cost;
+                new_info.dist = info.dist + 1;
+                new_info.prev_cell = cell;
+                f = cost + (a_star ? move_cost * new_cell->man_dist(dest_cell) : 0);
+                queue.push(f, cost, new_cell->id);
+            } else if (cost == new_info.cost
+                       && random_ties
+                       && prandom(this->sim_step + cell->id + new_cell->id + (unit ? unit->id : 0), 0.5)) {
+                new_info.dist = info.dist + 1;
+                new_info.prev_cell = cell;
+            }
+        }
+    }
+
+    return INT_MAX;
+}
@@ -7,6 +7,7 @@
 #include "lux/json.hpp"
 
 
+struct ActionWriter;
 struct Cell;
 struct Factory;
 struct Team;
@@ -26,11 +27,12 @@ typedef struct Player {
 
     // ~~~ Methods:
 
-    void init(struct Team *team, bool is_player0, json &strains_info);
+    void init(struct Team *team, bool is_player0, const std::vector<int> &strains_info);
     std::list<struct Unit*> &units();
     std::list<struct Factory*> &factories();
     void add_new_units();
     inline bool is_strain(int strain_id) { return (strain_id >= 0
                                                    && (this->strains & (1 << strain_id))); }
-    void get_new_actions(json *actions);
+    bool _prepare_new_action_queue(struct Unit *unit);
+    void get_new_actions(struct ActionWriter *writer);
 } Player;
@@ -22,7 +22,7 @@ Role::Role(Unit *_unit, char goal_type) {
 bool Role::_goal_is_factory() {
     return (this->goal_type == 'f'
             || (this->goal_type == 'c'
-                && static_cast<Cell*>(this->goal)->factory == this->get_factory()));
+                && static_cast<Cell*>(this->goal)->factory() == this->get_factory()));
 }
 
 void Role::_displace_unit(Unit *_unit) {
@@ -52,8 +52,8 @@ bool Role::_do_move(Cell *_goal_cell, bool allow_no_move) {
     Cell *goal_cell = _goal_cell ? _goal_cell : this->goal_cell();
 
     bool at_destination = (cur_cell == goal_cell
-                           || (goal_cell->factory_center && goal_cell->factory == cur_cell->factory));
-    bool need_to_move = !at_destination || cur_cell->unit_next;
+                           || (goal_cell->factory_center && goal_cell->factory() == cur_cell->factory()));
+    bool need_to_move = !at_destination || cur_cell->unit_next();
     if (need_to_move || allow_no_move) {
         //if (this->unit->_log_cond()) LUX_LOG("Role::do_move A");
         Direction direction = this->unit->move_direction(goal_cell);
@@ -113,7 +113,7 @@ bool Role::_do_move_attack_trapped_unit() {
                 vector<Cell*> unique_move_options;
                 vector<Cell*> shared_move_options;
                 for (Cell *neighbor : cur_cell->neighbors) {
-                    if (neighbor->factory) continue;  // can't/don't need to move onto factory
+                    if (neighbor->factory()) continue;  // can't/don't need to move onto factory
                     if (neighbor->man_dist(rc) == 1) {
                         // Check if other own unit _already_ has moved here
                         // Ensure we have enough power to beat opp unit (and no other risk)
@@ -143,7 +143,7 @@ bool Role::_do_move_attack_trapped_unit() {
                 vector<Cell*> &move_options = (
                     !unique_move_options.empty() ? unique_move_options : shared_move_options);
                 if (!move_options.empty()) {
-                    int idx = prandom_index(board.sim_step + this->unit->id, move_options.size());
+                    int idx = prandom_index(board().sim_step + this->unit->id, move_options.size());
                     LUX_ASSERT(0 <= idx && idx < move_options.size());
 
                     if (this->_do_move_direct(move_options[idx])) {
@@ -224,7 +224,7 @@ bool Role::_do_power_pickup(int max_amount, bool goal_is_factory_override, Facto
     }
 
     Cell *cur_cell = this->unit->cell();
-    Factory *factory = cur_cell->factory;
+    Factory *factory = cur_cell->factory();
     if (cur_cell->factory_center
         || !factory
         || (factory != this->get_factory()
@@ -261,20 +261,20 @@ bool Role::_do_move_998() {
     Cell *cur_cell = this->unit->cell();
 
     if (this->unit->power < this->unit->cfg->RAZE_COST) {
-        if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 A");
+        if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 A");
         return this->_do_move_999();
     } else if (this->unit->power < this->unit->cfg->MOVE_COST + this->unit->cfg->RAZE_COST) {
-        if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 B");
+        if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 B");
         return (this->_do_dig_999() || this->_do_move_999());
     }
 
     Cell *best_cell = NULL;
     int best_score = INT_MIN;
     for (Cell *move_cell : cur_cell->neighbors_plus) {
-        if (move_cell->lichen > 0
-            && board.opp->is_strain(move_cell->lichen_strain)
+        if (move_cell->lichen() > 0
+            && board().opp->is_strain(move_cell->lichen_strain())
             && this->unit->power >= this->unit->move_cost(move_cell) + this->unit->cfg->RAZE_COST) {
-            int score = move_cell->lichen;
+            int score = move_cell->lichen();
             if (score > best_score) {
                 best_score = score;
                 best_cell = move_cell;
@@ -284,11 +284,11 @@ bool Role::_do_move_998() {
 
     if (best_cell) {
         if (best_cell == cur_cell) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 C " << best_score);
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 C " << best_score);
             return this->_do_dig_999();
         }
 
-        if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 D " << best_score);
+        if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move998 D " << best_score);
         Direction direction = cur_cell->neighbor_to_direction(best_cell);
         this->unit->do_move(direction);
         return true;
@@ -303,26 +303,26 @@ bool Role::_do_move_999() {
     // I can move, but cannot raze here. Try to crash!
     if (this->unit->power >= this->unit->cfg->MOVE_COST
         && (this->unit->power < this->unit->cfg->RAZE_COST
-            || cur_cell->lichen <= 0
-            || board.player->is_strain(cur_cell->lichen_strain))) {
+            || cur_cell->lichen() <= 0
+            || board().player->is_strain(cur_cell->lichen_strain()))) {
         Cell *best_cell = NULL;
         int best_score = INT_MIN;
         for (Cell *move_cell : cur_cell->neighbors_plus) {
             if (this->unit->power < this->unit->move_cost(move_cell)) continue;
 
             int score = INT_MIN;
-            if (move_cell->lichen > 0 && board.opp->is_strain(move_cell->lichen_strain)) {
-                if (move_cell->unit_next
-                    || (move_cell->unit && move_cell->unit->power < move_cell->unit->cfg->MOVE_COST)) {
-                    score = 1 + move_cell->lichen;
+            if (move_cell->lichen() > 0 && board().opp->is_strain(move_cell->lichen_strain())) {
+                if (move_cell->unit_next()
+                    || (move_cell->unit() && move_cell->unit()->power < move_cell->unit()->cfg->MOVE_COST)) {
+                    score = 1 + move_cell->lichen();
                 } else if (this->unit->move_risk(move_cell, NULL, /*all_collisions*/true)) {
-                    score = 1 + move_cell->lichen / 3;
+                    score = 1 + move_cell->lichen() / 3;
                 } else if (move_cell->opp_unit()) {
-                    score = 1 + move_cell->lichen / 10;
-                } else if (move_cell->unit
-                           && move_cell->unit->power < move_cell->unit->cfg->RAZE_COST
-                           && !move_cell->unit->cell_next()) {
-                    score = 1 + move_cell->lichen / 3;
+                    score = 1 + move_cell->lichen() / 10;
+                } else if (move_cell->unit()
+                           && move_cell->unit()->power < move_cell->unit()->cfg->RAZE_COST
+                           && !move_cell->unit()->cell_next()) {
+                    score = 1 + move_cell->lichen() / 3;
                 } else {
                     score = 0;
                 }
@@ -333,7 +333,7 @@ bool Role::_do_move_999() {
             }
         }
         if (best_cell) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move999 A " << best_score);
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move999 A " << best_score);
             Direction direction = cur_cell->neighbor_to_direction(best_cell);
             this->unit->do_move(direction);
             return true;
@@ -341,32 +341,32 @@ bool Role::_do_move_999() {
     }
 
     // No lichen here, just chill
-    if (cur_cell->lichen <= 0) {
+    if (cur_cell->lichen() <= 0) {
         this->unit->do_move(Direction_CENTER, /*no_move*/true);
         return true;
     }
 
     // On own lichen, find lowest risk move
     if (this->unit->power >= this->unit->cfg->MOVE_COST
-        && cur_cell->lichen > 0
-        && board.player->is_strain(cur_cell->lichen_strain)) {
+        && cur_cell->lichen() > 0
+        && board().player->is_strain(cur_cell->lichen_strain())) {
         Cell *best_cell = NULL;
         int best_score = INT_MAX;
         for (Cell *move_cell : cur_cell->neighbors_plus) {
             if (this->unit->power < this->unit->move_cost(move_cell)) continue;
 
             int score = 0;
-            if (move_cell->lichen <= 0
-                || board.opp->is_strain(move_cell->lichen_strain)) {
+            if (move_cell->lichen() <= 0
+                || board().opp->is_strain(move_cell->lichen_strain())) {
                 score = -100;
-            } else if (move_cell->unit_next
-                       || (move_cell->unit
-                           && move_cell->unit->power < move_cell->unit->cfg->MOVE_COST)) {
-                score = 1 + move_cell->lichen;
+            } else if (move_cell->unit_next()
+                       || (move_cell->unit()
+                           && move_cell->unit()->power < move_cell->unit()->cfg->MOVE_COST)) {
+                score = 1 + move_cell->lichen();
             } else if (this->unit->move_risk(move_cell, NULL, /*all_collisions*/true)) {
-                score = 1 + move_cell->lichen / 3;
+                score = 1 + move_cell->lichen() / 3;
             } else if (move_cell->opp_unit()) {
-                score = 1 + move_cell->lichen / 3;
+                score = 1 + move_cell->lichen() / 3;
             } else if (move_cell == cur_cell) {
                 score = -1;
             }
@@ -377,7 +377,7 @@ bool Role::_do_move_999() {
             }
         }
         if (best_cell) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move999 B " << best_score);
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " move999 B " << best_score);
             Direction direction = cur_cell->neighbor_to_direction(best_cell);
             this->unit->do_move(direction);
             return true;
@@ -390,30 +390,30 @@ bool Role::_do_move_999() {
 bool Role::_do_dig_999() {
     Cell *cur_cell = this->unit->cell();
 
-    if (cur_cell->lichen > 0
-        && board.opp->is_strain(cur_cell->lichen_strain)) {
+    if (cur_cell->lichen() > 0
+        && board().opp->is_strain(cur_cell->lichen_strain())) {
         if (this->unit->power >= this->unit->self_destruct_cost()) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " dig999 A");
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " dig999 A");
             this->unit->do_self_destruct();
             return true;
         } else if (this->unit->power >= this->unit->dig_cost()) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " dig999 B");
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " dig999 B");
             this->unit->do_dig();
             return true;
         }
     }
 
-    if (cur_cell->rubble > 0
-        && cur_cell->rubble <= this->unit->cfg->DIG_RUBBLE_REMOVED) {
+    if (cur_cell->rubble() > 0
+        && cur_cell->rubble() <= this->unit->cfg->DIG_RUBBLE_REMOVED) {
         bool lichen_adj = false;
         for (Cell *neighbor : cur_cell->neighbors) {
-            if (neighbor->lichen >= MIN_LICHEN_TO_SPREAD
-                && board.player->is_strain(neighbor->lichen_strain)) lichen_adj = true;
+            if (neighbor->lichen() >= MIN_LICHEN_TO_SPREAD
+                && board().player->is_strain(neighbor->lichen_strain())) lichen_adj = true;
             if (neighbor->own_factory()) lichen_adj = true;
         }
         if (lichen_adj
             && this->unit->power >= this->unit->dig_cost()) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " dig999 C");
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *cur_cell << " dig999 C");
             this->unit->do_dig();
             return true;
         }
@@ -424,7 +424,7 @@ bool Role::_do_dig_999() {
 
 bool Role::_do_move_to_exploding_factory() {
     Cell *cur_cell = this->unit->cell();
-    Factory *factory = cur_cell->nearest_factory(board.player);
+    Factory *factory = cur_cell->nearest_factory(board().player);
 
     if (!factory
         || cur_cell->man_dist_factory(factory) > 1
@@ -454,21 +454,21 @@ bool Role::_do_move_to_exploding_factory() {
     Cell *best_cell = NULL;
     int best_score = INT_MIN;
     for (Cell *move_cell : cur_cell->neighbors_plus) {
-        if (move_cell->factory
+        if (move_cell->factory()
             && this->unit->power >= this->unit->move_cost(move_cell)
             && this->unit->move_is_safe_from_friendly_fire(move_cell)) {
             int score = 0;
-            if (move_cell->unit
-                && move_cell->unit != this->unit
-                && !move_cell->unit->cell_next()) score -= 2;
+            if (move_cell->unit()
+                && move_cell->unit() != this->unit
+                && !move_cell->unit()->cell_next()) score -= 2;
             if (move_cell->factory_center
                 && factory->metal >= 10) score -= 2;
             for (Cell *neighbor : move_cell->neighbors) {
-                if (neighbor->unit
-                    && neighbor->unit != this->unit
-                    && !neighbor->unit->cell_next()) score -= 1;
+                if (neighbor->unit()
+                    && neighbor->unit() != this->unit
+                    && !neighbor->unit()->cell_next()) score -= 1;
             }
-            //if (board.sim0()) LUX_LOG(*this->unit << " move to exploding " << *move_cell
+            //if (board().sim0()) LUX_LOG(*this->unit << " move to exploding " << *move_cell
             //                          << ' ' << score);
             if (score > best_score) {
                 best_score = score;
@@ -478,7 +478,7 @@ bool Role::_do_move_to_exploding_factory() {
     }
 
     if (best_cell) {
-        if (board.sim0()) LUX_LOG(*this->unit << " move to exploding " << *factory);
+        if (board().sim0()) LUX_LOG(*this->unit << " move to exploding " << *factory);
         Direction direction = cur_cell->neighbor_to_direction(best_cell);
         this->unit->do_move(direction);
         return true;
@@ -488,7 +488,7 @@ bool Role::_do_move_to_exploding_factory() {
 }
 
 bool Role::_do_pickup_resource_from_exploding_factory() {
-    Factory *factory = this->unit->cell()->factory;
+    Factory *factory = this->unit->cell()->factory();
 
     if (!factory
         || factory->water != 0
@@ -521,7 +521,7 @@ bool Role::_do_pickup_resource_from_exploding_factory() {
         }
         else if (amount > 0
             && this->unit->power >= this->unit->pickup_cost(Resource_POWER, amount)) {
-            if (board.sim0()) LUX_LOG(*this->unit << " power pickup from exploding " << *factory);
+            if (board().sim0()) LUX_LOG(*this->unit << " power pickup from exploding " << *factory);
             this->unit->do_pickup(Resource_POWER, amount);
             return true;
         }
@@ -531,7 +531,7 @@ bool Role::_do_pickup_resource_from_exploding_factory() {
                          factory->metal + factory->metal_delta);
         if (amount > 0
             && this->unit->power >= this->unit->pickup_cost(Resource_METAL, amount)) {
-            if (board.sim0()) LUX_LOG(*this->unit << " metal pickup from exploding " << *factory);
+            if (board().sim0()) LUX_LOG(*this->unit << " metal pickup from exploding " << *factory);
             this->unit->do_pickup(Resource_METAL, amount);
             return true;
         }
@@ -541,7 +541,7 @@ bool Role::_do_pickup_resource_from_exploding_factory() {
                          factory->ore + factory->ore_delta);
         if (amount > 0
             && this->unit->power >= this->unit->pickup_cost(Resource_ORE, amount)) {
-            if (board.sim0()) LUX_LOG(*this->unit << " ore pickup from exploding " << *factory);
+            if (board().sim0()) LUX_LOG(*this->unit << " ore pickup from exploding " << *factory);
             this->unit->do_pickup(Resource_ORE, amount);
             return true;
         }
@@ -552,15 +552,15 @@ bool Role::_do_pickup_resource_from_exploding_factory() {
 
 bool Role::_do_move_win_collision() {
     // assume role check already done
-    if (!board.sim0()
-        || board.step >= END_PHASE
+    if (!board().sim0()
+        || board().step >= END_PHASE
         || this->unit->power < this->unit->cfg->BATTERY_CAPACITY / 3
-        || prandom(board.sim_step + this->unit->id, 0.9)) return false;  // only do this 10% of time
+        || prandom(board().sim_step + this->unit->id, 0.9)) return false;  // only do this 10% of time
 
     Cell *cur_cell = this->unit->cell();
     for (Cell *move_cell : cur_cell->neighbors) {
-        if (move_cell->factory
-            || board.player->is_strain(move_cell->lichen_strain)) continue;
+        if (move_cell->factory()
+            || board().player->is_strain(move_cell->lichen_strain())) continue;
 
         for (Cell *neighbor : move_cell->neighbors) {
             Unit *opp_unit = neighbor->opp_unit();
@@ -594,7 +594,7 @@ bool Role::_do_move_win_collision() {
 }
 
 void Role::set() {
-    this->_set_step = 1000 * board.step + board.sim_step;
+    this->_set_step = 1000 * board().step + board().sim_step;
 }
 
 void Role::unset() {
@@ -602,5 +602,5 @@ void Role::unset() {
 }
 
 bool Role::is_set() {
-    return this->_set_step == 1000 * board.step + board.sim_step;
+    return this->_set_step == 1000 * board().step + board().sim_step;
 }
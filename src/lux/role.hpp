@@ -5,6 +5,8 @@
 #include <iostream>
 #include <vector>
 
+#include "lux/object_pool.hpp"
+
 
 struct Cell;
 struct Factory;
@@ -22,6 +24,10 @@ typedef struct Role {
     Role(struct Unit *_unit, char _goal_type = 'x');
     virtual ~Role() = default;
 
+    // Roles are created, copied and deleted throughout each sim step, see pool_alloc
+    static void *operator new(size_t size) { return pool_alloc(size); }
+    static void operator delete(void *ptr, size_t size) { pool_free(ptr, size); }
+
     bool is_set();
     bool _goal_is_factory();
     static void _displace_unit(struct Unit *unit);
@@ -51,11 +51,11 @@ bool RoleAntagonizer::from_mine(Role **new_role, Unit *_unit, Resource resource,
 
     // All cells that have recently been mined
     auto &past_cell_steps = (_unit->heavy
-                             ? board.heavy_mine_cell_steps
-                             : board.light_mine_cell_steps);
+                             ? board().heavy_mine_cell_steps
+                             : board().light_mine_cell_steps);
     for (int i = (int)past_cell_steps.size() - 1; i >= 0; i--) {
         int step = past_cell_steps[i].second;
-        if (step < board.step - past_steps) break;
+        if (step < board().step - past_steps) break;
 
         Cell *cell = past_cell_steps[i].first;
         if (resource == Resource_ICE && max_water) {
@@ -80,11 +80,11 @@ bool RoleAntagonizer::from_mine(Role **new_role, Unit *_unit, Resource resource,
 
     // All cells that will be mined in the near future based on AQ
     auto &future_cell_steps = (_unit->heavy
-                               ? board.future_heavy_mine_cell_steps
-                               : board.future_light_mine_cell_steps);
+                               ? board().future_heavy_mine_cell_steps
+                               : board().future_light_mine_cell_steps);
     for (int i = 0; i < (int)future_cell_steps.size(); i++) {
         int step = future_cell_steps[i].second;
-        if (step > board.step + future_steps) break;
+        if (step > board().step + future_steps) break;
 
         Cell *cell = future_cell_steps[i].first;
         if (resource == Resource_ICE && max_water) {
@@ -131,12 +131,12 @@ bool RoleAntagonizer::from_chain(Role **new_role, Unit *_unit, int max_dist, int
     Cell *best_cell = NULL;
     Unit *best_chain_miner = NULL;
     int min_dist = INT_MAX;
-    for (auto &opp_chain : board.opp_chains) {
+    for (auto &opp_chain : board().opp_chains) {
         Unit *chain_miner = opp_chain.first;
         vector<Cell*> *chain_route = opp_chain.second;
         for (Cell *chain_cell : *chain_route) {
             int dist = chain_cell->man_dist_factory(factory);
-            if (!chain_cell->factory
+            if (!chain_cell->factory()
                 && !chain_cell->assigned_unit
                 && dist <= max_dist
                 && dist < min_dist) {
@@ -179,7 +179,7 @@ bool RoleAntagonizer::from_transition_antagonizer_with_target_factory(Role **new
     //if (_unit->_log_cond()) LUX_LOG("RoleAntagonizer::from_transition_ant_w_target_factory A");
 
     RoleAntagonizer *role;
-    if (!board.sim0()
+    if (!board().sim0()
         || !(role = RoleAntagonizer::cast(_unit->role))
         || !role->target_factory) return false;
 
@@ -188,14 +188,14 @@ bool RoleAntagonizer::from_transition_antagonizer_with_target_factory(Role **new
 
     if (new_target_cell) {
         if (new_target_cell != role->target_cell) {
-            //if (board.sim0()) LUX_LOG(*_unit << " ANT transition " << *role->target_cell << ' '
+            //if (board().sim0()) LUX_LOG(*_unit << " ANT transition " << *role->target_cell << ' '
             //                          << *new_target_cell);
             Role::_displace_unit(new_target_cell);
             *new_role = new RoleAntagonizer(_unit, role->factory,new_target_cell,role->target_factory);
             return true;
         }
     } else {
-        //if (board.sim0()) LUX_LOG(*_unit << " ANT transition to recharge");
+        //if (board().sim0()) LUX_LOG(*_unit << " ANT transition to recharge");
         *new_role = new RoleRecharge(_unit, role->factory);
         return true;
     }
@@ -206,7 +206,7 @@ bool RoleAntagonizer::from_transition_antagonizer_with_target_factory(Role **new
 bool RoleAntagonizer::from_transition_destroy_factory(Role **new_role, Unit *_unit, int max_dist) {
     LUX_ASSERT(_unit->heavy);
 
-    if (!board.sim0()
+    if (!board().sim0()
         || _unit->power < 500) return false;
 
     // Various roles/situations should not transition
@@ -230,11 +230,11 @@ bool RoleAntagonizer::from_transition_destroy_factory(Role **new_role, Unit *_un
     int future_steps = 10;
 
     Cell *cur_cell = _unit->cell();
-    for (int i = (int)board.heavy_mine_cell_steps.size() - 1; i >= 0; i--) {
-        int step = board.heavy_mine_cell_steps[i].second;
-        if (step < board.step - past_steps) break;
+    for (int i = (int)board().heavy_mine_cell_steps.size() - 1; i >= 0; i--) {
+        int step = board().heavy_mine_cell_steps[i].second;
+        if (step < board().step - past_steps) break;
 
-        Cell *cell = board.heavy_mine_cell_steps[i].first;
+        Cell *cell = board().heavy_mine_cell_steps[i].first;
         int dist = cell->man_dist(cur_cell);
         if (dist <= max_dist
             && dist < min_dist
@@ -256,11 +256,11 @@ bool RoleAntagonizer::from_transition_destroy_factory(Role **new_role, Unit *_un
     }
 
     // All cells that will be mined in the near future based on AQ
-    for (int i = 0; i < (int)board.future_heavy_mine_cell_steps.size(); i++) {
-        int step = board.future_heavy_mine_cell_steps[i].second;
-        if (step > board.step + future_steps) break;
+    for (int i = 0; i < (int)board().future_heavy_mine_cell_steps.size(); i++) {
+        int step = board().future_heavy_mine_cell_steps[i].second;
+        if (step > board().step + future_steps) break;
 
-        Cell *cell = board.future_heavy_mine_cell_steps[i].first;
+        Cell *cell = board().future_heavy_mine_cell_steps[i].first;
         int dist = cell->man_dist_factory(factory);
         if (dist <= max_dist
             && dist < min_dist
@@ -322,8 +322,8 @@ Cell *RoleAntagonizer::_get_factory_target_cell(Unit *unit, Factory *target_fact
         for (auto &mine_cell_step : opp_unit->future_mine_cell_steps) {
             Cell *mine_cell = mine_cell_step.first;
             int step = mine_cell_step.second;
-            // [board.step, board.step+10)
-            if (step < board.step + 10) {
+            // [board().step, board().step+10)
+            if (step < board().step + 10) {
                 scores[mine_cell] += (mine_cell->ice ? 100 : 10);
             } else break;
         }
@@ -332,10 +332,10 @@ Cell *RoleAntagonizer::_get_factory_target_cell(Unit *unit, Factory *target_fact
         for (int i = opp_unit->mine_cell_steps.size() - 1; i >= 0; i--) {
             Cell *mine_cell = opp_unit->mine_cell_steps[i].first;
             int step = opp_unit->mine_cell_steps[i].second;
-            // [board.step-15, board.step)
-            if (mine_cell->ice && step >= board.step - 15) scores[mine_cell] += 10;
-            else if (mine_cell->ore && step >= board.step - 3) scores[mine_cell] += 1;
-            else if (step < board.step - 15) break;
+            // [board().step-15, board().step)
+            if (mine_cell->ice && step >= board().step - 15) scores[mine_cell] += 10;
+            else if (mine_cell->ore && step >= board().step - 3) scores[mine_cell] += 1;
+            else if (step < board().step - 15) break;
         }
     }
 
@@ -358,7 +358,7 @@ Cell *RoleAntagonizer::_get_factory_target_cell(Unit *unit, Factory *target_fact
             || (!cell->assigned_unit->heavy && unit->heavy)) {
             int own_dist = cell->man_dist_factory(factory);
             // Want low dist, low rubble
-            double score = cell_score.second - own_dist - 0.01 * cell->rubble;
+            double score = cell_score.second - own_dist - 0.01 * cell->rubble();
             if (score > best_score) {
                 best_score = score;
                 best_cell = cell;
@@ -367,7 +367,7 @@ Cell *RoleAntagonizer::_get_factory_target_cell(Unit *unit, Factory *target_fact
     }
 
     // if best_cell is null and there exists 1+ dist-1 ice, go to the one closest to target_factory
-    if (!best_cell && board.sim_step > 1) {
+    if (!best_cell && board().sim_step > 1) {
         int min_dist = INT_MAX;
         for (Cell *ice_cell : factory->ice_cells) {
             if (ice_cell->man_dist_factory(factory) > 1) break;
@@ -387,14 +387,14 @@ Cell *RoleAntagonizer::_get_factory_target_cell(Unit *unit, Factory *target_fact
 
 bool RoleAntagonizer::_can_destroy_factory(Unit *unit, Cell *target_cell, Factory *target_factory,
                                            Unit *chain_miner, int power_cushion) {
-    LUX_ASSERT(board.sim0());
+    LUX_ASSERT(board().sim0());
 
     // Light can destroy.. heavy (not factory, close enough)
     if (!unit->heavy
         && chain_miner
         && chain_miner->low_power
         && chain_miner->assigned_unit) {
-        if (board.sim0()) LUX_LOG(*unit << " can destroy chain miner " << *chain_miner
+        if (board().sim0()) LUX_LOG(*unit << " can destroy chain miner " << *chain_miner
                                   << " w/ " << *chain_miner->assigned_unit);
         return true;
     }
@@ -407,12 +407,12 @@ bool RoleAntagonizer::_can_destroy_factory(Unit *unit, Cell *target_cell, Factor
     // Lights can destroy factories if they're antagonizing an ice chain
     if (!unit->heavy
         && chain_miner) {
-        auto it = board.opp_chains.find(chain_miner);
-        if (it != board.opp_chains.end()
+        auto it = board().opp_chains.find(chain_miner);
+        if (it != board().opp_chains.end()
             && it->second->back()->ice) {
             // valid for consideration
-            if (it->second->front()->factory) {
-                opp_factory = it->second->front()->factory;
+            if (it->second->front()->factory()) {
+                opp_factory = it->second->front()->factory();
             }
         } else {
             return false;
@@ -444,7 +444,7 @@ bool RoleAntagonizer::_can_destroy_factory(Unit *unit, Cell *target_cell, Factor
 
     // Check if factory would explode after game ends
     int step_count = (unit->power - power_cushion) / oscillate_cost;
-    if (board.sim_step + step_count >= 1000) return false;
+    if (board().sim_step + step_count >= 1000) return false;
 
     int water = opp_factory->water;
     int ice = opp_factory->ice;
@@ -462,7 +462,7 @@ bool RoleAntagonizer::_can_destroy_factory(Unit *unit, Cell *target_cell, Factor
     water += g_light_cfg.DIG_RESOURCE_GAIN * water / ICE_WATER_RATIO;
 
     bool can_destroy = (step_count >= water);
-    if (board.sim0() && can_destroy) {
+    if (board().sim0() && can_destroy) {
         LUX_LOG(*unit << " can destroy " << *opp_factory << ' ' << unit->power
                 << ' ' << oscillate_cost << ' ' << step_count << ' ' << water);
     }
@@ -470,13 +470,13 @@ bool RoleAntagonizer::_can_destroy_factory(Unit *unit, Cell *target_cell, Factor
 }
 
 bool RoleAntagonizer::can_destroy_factory() {
-    if (board.step == this->_can_destroy_factory_step) return this->_can_destroy_factory_cache;
+    if (board().step == this->_can_destroy_factory_step) return this->_can_destroy_factory_cache;
 
     // If called for the first time after sim0, cannot know for sure (we have moved, but opp has not)
-    if (!board.sim0()) return false;
+    if (!board().sim0()) return false;
 
     // Set cache
-    this->_can_destroy_factory_step = board.step;
+    this->_can_destroy_factory_step = board().step;
     this->_can_destroy_factory_cache = RoleAntagonizer::_can_destroy_factory(
         this->unit, this->target_cell, this->target_factory, this->chain_miner);
 
@@ -523,7 +523,7 @@ bool RoleAntagonizer::is_valid() {
     int FUTURE_STEPS = 10;
 
     // Try to keep can_destroy antagonizers valid even if home factory is lost
-    if (board.sim0()
+    if (board().sim0()
         && !this->factory->alive()
         && this->factory != this->unit->assigned_factory) {
         // update factory before checking can_destroy so it is representative of future calls
@@ -541,9 +541,9 @@ bool RoleAntagonizer::is_valid() {
     }
 
     // No new opp info after sim0, so must still be valid
-    if (!board.sim0()
+    if (!board().sim0()
         || this->target_factory
-        || board.step < PAST_STEPS
+        || board().step < PAST_STEPS
         || this->can_destroy_factory()) return true;
 
     // Cow antagonizers invalidate if rubble is cleared
@@ -557,30 +557,30 @@ bool RoleAntagonizer::is_valid() {
         Unit *opp_unit = this->target_cell->opp_unit();
         if (opp_unit
             && opp_unit->heavy
-            && this->target_cell->get_unit_history(board.step - 1) == opp_unit
-            && this->target_cell->get_unit_history(board.step - 2) == opp_unit) {
+            && this->target_cell->get_unit_history(board().step - 1) == opp_unit
+            && this->target_cell->get_unit_history(board().step - 2) == opp_unit) {
             return false;
         }
     }
 
     if (this->chain_miner) {
-        auto it = board.opp_chains.find(this->chain_miner);
-        if (it == board.opp_chains.end()) return false;
+        auto it = board().opp_chains.find(this->chain_miner);
+        if (it == board().opp_chains.end()) return false;
         // TODO: if target cell no longer in known chain route, try to update role?
         return true;  // the following checks are irrelevant
     }
 
     // Still valid if an opp unit plans to dig at target_cell
-    if (this->unit->heavy && this->target_cell->future_heavy_dig_step <= board.step + FUTURE_STEPS) {
+    if (this->unit->heavy && this->target_cell->future_heavy_dig_step() <= board().step + FUTURE_STEPS) {
         return true;
     }
-    if (!this->unit->heavy && this->target_cell->future_light_dig_step <= board.step + FUTURE_STEPS) {
+    if (!this->unit->heavy && this->target_cell->future_light_dig_step() <= board().step + FUTURE_STEPS) {
         return true;
     }
 
     // Still valid if an opp unit has recently been at target_cell
-    for (int step = board.step; step > board.step - PAST_STEPS; step--) {
-        Unit *opp_unit = this->target_cell->get_unit_history(step, board.opp);
+    for (int step = board().step; step > board().step - PAST_STEPS; step--) {
+        Unit *opp_unit = this->target_cell->get_unit_history(step, board().opp);
         if (opp_unit && opp_unit->heavy == this->unit->heavy) return true;
     }
 
@@ -632,13 +632,13 @@ void RoleAntagonizer::update_goal() {
 
         if (is_ice_conflict
             && this->unit->heavy
-            && board.sim_step < 10) {
+            && board().sim_step < 10) {
             // Force ice conflict heavy ant to pickup before heading out at start
             power_threshold = 600;
         }
         else if (is_ice_conflict
                  && this->unit->heavy
-                 && cur_cell->factory == this->factory
+                 && cur_cell->factory() == this->factory
                  && this->unit->power < 2000
                  && this->factory->power >= 500) {
             // Pick up power if ice conflict heavy ant at factory and it has some
@@ -648,9 +648,9 @@ void RoleAntagonizer::update_goal() {
             int min_moves = (is_ice_conflict ? 10 : 40);
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
-                + board.naive_cost(this->unit, cur_cell, this->target_cell)
+                + board().naive_cost(this->unit, cur_cell, this->target_cell)
                 + min_moves * this->unit->cfg->MOVE_COST
-                + board.naive_cost(this->unit, this->target_cell, this->factory->cell));
+                + board().naive_cost(this->unit, this->target_cell, this->factory->cell));
         }
 
         power_threshold = MIN(power_threshold, 0.95 * this->unit->cfg->BATTERY_CAPACITY);
@@ -681,14 +681,14 @@ bool RoleAntagonizer::do_dig() {
     int resource_dist = cur_cell->man_dist_factory(this->factory);
 
     if ((!cur_cell->ice && !cur_cell->ore)
-        || (resource_dist > 1 && board.sim_step % 2 != 0)) return false;
+        || (resource_dist > 1 && board().sim_step % 2 != 0)) return false;
 
     Cell *goal_cell = this->goal_cell();
     int opp_resource_dist = cur_cell->away_dist;
 
     if (cur_cell == goal_cell
         && (resource_dist < opp_resource_dist
-            || cur_cell->rubble == 0)
+            || cur_cell->rubble() == 0)
         && this->unit->power >= this->unit->dig_cost()) {
         this->unit->do_dig();
         return true;
@@ -30,7 +30,7 @@ RoleAttacker::RoleAttacker(Unit *_unit, Factory *_factory, Unit *_target_unit,
 
 bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit) {
     //if (_unit->_log_cond()) LUX_LOG("RoleAttacker::from_transition_low_power_attack A");
-    if (!board.sim0() || board.final_night()) return false;
+    if (!board().sim0() || board().final_night()) return false;
 
     Factory *factory = _unit->assigned_factory;
 
@@ -77,10 +77,10 @@ bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit
     }
 
     Cell *cur_cell = _unit->cell();
-    for (Unit *opp_unit : board.opp->units()) {
+    for (Unit *opp_unit : board().opp->units()) {
         Cell *opp_cell = opp_unit->cell();
         if (!opp_unit->low_power
-            || opp_cell->factory
+            || opp_cell->factory()
             || opp_unit->heavy != _unit->heavy) continue;
 
         int cur_cell_opp_dist = cur_cell->man_dist(opp_cell);
@@ -111,8 +111,8 @@ bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit
         if (ice_conflict_target_factory && opp_factory != ice_conflict_target_factory) continue;
 
         // Ignore units that have no way to refuel
-        if (board.sim_step + opp_dist >= FINAL_NIGHT_PHASE) continue;
-        if (board.final_night() && opp_unit->power < opp_unit->cfg->RAZE_COST) continue;
+        if (board().sim_step + opp_dist >= FINAL_NIGHT_PHASE) continue;
+        if (board().final_night() && opp_unit->power < opp_unit->cfg->RAZE_COST) continue;
 
         // Ignore heavy miners that may be receiving power from transporters
         // Check for transporters (or dist1)
@@ -120,11 +120,11 @@ bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit
         if (opp_unit->heavy
             && (opp_cell->ice || opp_cell->ore)
             && !opp_unit->mine_cell_steps.empty()
-            && opp_unit->mine_cell_steps.back().second >= board.sim_step - 5) {
+            && opp_unit->mine_cell_steps.back().second >= board().sim_step - 5) {
             if (opp_cell->away_dist == 1
                 || cur_cell_opp_dist >= 10) continue;
-            auto it = board.opp_chains.find(opp_unit);
-            if (it != board.opp_chains.end()) {
+            auto it = board().opp_chains.find(opp_unit);
+            if (it != board().opp_chains.end()) {
                 // There exists a chain to this heavy miner
                 // If the chain is un-antagonized, continue
                 bool is_antagonized = false;
@@ -144,10 +144,10 @@ bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit
         // Ignore distant heavies during end phase
         if (opp_unit->heavy
             && cur_cell_opp_dist >= 10
-            && board.sim_step >= END_PHASE) continue;
+            && board().sim_step >= END_PHASE) continue;
 
         // Ignore if could not return after kill
-        if (2 * cur_cell_opp_dist > 1000 - board.sim_step) continue;
+        if (2 * cur_cell_opp_dist > 1000 - board().sim_step) continue;
 
         // Ignore if cannot cut off before recharged
         Cell *cutoff_cell = RoleAttacker::_cutoff_cell(opp_unit);
@@ -158,7 +158,7 @@ bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit
         // Determine more accurate cutoff cell (important when opp unit has no chance of getting close)
         int opp_power = opp_unit->power;
         int route_idx = 1;
-        int pursuit_step = board.sim_step;
+        int pursuit_step = board().sim_step;
         int steps_delayed = 0;
         while (steps_delayed < cur_cell_opp_dist && opp_cell != cutoff_cell) {
             LUX_ASSERT(route_idx < opp_unit->low_power_route.size());
@@ -181,22 +181,22 @@ bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit
         cutoff_cell = opp_cell;
         opp_cell = opp_unit->cell();
 
-        if (cutoff_cell->factory) return false;
+        if (cutoff_cell->factory()) return false;
 
         // TODO: check if unit can/should go to factory first (need time and high factory power)
         int naive_power_threshold = 0;
         if (RoleBlockade::cast(_unit->role) && opp_unit->water >= 5) {
             naive_power_threshold = (
                 _unit->cfg->ACTION_QUEUE_POWER_COST
-                + board.naive_cost(_unit, cur_cell, opp_cell)
-                + board.naive_cost(_unit, opp_cell, cutoff_cell));
+                + board().naive_cost(_unit, cur_cell, opp_cell)
+                + board().naive_cost(_unit, opp_cell, cutoff_cell));
         } else {
             naive_power_threshold = (
                 3 * _unit->cfg->ACTION_QUEUE_POWER_COST
                 + 3 * _unit->cfg->MOVE_COST
-                + board.naive_cost(_unit, cur_cell, opp_cell)
-                + board.naive_cost(_unit, opp_cell, cutoff_cell)
-                + board.naive_cost(_unit, cutoff_cell, factory->cell));
+                + board().naive_cost(_unit, cur_cell, opp_cell)
+                + board().naive_cost(_unit, opp_cell, cutoff_cell)
+                + board().naive_cost(_unit, cutoff_cell, factory->cell));
         }
         if (_unit->power >= naive_power_threshold) {
             Role::_displace_unit(opp_unit);
@@ -211,7 +211,7 @@ bool RoleAttacker::from_transition_low_power_attack(Role **new_role, Unit *_unit
 
 bool RoleAttacker::from_transition_defend_territory(Role **new_role, Unit *_unit, int max_count) {
     //if (_unit->_log_cond()) LUX_LOG("RoleAttacker::from_transition_defend_territory A");
-    if (!board.sim0()) return false;
+    if (!board().sim0()) return false;
 
     Factory *factory = _unit->assigned_factory;
 
@@ -257,22 +257,22 @@ bool RoleAttacker::from_transition_defend_territory(Role **new_role, Unit *_unit
     Unit *best_unit = NULL;
     double best_score = INT_MAX;
     Cell *cur_cell = _unit->cell();
-    for (Unit *opp_unit : board.opp->units()) {
+    for (Unit *opp_unit : board().opp->units()) {
         Cell *opp_cell = opp_unit->cell();
         int opp_dist = opp_cell->man_dist(cur_cell);
         if (_unit->heavy != opp_unit->heavy
             || opp_dist > 10
-            || opp_cell->factory
+            || opp_cell->factory()
             || opp_unit->assigned_unit) continue;
 
-        if (board.final_night() && opp_unit->power < opp_unit->cfg->RAZE_COST) continue;
+        if (board().final_night() && opp_unit->power < opp_unit->cfg->RAZE_COST) continue;
 
         bool is_qualified = (opp_unit->water >= 5);
         if (!is_qualified) {
             bool lichen_adj = false;
             for (Cell *neighbor : opp_cell->neighbors_plus) {
-                if (neighbor->factory == factory
-                    || neighbor->lichen_strain == factory->id) {
+                if (neighbor->factory() == factory
+                    || neighbor->lichen_strain() == factory->id) {
                     lichen_adj = true;
                     break;
                 }
@@ -306,7 +306,7 @@ Cell *RoleAttacker::_cutoff_cell(Unit *opp_unit) {
 
     for (int i = (int)opp_unit->low_power_route.size() - 1; i >= 0; i--) {
         Cell *route_cell = opp_unit->low_power_route[i];
-        if (!route_cell->factory) return route_cell;
+        if (!route_cell->factory()) return route_cell;
     }
 
     LUX_LOG("Bad low power route? " << *opp_unit << ' '
@@ -355,12 +355,12 @@ void RoleAttacker::teardown() {
 
 bool RoleAttacker::is_valid() {
     // No new info after sim step 0
-    if (!board.sim0()) return true;
+    if (!board().sim0()) return true;
 
     // Switch into low power attack mode if possible
     if (!this->low_power_attack
         && this->target_unit->low_power
-        && board.sim_step < END_PHASE) {
+        && board().sim_step < END_PHASE) {
         this->low_power_attack = true;
         this->defend = false;
         LUX_LOG("attacker modify " << *this->unit << " to low power attack " << *this);
@@ -376,7 +376,7 @@ bool RoleAttacker::is_valid() {
 
     bool is_valid = (this->factory->alive()
                      && this->target_unit->alive()
-                     && !this->target_unit->cell()->factory);
+                     && !this->target_unit->cell()->factory());
 
     if (is_valid
         && this->defend) {
@@ -384,8 +384,8 @@ bool RoleAttacker::is_valid() {
         bool is_qualified = (this->target_unit->water >= 5);
         if (!is_qualified) {
             for (Cell *neighbor : opp_cell->neighbors_plus) {
-                if (neighbor->factory == this->factory
-                    || neighbor->lichen_strain == this->factory->id) {
+                if (neighbor->factory() == this->factory
+                    || neighbor->lichen_strain() == this->factory->id) {
                     is_qualified = true;
                     break;
                 }
@@ -419,14 +419,14 @@ bool RoleAttacker::is_valid() {
 
     // No need to pursue stranded units during final night
     if (is_valid
-        && board.final_night()
+        && board().final_night()
         && this->low_power_attack) {
         is_valid = false;
     }
 
     // No need to pursue units unable to destroy lichen during final night
     if (is_valid
-        && board.final_night()
+        && board().final_night()
         && this->target_unit->power < this->target_unit->cfg->RAZE_COST) {
         is_valid = false;
     }
@@ -466,10 +466,10 @@ void RoleAttacker::update_goal() {
         } else {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
-                + board.naive_cost(this->unit, this->unit->cell(), this->target_unit->cell())
+                + board().naive_cost(this->unit, this->unit->cell(), this->target_unit->cell())
                 + 20 * this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 20 * this->unit->cfg->MOVE_COST
-                + board.naive_cost(this->unit, this->target_unit->cell(), this->factory->cell));
+                + board().naive_cost(this->unit, this->target_unit->cell(), this->factory->cell));
         }
         power_threshold = MIN(power_threshold, this->unit->cfg->BATTERY_CAPACITY);
         if (this->unit->power >= power_threshold) {
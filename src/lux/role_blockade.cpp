@@ -9,6 +9,7 @@
 #include "lux/exception.hpp"
 #include "lux/log.hpp"
 #include "lux/mode_ice_conflict.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/role_water_transporter.hpp"
 #include "lux/unit.hpp"
 using namespace std;
@@ -24,7 +25,7 @@ RoleBlockade::RoleBlockade(Unit *_unit, Factory *_factory, Unit *_target_unit,
     this->goal = _factory;
 
     this->last_transporter_factory = _target_unit->last_factory;
-    this->last_transporter_step = board.step;
+    this->last_transporter_step = board().step;
 
     this->avoid_step = -1;
     this->push_step = -1;
@@ -41,7 +42,7 @@ RoleBlockade::RoleBlockade(Unit *_unit, Factory *_factory, Unit *_target_unit,
 
 bool RoleBlockade::from_transition_block_water_transporter(Role **new_role, Unit *_unit) {
     //if (_unit->_log_cond()) LUX_LOG(*_unit << " RoleBlockade::from_tr_block A");
-    if (!board.sim0()
+    if (!board().sim0()
         || _unit->heavy) return false;
 
     // Various roles/situations should not transition
@@ -58,21 +59,21 @@ bool RoleBlockade::from_transition_block_water_transporter(Role **new_role, Unit
     ModeIceConflict *mode = ModeIceConflict::cast(factory->mode);
     if (!mode
         || cur_cell->man_dist_factory(factory) >= 5) {
-        //if (board.sim0()) LUX_LOG(*_unit << " RoleBlockade::from_tr_block B");
+        //if (board().sim0()) LUX_LOG(*_unit << " RoleBlockade::from_tr_block B");
         return false;
     }
 
-    //if (board.sim0()) LUX_LOG(*_unit << " RoleBlockade::from_tr_block C!");
+    //if (board().sim0()) LUX_LOG(*_unit << " RoleBlockade::from_tr_block C!");
     int max_count = 2;
     if (factory->get_similar_unit_count(
             _unit, [&](Role *r) { return RoleBlockade::cast(r); }) >= max_count) return false;
 
     //LUX_LOG("RoleBlockade::from_tr_block D");
     Factory *target_factory = mode->opp_factory;
-    for (Unit *opp_unit : board.opp->units()) {
+    for (Unit *opp_unit : board().opp->units()) {
         // Must be light not currently on target factory
         if (opp_unit->heavy
-            || opp_unit->cell()->factory == target_factory) continue;
+            || opp_unit->cell()->factory() == target_factory) continue;
 
         // Must have water or have plans to pick it up soon
         bool has_water = opp_unit->water >= 5;
@@ -96,7 +97,7 @@ bool RoleBlockade::from_transition_block_water_transporter(Role **new_role, Unit
             if (RoleBlockade::cast(u->role)
                 && RoleBlockade::cast(u->role)->target_unit == opp_unit) {
                 if (RoleBlockade::cast(u->role)->partner) {
-                    //if (board.sim0()) LUX_LOG(*_unit << " RoleBlockade::from_tr_block E");
+                    //if (board().sim0()) LUX_LOG(*_unit << " RoleBlockade::from_tr_block E");
                     already_blockaded = true;  // shouldn't happen?
                 } else {
                     partner = u;
@@ -124,7 +125,7 @@ bool RoleBlockade::from_transition_block_different_water_transporter(Role **new_
     Factory *factory = _unit->assigned_factory;
     RoleBlockade *role;
     ModeIceConflict *mode;
-    if (!board.sim0()
+    if (!board().sim0()
         || _unit->heavy
         || !(mode = ModeIceConflict::cast(factory->mode))
         || !(role = RoleBlockade::cast(_unit->role))
@@ -149,11 +150,11 @@ bool RoleBlockade::from_transition_block_different_water_transporter(Role **new_
     int cur_progress = cur_start_dist - cur_end_dist;
     int cur_progress_rate = (cur_len == 1 ? 0 : 100 * cur_progress / (cur_len - 1));
 
-    for (Unit *opp_unit : board.opp->units()) {
+    for (Unit *opp_unit : board().opp->units()) {
         // Must be light not currently on target factory
         if (opp_unit->heavy
             || opp_unit == role->target_unit
-            || opp_unit->cell()->factory == target_factory) continue;
+            || opp_unit->cell()->factory() == target_factory) continue;
 
         // Must have water or have plans to pick it up soon
         bool has_water = opp_unit->water >= 5;
@@ -254,11 +255,11 @@ bool RoleBlockade::has_target_unit() {
 }
 
 bool RoleBlockade::is_primary() {
-    if (this->_is_primary_step == board.step) {
+    if (this->_is_primary_step == board().step) {
         //LUX_LOG(*this->unit << " is_primary cache " << this->_is_primary);
         return this->_is_primary;
     }
-    this->_is_primary_step = board.step;
+    this->_is_primary_step = board().step;
     this->_is_primary = true;
     //LUX_LOG(*this->unit << " is_primary begin");
 
@@ -285,11 +286,11 @@ bool RoleBlockade::is_primary() {
 }
 
 bool RoleBlockade::is_engaged() {
-    if (this->_is_engaged_step == board.step) {
+    if (this->_is_engaged_step == board().step) {
         //LUX_LOG(*this->unit << " is_engaged cache " << this->_is_engaged);
         return this->_is_engaged;
     }
-    this->_is_engaged_step = board.step;
+    this->_is_engaged_step = board().step;
     this->_is_engaged = false;
     //LUX_LOG(*this->unit << " is_engaged begin");
 
@@ -392,15 +393,15 @@ double RoleBlockade::unengaged_goal_cell_score(Cell *cell) {
     int own_factory_dist = cell->man_dist_factory(this->factory);
     int opp_factory_dist = cell->man_dist_factory(this->target_factory);
 
-    double rubble = (cell->rubble / 20 * 20) / 100.0;  // round down to nearest 20 and convert to %
+    double rubble = (cell->rubble() / 20 * 20) / 100.0;  // round down to nearest 20 and convert to %
     double adj_rubble = 0;  // also round down and %
-    for (Cell *neighbor : cell->neighbors) adj_rubble += neighbor->rubble / 20 * 20;
+    for (Cell *neighbor : cell->neighbors) adj_rubble += neighbor->rubble() / 20 * 20;
     adj_rubble /= (100.0 * cell->neighbors.size());
 
     PDD traffic_pair = cell->get_traffic_score(NULL, /*neighbors*/true);
     double traffic = traffic_pair.first + traffic_pair.second;  // max 1.0
 
-    Factory *other_opp_factory = cell->_nearest_factory(board.opp, /*ignore*/this->target_factory);
+    Factory *other_opp_factory = cell->_nearest_factory(board().opp, /*ignore*/this->target_factory);
     int other_opp_factory_dist = (other_opp_factory
                                   ? cell->man_dist_factory(other_opp_factory)
                                   : 100);
@@ -468,8 +469,8 @@ double RoleBlockade::unengaged_goal_cell_score(Cell *cell) {
 }
 
 vector<Cell*> &RoleBlockade::target_route() {
-    if (this->_target_route_step == board.step) return this->_target_route;
-    this->_target_route_step = board.step;
+    if (this->_target_route_step == board().step) return this->_target_route;
+    this->_target_route_step = board().step;
     this->_target_route.clear();
 
     Cell *cur_cell = this->unit->cell();
@@ -496,13 +497,13 @@ vector<Cell*> &RoleBlockade::target_route() {
     }
 
     Cell *end_cell = this->_target_route.back();
-    if (end_cell->factory != this->target_factory) {
+    if (end_cell->factory() != this->target_factory) {
         vector<Cell*> end_route;
-        int cost = board.pathfind(this->target_unit, end_cell, this->target_factory->cell,
-                                  [&](Cell *c) { return c->factory == this->target_factory; },
-                                  NULL,
-                                  [&](Cell *c, Unit *u) { (void)u; return 1 + 0.0375 * c->rubble; },
-                                  &end_route);
+        int cost = board().pathfind_t(this->target_unit, end_cell, this->target_factory->cell,
+                                    [&](Cell *c) { return c->factory() == this->target_factory; },
+                                    PathNone(),
+                                    [&](Cell *c, Unit *u) { (void)u; return 1 + 0.0375 * c->rubble(); },
+                                    &end_route);
         if (cost != INT_MAX) {
             this->_target_route.pop_back();  // end route starts with end cell of existing route
             this->_target_route.insert(this->_target_route.end(), end_route.begin(), end_route.end());
@@ -513,7 +514,7 @@ vector<Cell*> &RoleBlockade::target_route() {
 
     // If something went wrong, just store no route
     if (!this->_target_route.empty()
-        && this->_target_route.back()->factory != this->target_factory) {
+        && this->_target_route.back()->factory() != this->target_factory) {
         LUX_LOG("WARNING: bad blockade target routeB " << *opp_cell << ' '<< *this->target_factory);
         this->_target_route.clear();
     }
@@ -522,10 +523,10 @@ vector<Cell*> &RoleBlockade::target_route() {
 }
 
 vector<Cell*> &RoleBlockade::unengaged_goal_cell_candidates() {
-    if (this->_unengaged_goal_cell_candidates_step == board.step) {
+    if (this->_unengaged_goal_cell_candidates_step == board().step) {
         return this->_unengaged_goal_cell_candidates;
     }
-    this->_unengaged_goal_cell_candidates_step = board.step;
+    this->_unengaged_goal_cell_candidates_step = board().step;
     this->_unengaged_goal_cell_candidates.clear();
 
     vector<Cell*> target_route = this->target_route();
@@ -593,11 +594,11 @@ Cell *RoleBlockade::unengaged_goal_cell() {
 
     Cell *cur_cell = this->unit->cell();
     Cell *opp_cell = this->opp_cell();
-    Cell *opp_nonfactory_cell = (opp_cell->factory
-                                 ? opp_cell->factory->neighbor_toward(cur_cell)
+    Cell *opp_nonfactory_cell = (opp_cell->factory()
+                                 ? opp_cell->factory()->neighbor_toward(cur_cell)
                                  : opp_cell);
     Cell *goal_cell = (best_cell ? best_cell : opp_nonfactory_cell);
-    if (board.sim0()) LUX_LOG(*this->unit << ' ' << *this->factory << ' ' << *opp_nonfactory_cell
+    if (board().sim0()) LUX_LOG(*this->unit << ' ' << *this->factory << ' ' << *opp_nonfactory_cell
                               << " BEST " << *goal_cell << ' ' << best_score);
     return goal_cell;
 }
@@ -639,7 +640,7 @@ void RoleBlockade::teardown() {
 }
 
 bool RoleBlockade::is_valid() {
-    if (!board.sim0()) return true;
+    if (!board().sim0()) return true;
 
     // Drop partner if it dies/reassigns
     if (!this->has_partner()) {
@@ -677,7 +678,7 @@ bool RoleBlockade::is_valid() {
     bool target_is_valid = (this->factory->alive()
                             && this->target_factory->alive()
                             && this->has_target_unit()
-                            && this->target_unit->cell()->factory != this->target_factory);
+                            && this->target_unit->cell()->factory() != this->target_factory);
     if (target_is_valid) {
         // Must have water or have plans to pick it up soon
         bool has_water = this->target_unit->water >= 5;
@@ -695,12 +696,12 @@ bool RoleBlockade::is_valid() {
     }
 
     if (target_is_valid) {
-        this->last_transporter_step = board.step;
+        this->last_transporter_step = board().step;
         if (this->target_unit->water > this->target_unit->prev_prev_water
-            && this->target_unit->cell()->factory) {
-            this->last_transporter_factory = this->target_unit->cell()->factory;
+            && this->target_unit->cell()->factory()) {
+            this->last_transporter_factory = this->target_unit->cell()->factory();
         }
-    } else if (this->last_transporter_step == board.step - 1) {
+    } else if (this->last_transporter_step == board().step - 1) {
         this->target_unit = NULL;
         this->goal_type = 'f';
         this->goal = this->factory;
@@ -712,7 +713,7 @@ bool RoleBlockade::is_valid() {
                                   && this->last_transporter_factory
                                   && this->last_transporter_factory->alive()
                                   && this->last_transporter_factory != this->target_factory
-                                  && board.step < this->last_transporter_step + 150
+                                  && board().step < this->last_transporter_step + 150
                                   && this->target_factory->total_water() < 150);
 
     if (!target_is_valid && anticipation_is_valid) {
@@ -738,7 +739,7 @@ bool RoleBlockade::set_goal_cell_primary_intercept() {
     } else if (opp_factory_dist <= own_factory_dist
                && this->has_target_unit()
                && this->unit->power >= this->target_unit->power + 5
-               && !cur_cell->neighbor_toward(this->target_factory->cell)->factory) {
+               && !cur_cell->neighbor_toward(this->target_factory->cell)->factory()) {
         this->_goal_cell = cur_cell->neighbor_toward(this->target_factory->cell);
         LUX_LOG(*this->unit << ' ' << *this->_goal_cell << " blockade primary other B");
     } else if (unit_dist >= 2 && target_route.size() >= 4) {
@@ -776,7 +777,7 @@ bool RoleBlockade::set_goal_cell_secondary_rendezvous() {
     for (Cell *neighbor : par_goal_cell->neighbors) {
         if (!neighbor->assigned_unit
             && !neighbor->opp_factory()) {
-            int score = -board.naive_cost(this->unit, cur_cell, neighbor);
+            int score = -board().naive_cost(this->unit, cur_cell, neighbor);
             if (abs(dx) >= abs(dy) + 2) {
                 score += (neighbor->x == par_goal_cell->x ? 4 : 0);
             } else if (abs(dy) >= abs(dx) + 2) {
@@ -828,7 +829,7 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
             && threat_unit->power_init < min_power) continue;  // we can swap for low power lights
         Cell *threat_cell = threat_unit->cell();
         for (Cell *neighbor : threat_cell->neighbors) {
-            if (!neighbor->factory || neighbor->opp_factory()) possible_cells.insert(neighbor);
+            if (!neighbor->factory() || neighbor->opp_factory()) possible_cells.insert(neighbor);
             Unit *neighbor_unit = neighbor->own_unit();
             if (neighbor_unit
                 && threat_unit->heavy == neighbor_unit->heavy) probable_cells.insert(neighbor);
@@ -855,7 +856,7 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
 
         vector<Cell*> cutoff_cells;
         for (Cell *neighbor : nearest_cell->neighbors) {
-            if (!neighbor->factory) cutoff_cells.push_back(neighbor);
+            if (!neighbor->factory()) cutoff_cells.push_back(neighbor);
         }
 
         Cell *best_next_cell = NULL;
@@ -868,8 +869,8 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
             Cell *next_cell2 = par_cell->neighbor(direction);
             if (next_cell1
                 && next_cell2
-                && !next_cell1->unit_next
-                && !next_cell2->unit_next
+                && !next_cell1->unit_next()
+                && !next_cell2->unit_next()
                 && !next_cell1->opp_factory()
                 && !next_cell2->opp_factory()
                 && RoleBlockade::is_between(next_cell1, next_cell2,
@@ -956,9 +957,9 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
         }
 
         if (best_next_cell) {
-            this->avoid_step = board.step;
+            this->avoid_step = board().step;
             this->force_direction = best_direction;
-            this->force_direction_step = make_pair(board.step, board.sim_step);
+            this->force_direction_step = make_pair(board().step, board().sim_step);
             this->_goal_cell = best_next_cell;
             LUX_LOG(*this->unit << ' ' << *this->_goal_cell <<" blockade primary avoid "<< best_score);
             return true;
@@ -1011,7 +1012,7 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
             double best_score = INT_MIN;
             for (Cell *neighbor : cur_cell->neighbors) {
                 if (neighbor->man_dist(opp_cell) < opp_dist
-                    && !neighbor->unit_next
+                    && !neighbor->unit_next()
                     && neighbor->is_between(opp_cell, this->target_factory->cell)
                     && !neighbor->opp_factory()) {
                     int nfactory_dx = MAX(0, abs(neighbor->x - this->target_factory->x) - 1);
@@ -1027,9 +1028,9 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
             }
 
             if (enough_power && best_cell) {
-                this->next_swap_and_idle_step = board.step;
+                this->next_swap_and_idle_step = board().step;
                 RoleBlockade *par_role = RoleBlockade::cast(this->partner->role);
-                par_role->next_swap_and_idle_step = board.step;
+                par_role->next_swap_and_idle_step = board().step;
 
                 this->_goal_cell = best_cell;
                 LUX_LOG(*this->unit << ' ' << *this->_goal_cell << " blockade primary slide");
@@ -1058,7 +1059,7 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
     if (par_opp_dx == 2 * opp_dx && par_opp_dy == 2 * opp_dy) {
         for (Cell *neighbor : cur_cell->neighbors) {
             if (neighbor != par_cell
-                && !neighbor->unit_next
+                && !neighbor->unit_next()
                 && !neighbor->opp_factory()
                 && (neighbor->man_dist_factory(this->target_factory)
                     <= cur_cell->man_dist_factory(this->target_factory))) {
@@ -1085,14 +1086,14 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
     // . . . . . . . . .
     // TODO: I don't think this works well when opp cell is on a factory
     //if (this->unit->_log_cond()) LUX_LOG("RB::sgcpe D");
-    Cell *opp_nonfactory_cell = (opp_cell->factory
-                                 ? opp_cell->factory->neighbor_toward(cur_cell)
+    Cell *opp_nonfactory_cell = (opp_cell->factory()
+                                 ? opp_cell->factory()->neighbor_toward(cur_cell)
                                  : opp_cell);
     if (opp_dist == 1
         && opp_factory_dx <= factory_dx
         && opp_factory_dy <= factory_dy
-        && !opp_nonfactory_cell->unit_next) {
-        this->push_step = board.step;
+        && !opp_nonfactory_cell->unit_next()) {
+        this->push_step = board().step;
         this->_goal_cell = opp_nonfactory_cell;
         LUX_LOG(*this->unit << ' ' << *this->_goal_cell << " blockade primary push across");
         return true;
@@ -1120,11 +1121,11 @@ bool RoleBlockade::set_goal_cell_primary_engaged() {
         Cell *target_cell = cur_cell->neighbor_toward(opp_cell);
         if (min_power - this->unit->move_basic_cost(target_cell) > this->target_unit->power_init
             && !target_cell->opp_factory()
-            && !target_cell->unit_next) {
-            this->push_step = board.step;
-            this->next_swap_and_idle_step = board.step;
+            && !target_cell->unit_next()) {
+            this->push_step = board().step;
+            this->next_swap_and_idle_step = board().step;
             RoleBlockade *par_role = RoleBlockade::cast(this->partner->role);
-            par_role->next_swap_and_idle_step = board.step;
+            par_role->next_swap_and_idle_step = board().step;
 
             this->_goal_cell = target_cell;
             LUX_LOG(*this->unit << ' ' << *this->_goal_cell << " blockade primary push away");
@@ -1191,10 +1192,10 @@ bool RoleBlockade::set_goal_cell_secondary_engaged() {
 
     // if avoid
     // move in same direction as primary
-    if (par_role->avoid_step == board.step) {
+    if (par_role->avoid_step == board().step) {
         Direction direction = par_cell->neighbor_to_direction(par_goal_cell);
         this->force_direction = direction;
-        this->force_direction_step = make_pair(board.step, board.sim_step);
+        this->force_direction_step = make_pair(board().step, board().sim_step);
         this->_goal_cell = cur_cell->neighbor(direction);
         LUX_LOG(*this->unit << ' ' << *this->_goal_cell << " blockade secondary avoid "
                 << DirectionStr[direction]);
@@ -1203,7 +1204,7 @@ bool RoleBlockade::set_goal_cell_secondary_engaged() {
 
     // if push
     // move in direction of opp from primary
-    if (par_role->push_step == board.step) {
+    if (par_role->push_step == board().step) {
         int opp_dx = opp_cell->x - par_cell->x;
         int opp_dy = opp_cell->y - par_cell->y;
         opp_dx = (opp_dx ? (opp_dx / abs(opp_dx)) : opp_dx);
@@ -1235,8 +1236,8 @@ Cell *RoleBlockade::goal_cell() {
     // Override goal if on factory center
     Cell *cur_cell = this->unit->cell();
     Cell *opp_cell = this->opp_cell();
-    Cell *opp_nonfactory_cell = (opp_cell->factory
-                                 ? opp_cell->factory->neighbor_toward(cur_cell)
+    Cell *opp_nonfactory_cell = (opp_cell->factory()
+                                 ? opp_cell->factory()->neighbor_toward(cur_cell)
                                  : opp_cell);
     if (cur_cell == this->factory->cell) {
         //LUX_LOG(*this->unit << " RoleBlockade::goal_cell A1");
@@ -1250,12 +1251,12 @@ Cell *RoleBlockade::goal_cell() {
     }
 
     // Goal is target unit, check cache first
-    if (this->_goal_cell_step == board.step) {
+    if (this->_goal_cell_step == board().step) {
         // We already determined our goal cell, check to see if we should swap on the following step
         if (this->has_partner()
-            && this->next_swap_and_idle_step == board.step
+            && this->next_swap_and_idle_step == board().step
             && cur_cell->man_dist(this->partner->cell()) == 1) {
-            if (board.sim_step == board.step + 1) {
+            if (board().sim_step == board().step + 1) {
                 return this->partner->cell();
             } else {
                 return cur_cell;
@@ -1265,9 +1266,9 @@ Cell *RoleBlockade::goal_cell() {
         //LUX_LOG(*this->unit << " blockade use cached goal cell " << *this->_goal_cell);
         return this->_goal_cell;
     } else {
-        //LUX_LOG(*this->unit << " blockade cache miss "<< this->_goal_cell_step << ' ' << board.step);
+        //LUX_LOG(*this->unit << " blockade cache miss "<< this->_goal_cell_step << ' ' << board().step);
     }
-    this->_goal_cell_step = board.step;
+    this->_goal_cell_step = board().step;
     this->_goal_cell = opp_nonfactory_cell;  // default value
     this->straightline = false;
 
@@ -1362,21 +1363,22 @@ void RoleBlockade::update_goal() {
             }
         }
 
-        int cost_c2g = board.naive_cost(this->unit, cur_cell, goal_cell);
-        int cost_f2g = board.naive_cost(this->unit, this->factory->cell, goal_cell);
+        int cost_c2g = board().naive_cost(this->unit, cur_cell, goal_cell);
+        int cost_f2g = board().naive_cost(this->unit, this->factory->cell, goal_cell);
 
         int dist_diff = dist_c2f + dist_f2g - dist_c2g;
         int power_gain = 0;
         if (dist_diff > 0) {
-            int start_step = board.sim_step + dist_c2g;
+            int start_step = board().sim_step + dist_c2g;
             power_gain = this->unit->power_gain(start_step, start_step+dist_diff);
         }
 
         if (150 - cost_f2g <= cur_power - cost_c2g + power_gain + 3) {
             vector<Cell*> temp;
-            cost_c2g = board.pathfind(this->unit, cur_cell, goal_cell, NULL, NULL, NULL, &temp);
+            cost_c2g = board().pathfind(this->unit, cur_cell, goal_cell, NULL, NULL, NULL, &temp);
             dist_c2g = temp.size() - 1;
-            cost_f2g = board.pathfind(this->unit, factory->cell, goal_cell, NULL, NULL, NULL, &temp);
+            // Not a CostField: this starts at the center cell, and needs this step's rubble and stable ties
+            cost_f2g = board().pathfind(this->unit, factory->cell, goal_cell, NULL, NULL, NULL, &temp);
             dist_f2g = temp.size() - 1;
             if (cost_c2g == INT_MAX || cost_f2g == INT_MAX) {
                 LUX_LOG("WARNING: bad blockade pathfind " << *cur_cell << ' ' << *goal_cell);
@@ -1386,7 +1388,7 @@ void RoleBlockade::update_goal() {
             dist_diff = dist_c2f + dist_f2g - dist_c2g;
             power_gain = 0;
             if (dist_diff > 0) {
-                int start_step = board.sim_step + dist_c2g;
+                int start_step = board().sim_step + dist_c2g;
                 power_gain = this->unit->power_gain(start_step, start_step+dist_diff);
             }
 
@@ -137,7 +137,7 @@ void RoleChainTransporter::update_goal() {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 3 * this->unit->cfg->MOVE_COST
-                + board.naive_cost(this->unit, this->unit->cell(), this->target_cell));
+                + board().naive_cost(this->unit, this->unit->cell(), this->target_cell));
         }
         if (this->unit->power < power_threshold) {
             this->goal_type = 'f';
@@ -147,7 +147,7 @@ void RoleChainTransporter::update_goal() {
         int power_threshold = (
             this->unit->cfg->ACTION_QUEUE_POWER_COST
             + 10 * this->unit->cfg->MOVE_COST
-            + board.naive_cost(this->unit, this->unit->cell(), this->target_cell));
+            + board().naive_cost(this->unit, this->unit->cell(), this->target_cell));
         if (this->unit->power >= power_threshold) {
             this->goal_type = 'c';
             this->goal = this->target_cell;
@@ -176,7 +176,7 @@ bool RoleChainTransporter::do_move_last_chain() {
     if (this->chain_idx != role_miner->chain_units.size() - 1) return false;
 
     // If miner is threatened and on the move, this is no longer a high priority action
-    if (board.sim0() && this->target_unit->move_risk(this->target_unit->cell())) return false;
+    if (board().sim0() && this->target_unit->move_risk(this->target_unit->cell())) return false;
 
     return this->_do_move();
 }
@@ -191,7 +191,7 @@ bool RoleChainTransporter::do_move_if_threatened(bool last_chain_only) {
     }
 
     // If miner is threatened and on the move, this is no longer a high priority action
-    if (board.sim0() && this->target_unit->move_risk(this->target_unit->cell())) return false;
+    if (board().sim0() && this->target_unit->move_risk(this->target_unit->cell())) return false;
 
     Cell *cur_cell = this->unit->cell();
     if (cur_cell == this->target_cell
@@ -217,9 +217,9 @@ bool RoleChainTransporter::do_dig() {
     Cell *cur_cell = this->unit->cell();
     if (cur_cell == this->target_cell
         && this->unit->power >= 2 * this->unit->cfg->DIG_COST
-        && cur_cell->rubble > 0
+        && cur_cell->rubble() > 0
         && cur_cell->away_dist >= 10
-        && board.sim_step >= 50
+        && board().sim_step >= 50
         && this->unit->power >= this->unit->dig_cost()) {
         this->unit->do_dig();
         return true;
@@ -302,7 +302,7 @@ bool RoleChainTransporter::do_transfer() {
                       - miner_bound_unit->power_delta
                       - miner_bound_unit->power_gain());
         int dist = this->target_cell->man_dist_factory(this->get_factory());
-        int power_gain = this->unit->power_gain(board.sim_step, board.sim_step + dist);
+        int power_gain = this->unit->power_gain(board().sim_step, board().sim_step + dist);
         int power_to_keep = (this->unit->cfg->ACTION_QUEUE_POWER_COST
                              + 3 * this->unit->cfg->MOVE_COST
                              + 6 * dist * this->unit->cfg->MOVE_COST
@@ -320,8 +320,8 @@ bool RoleChainTransporter::do_transfer() {
 }
 
 bool RoleChainTransporter::do_pickup() {
-    if (this->chain_idx == 0) LUX_ASSERT(this->target_cell->factory);
-    if (this->target_cell->factory) LUX_ASSERT(this->chain_idx == 0);
+    if (this->chain_idx == 0) LUX_ASSERT(this->target_cell->factory());
+    if (this->target_cell->factory()) LUX_ASSERT(this->chain_idx == 0);
 
     if (this->goal_type == 'f') {
         return this->_do_power_pickup();
@@ -333,7 +333,7 @@ bool RoleChainTransporter::do_pickup() {
 
         // Skip pickup if miner has sufficient power
         int digs_remaining = this->target_unit->power / this->target_unit->cfg->DIG_COST;
-        int power_gain = this->target_unit->power_gain(board.sim_step, board.sim_step+digs_remaining);
+        int power_gain = this->target_unit->power_gain(board().sim_step, board().sim_step+digs_remaining);
         digs_remaining = (this->target_unit->power + power_gain) / this->target_unit->cfg->DIG_COST;
         if (digs_remaining >= 8 + (int)role_miner->chain_route.size() - 1) return false;
 
@@ -7,6 +7,7 @@
 #include "lux/exception.hpp"
 #include "lux/log.hpp"
 #include "lux/mode_ice_conflict.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/role_antagonizer.hpp"
 #include "lux/role_attacker.hpp"
 #include "lux/role_blockade.hpp"
@@ -45,7 +46,7 @@ bool RoleCow::from_lowland_route(Role **new_role, Unit *_unit,
             && route->back()->lowland_size >= min_size) {
             for (Cell *route_cell : *route) {
                 if (!route_cell->assigned_unit
-                    && route_cell->rubble > 0) {
+                    && route_cell->rubble() > 0) {
                     *new_role = new RoleCow(_unit, factory, route_cell);
                     return true;
                 }
@@ -91,7 +92,7 @@ bool RoleCow::from_resource_route(Role **new_role, Unit *_unit, Resource resourc
 
         for (Cell *route_cell : *route) {
             if (!route_cell->assigned_unit
-                && route_cell->rubble > 0
+                && route_cell->rubble() > 0
                 && route_cell->away_dist >= 3) {
                 *new_role = new RoleCow(_unit, factory, route_cell);
                 return true;
@@ -119,7 +120,7 @@ bool RoleCow::from_lichen_frontier(Role **new_role, Unit *_unit,
     Cell *best_cell = NULL;
     double min_cost = INT_MAX;
     for (Cell *c : factory->lichen_rubble_boundary_cells) {
-        if (c->rubble > max_rubble
+        if (c->rubble() > max_rubble
             || c->assigned_unit
             || c->man_dist_factory(factory) > max_dist) continue;
         int dist_unit_to_cell = cur_cell->man_dist(c);
@@ -128,7 +129,7 @@ bool RoleCow::from_lichen_frontier(Role **new_role, Unit *_unit,
         double total_dist = (dist_unit_to_cell
                              + dist_cell_to_factory
                              - 0.25 * dist_cell_to_opp_factory);
-        int dig_count = ((c->rubble + _unit->cfg->DIG_RUBBLE_REMOVED - 1)
+        int dig_count = ((c->rubble() + _unit->cfg->DIG_RUBBLE_REMOVED - 1)
                          / _unit->cfg->DIG_RUBBLE_REMOVED);
         double cost = (_unit->cfg->MOVE_COST * total_dist
                        + _unit->cfg->DIG_COST * dig_count);
@@ -157,8 +158,8 @@ bool RoleCow::from_lichen_bottleneck(Role **new_role, Unit *_unit,
     for (Cell *c : factory->lichen_bottleneck_cells) {
         if (c->lichen_bottleneck_cell_count <= 1) continue;
         for (Cell *neighbor : c->neighbors) {
-            if (neighbor->rubble <= 0
-                || neighbor->rubble < min_rubble
+            if (neighbor->rubble() <= 0
+                || neighbor->rubble() < min_rubble
                 || (neighbor->assigned_unit
                     && (neighbor->assigned_unit->heavy || !_unit->heavy))
                 || neighbor->man_dist_factory(factory) > max_dist) continue;
@@ -168,7 +169,7 @@ bool RoleCow::from_lichen_bottleneck(Role **new_role, Unit *_unit,
             double total_dist = (dist_unit_to_cell
                                  + dist_cell_to_factory
                                  - 0.25 * dist_cell_to_opp_factory);
-            int dig_count = ((c->rubble + _unit->cfg->DIG_RUBBLE_REMOVED - 1)
+            int dig_count = ((c->rubble() + _unit->cfg->DIG_RUBBLE_REMOVED - 1)
                              / _unit->cfg->DIG_RUBBLE_REMOVED);
             double cost = (_unit->cfg->MOVE_COST * total_dist
                            + _unit->cfg->DIG_COST * dig_count);
@@ -196,17 +197,17 @@ bool RoleCow::from_custom_route(Role **new_role, Unit *_unit, Cell *target_cell,
             >= max_count)) return false;
 
     vector<Cell*> route;
-    board.pathfind(_unit, target_cell, factory->cell, NULL,
-                   [&](Cell *c) { return c->factory; },
-                   [&](Cell *c, Unit *u) { (void)u; return 20 + c->rubble; },
-                   &route);
+    board().pathfind_t(_unit, target_cell, factory->cell, PathNone(),
+                     [&](Cell *c) { return c->factory(); },
+                     [&](Cell *c, Unit *u) { (void)u; return 20 + c->rubble(); },
+                     &route);
 
     Cell *best_cell = NULL;
     int min_dist = INT_MAX;
     for (Cell *cell : route) {
         int dist = cell->man_dist_factory(factory);
         if (dist < min_dist
-            && cell->rubble > 0
+            && cell->rubble() > 0
             && !cell->assigned_unit
             && !_unit->threat_units(cell, /*steps*/2, /*radius*/1)) {
             min_dist = dist;
@@ -234,13 +235,13 @@ bool RoleCow::from_lichen_repair(Role **new_role, Unit *_unit, int max_dist, int
     for (int i = factory->pillage_cell_steps.size() - 1; i >= 0; i--) {
         Cell *cell = factory->pillage_cell_steps[i].first;
         int step = factory->pillage_cell_steps[i].second;
-        if (step < board.step - 50) break;
+        if (step < board().step - 50) break;
 
-        if (cell->rubble > 0
+        if (cell->rubble() > 0
             && cell->man_dist_factory(factory) <= max_dist
             && (!cell->assigned_unit
                 || (_unit->heavy && !cell->assigned_unit->heavy))) {
-            int steps = _unit->cell()->man_dist(cell) + cell->rubble / _unit->cfg->DIG_RUBBLE_REMOVED;
+            int steps = _unit->cell()->man_dist(cell) + cell->rubble() / _unit->cfg->DIG_RUBBLE_REMOVED;
             if (steps < min_steps) {
                 min_steps = steps;
                 best_cell = cell;
@@ -259,7 +260,7 @@ bool RoleCow::from_lichen_repair(Role **new_role, Unit *_unit, int max_dist, int
 
 bool RoleCow::from_transition_lichen_repair(Role **new_role, Unit *_unit, int max_count) {
     //if (_unit->_log_cond()) LUX_LOG("RoleCow::from_transition_lichen_repair A");
-    if (!board.sim0() || board.sim_step < 200) return false;
+    if (!board().sim0() || board().sim_step < 200) return false;
 
     Factory *factory = _unit->assigned_factory;
 
@@ -316,13 +317,13 @@ bool RoleCow::from_transition_lichen_repair(Role **new_role, Unit *_unit, int ma
     while (cell) {
         int dist = cur_cell->man_dist(cell);
         if (dist <= 8
-            && cell->rubble > 0
-            && cell->rubble <= 20
+            && cell->rubble() > 0
+            && cell->rubble() <= 20
             && !cell->ice
             && !cell->ore
             && (!cell->assigned_unit
                 || (_unit->heavy && !cell->assigned_unit->heavy))) {
-            int steps = dist + cell->rubble / _unit->cfg->DIG_RUBBLE_REMOVED;
+            int steps = dist + cell->rubble() / _unit->cfg->DIG_RUBBLE_REMOVED;
             if (steps < min_steps) {
                 min_steps = steps;
                 best_cell = cell;
@@ -379,7 +380,7 @@ void RoleCow::teardown() {
 
 bool RoleCow::is_valid() {
     bool is_valid = (this->factory->alive()
-                     && this->rubble_cell->rubble > 0);
+                     && this->rubble_cell->rubble() > 0);
 
     // Heavies should revert to ice mining if water runs low
     if (is_valid
@@ -418,7 +419,7 @@ void RoleCow::update_goal() {
             power_threshold = (this->unit->cfg->ACTION_QUEUE_POWER_COST
                                + 3 * this->unit->cfg->MOVE_COST
                                + 2 * this->unit->cfg->DIG_COST
-                               + this->rubble_cell->rubble);
+                               + this->rubble_cell->rubble());
         } else {
             power_threshold = 10 * this->unit->cfg->DIG_COST;
         }
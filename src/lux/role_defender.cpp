@@ -64,12 +64,12 @@ bool RoleDefender::from_unit(Role **new_role, Unit *_unit, int max_dist) {
 
     // Second try to station in a low-rubble area between our factory and theirs
     max_dist = MAX(max_dist, 2 * factory->cell->away_dist / 3);
-    Factory *nearest_opp_factory = factory->cell->nearest_factory(board.opp);
-    Cell *mid_cell = board.cell((factory->x + nearest_opp_factory->x) / 2,
+    Factory *nearest_opp_factory = factory->cell->nearest_factory(board().opp);
+    Cell *mid_cell = board().cell((factory->x + nearest_opp_factory->x) / 2,
                                 (factory->y + nearest_opp_factory->y) / 2);
     Cell *cell = mid_cell->radius_cell(SIZE / 2);
     while (cell) {
-        if (cell->rubble < 40
+        if (cell->rubble() < 40
             && !cell->assigned_unit
             && cell->home_dist > 1
             && cell->away_dist > 1
@@ -101,7 +101,7 @@ Factory *RoleDefender::get_factory() {
 }
 
 double RoleDefender::power_usage() {
-    if (this->unit->cell()->factory == this->factory) return this->unit->cfg->CHARGE;
+    if (this->unit->cell()->factory() == this->factory) return this->unit->cfg->CHARGE;
     return 0;
 }
 
@@ -144,8 +144,8 @@ Cell *RoleDefender::goal_cell() {
     if (this->goal_type == 'c') {
         // No need to push friend
         if (this->unit->cell()->man_dist(this->target_cell) == 1
-            && this->target_cell->unit
-            && !this->target_cell->unit->cell_next()) {
+            && this->target_cell->unit()
+            && !this->target_cell->unit()->cell_next()) {
             return this->unit->cell();
         }
         return this->target_cell;
@@ -179,7 +179,7 @@ bool RoleDefender::do_move() {
         this->unit->cfg->ACTION_QUEUE_POWER_COST
         + 3 * this->unit->cfg->MOVE_COST
         + 6 * this->unit->cfg->MOVE_COST
-        + board.naive_cost(this->unit, this->unit->cell(), this->factory->cell));
+        + board().naive_cost(this->unit, this->unit->cell(), this->factory->cell));
     if (this->unit->power >= power_threshold) {
         return this->_do_move();
     }
@@ -190,8 +190,8 @@ bool RoleDefender::do_dig() {
     // Do very small touchup jobs if near target
     Cell *cur_cell = this->unit->cell();
     if (this->goal_type == 'c'
-        && cur_cell->rubble > 0
-        && cur_cell->rubble <= this->unit->cfg->DIG_RUBBLE_REMOVED
+        && cur_cell->rubble() > 0
+        && cur_cell->rubble() <= this->unit->cfg->DIG_RUBBLE_REMOVED
         && cur_cell->man_dist(this->target_cell) <= 1) {
         if (this->unit->power >= this->unit->dig_cost()) {
             this->unit->do_dig();
@@ -207,13 +207,13 @@ bool RoleDefender::do_transfer() {
     // Transfer power to ally if possible
     if (this->goal_type == 'c') {
         for (Cell *neighbor : cur_cell->neighbors) {
-            if (neighbor->unit_next
-                && RoleRecharge::cast(neighbor->unit_next->role)) {
+            if (neighbor->unit_next()
+                && RoleRecharge::cast(neighbor->unit_next()->role)) {
                 int amount = (
-                    neighbor->unit_next->cfg->BATTERY_CAPACITY
-                    - neighbor->unit_next->power
-                    - neighbor->unit_next->power_delta
-                    - neighbor->unit_next->power_gain());
+                    neighbor->unit_next()->cfg->BATTERY_CAPACITY
+                    - neighbor->unit_next()->power
+                    - neighbor->unit_next()->power_delta
+                    - neighbor->unit_next()->power_gain());
                 int power_to_keep = (
                     this->unit->cfg->ACTION_QUEUE_POWER_COST
                     + 3 * this->unit->cfg->MOVE_COST
@@ -222,7 +222,7 @@ bool RoleDefender::do_transfer() {
                 if (amount > 0) {
                     if (this->unit->power
                         >= this->unit->transfer_cost(neighbor, Resource_POWER, amount)) {
-                        //if (board.sim0()) LUX_LOG(*this->unit << " def tx " << *neighbor->unit_next);
+                        //if (board().sim0()) LUX_LOG(*this->unit << " def tx " << *neighbor->unit_next);
                         this->unit->do_transfer(neighbor, Resource_POWER, amount);
                         return true;
                     }
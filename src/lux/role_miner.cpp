@@ -10,6 +10,7 @@
 #include "lux/log.hpp"
 #include "lux/mode.hpp"
 #include "lux/mode_ice_conflict.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/role_antagonizer.hpp"
 #include "lux/role_attacker.hpp"
 #include "lux/role_chain_transporter.hpp"
@@ -45,7 +46,7 @@ RoleMiner::RoleMiner(Unit *_unit, Factory *_factory, Cell *_resource_cell, vecto
 bool RoleMiner::from_resource(Role **new_role, Unit *_unit, Resource resource,
                               int max_dist, int max_chain_dist, int max_count) {
     if (resource == Resource_ORE
-        && board.sim_step >= END_PHASE - 15) return false;
+        && board().sim_step >= END_PHASE - 15) return false;
     //if (_unit->_log_cond()) LUX_LOG("RoleMiner::from_resource A " << max_dist);
 
     Factory *factory = _unit->assigned_factory;
@@ -123,7 +124,7 @@ bool RoleMiner::from_resource(Role **new_role, Unit *_unit, Resource resource,
                 }
             }
 
-            //if (board.sim0() && _unit->id == 48 && cell->ice) {
+            //if (board().sim0() && _unit->id == 48 && cell->ice) {
             //    LUX_LOG("RM::from_resource " << *cell << ' ' << (bool)route_ptr << ' ' << score);
             //}
 
@@ -153,7 +154,7 @@ bool RoleMiner::from_transition_to_uncontested_ice(Role **new_role, Unit *_unit)
     //if (_unit->_log_cond()) LUX_LOG("RoleMiner::from_transition_to_uncontested_ice A");
 
     RoleMiner *role;
-    if (!board.sim0()
+    if (!board().sim0()
         || !_unit->antagonizer_unit
         || !(role = RoleMiner::cast(_unit->role))
         || !role->resource_cell->ice
@@ -175,7 +176,7 @@ bool RoleMiner::from_transition_to_uncontested_ice(Role **new_role, Unit *_unit)
 
             // assigned_unit checks don't work when this is called from a Mode transition function
             bool cell_assigned = false;
-            for (Unit *other_unit : board.player->units()) {
+            for (Unit *other_unit : board().player->units()) {
                 if (other_unit == _unit || !other_unit->heavy) continue;
                 if (RoleMiner::cast(other_unit->role)
                     && RoleMiner::cast(other_unit->role)->resource_cell == ice_cell) {
@@ -237,7 +238,7 @@ bool RoleMiner::from_transition_to_closer_ice(Role **new_role, Unit *_unit) {
     }
 
     if (best_cell) {
-        if (board.sim0()) {
+        if (board().sim0()) {
             LUX_LOG(*_unit << " change ice cell from " << *role->resource_cell
                     << " to closer " << *best_cell);
         }
@@ -256,8 +257,8 @@ bool RoleMiner::from_transition_to_ore(Role **new_role, Unit *_unit, int max_dis
     //if (_unit->_log_cond()) LUX_LOG("RoleMiner::from_transition_to_ore A");
 
     Factory *factory = _unit->assigned_factory;
-    if (board.sim_step < 25
-        || board.sim_step >= END_PHASE - 15
+    if (board().sim_step < 25
+        || board().sim_step >= END_PHASE - 15
         || factory->heavy_ore_miner_count > 0) return false;
 
     // Some roles/situations should not transition to ore mining
@@ -339,10 +340,10 @@ bool RoleMiner::from_transition_to_ore(Role **new_role, Unit *_unit, int max_dis
     int power_gain = 0;
     int extra_power = 0;
     if (ore_cell_dist > 1 && !chain_route_ptr) {
-        rubble_digs = ((ore_cell->rubble + _unit->cfg->DIG_RUBBLE_REMOVED - 1)
+        rubble_digs = ((ore_cell->rubble() + _unit->cfg->DIG_RUBBLE_REMOVED - 1)
                            / _unit->cfg->DIG_RUBBLE_REMOVED);
         int total_steps = 2 * ore_cell_dist + rubble_digs + ore_digs;
-        power_gain = _unit->power_gain(board.sim_step, board.sim_step + total_steps);
+        power_gain = _unit->power_gain(board().sim_step, board().sim_step + total_steps);
         extra_power = (
             _unit->cfg->ACTION_QUEUE_POWER_COST
             + _unit->cfg->DIG_COST
@@ -388,8 +389,13 @@ bool RoleMiner::from_transition_to_ore(Role **new_role, Unit *_unit, int max_dis
 
     // Power check #3
     if (ore_cell_dist > 1 && !chain_route_ptr) {
-        int cost_to = board.pathfind(_unit, _unit->cell(), ore_cell);
-        int cost_from = board.pathfind(_unit, ore_cell, factory->cell);
+        int cost_to = board().pathfind(_unit, _unit->cell(), ore_cell);
+        // The field may end on factory cells assigned to other units, which pathfind never does
+        bool blocked = false;
+        for (Cell *fcell : factory->cells) blocked |= (fcell->assigned_unit && fcell->assigned_unit != _unit);
+        int cost_from = (blocked
+                         ? board().pathfind(_unit, ore_cell, factory->cell)
+                         : board().cost_field(factory, _unit->heavy ? CostField_HEAVY : CostField_LIGHT)->cost_from(ore_cell));
         if (cost_to == INT_MAX || cost_from == INT_MAX) return false;
         power_threshold = (
             2 * _unit->cfg->ACTION_QUEUE_POWER_COST
@@ -427,10 +433,10 @@ bool RoleMiner::get_chain_route(Unit *unit, Cell *resource_cell, int max_dist, v
     if (available_lights < 2) return false;
     max_dist = MIN(max_dist, available_lights);
 
-    int cost = board.pathfind(
-        unit, resource_cell, unit->assigned_factory->cell, NULL,
+    int cost = board().pathfind_t(
+        unit, resource_cell, unit->assigned_factory->cell, PathNone(),
         // Avoid factories and heavy non-defenders
-        [&](Cell *c) { return (c->factory
+        [&](Cell *c) { return (c->factory()
                                || (c->assigned_unit
                                    && c->assigned_unit != unit
                                    && c->assigned_unit->heavy
@@ -438,7 +444,7 @@ bool RoleMiner::get_chain_route(Unit *unit, Cell *resource_cell, int max_dist, v
         [&](Cell *c, Unit *u) { (void)u;
             return (100
                     - MIN(15, c->away_dist)  // want high away_dist
-                    + int(1 <= c->rubble && c->rubble <= 19)  // want flat/hi rubble
+                    + int(1 <= c->rubble() && c->rubble() <= 19)  // want flat/hi rubble
                     + 200 * int(c->ice || c->ore));  // want non-resource
         },
         route,
@@ -451,7 +457,7 @@ bool RoleMiner::get_chain_route(Unit *unit, Cell *resource_cell, int max_dist, v
 }
 
 int RoleMiner::power_ok_steps(Unit *unit, Factory *factory) {
-    int current_step = 1000 * board.step + board.sim_step;
+    int current_step = 1000 * board().step + board().sim_step;
     RoleMiner *role_miner = RoleMiner::cast(unit->role);
 
     // Return cached result if possible
@@ -471,7 +477,7 @@ int RoleMiner::power_ok_steps(Unit *unit, Factory *factory) {
 
     // Cache results in role object if it exists
     if (role_miner) {
-        //if (board.sim0()) LUX_LOG("power ok " << *unit << ' ' << power << ' '
+        //if (board().sim0()) LUX_LOG("power ok " << *unit << ' ' << power << ' '
         //                          << power_usage << ' ' << power_gain << ' ' << steps_remaining);
         role_miner->_power_ok_steps = steps_remaining;
         role_miner->_power_ok_steps_step = current_step;
@@ -514,10 +520,10 @@ double RoleMiner::resource_cell_score(Unit *unit, Cell *cell, int max_dist, vect
         cost = dist * unit->cfg->MOVE_COST;
     } else {
         vector<Cell*> commute_route;
-        cost = board.pathfind(
+        cost = board().pathfind_t(
             unit, cell, factory->cell,
             [&](Cell *c) {
-                if (c->factory == factory) {
+                if (c->factory() == factory) {
                     if (c->assigned_unit) {
                         if (unit->heavy && c->man_dist(cell) == 1) {
                             // Ok if this is an adj heavy miner displacing a light CT
@@ -542,11 +548,11 @@ double RoleMiner::resource_cell_score(Unit *unit, Cell *cell, int max_dist, vect
             },
             [&](Cell *c) {
                 // Avoid factories and non-defenders
-                return (c->factory
+                return (c->factory()
                         || (c->assigned_unit
                             && c->assigned_unit != unit
                             && !RoleDefender::cast(c->assigned_unit->role))); },
-            NULL, &commute_route, max_dist);
+            PathNone(), &commute_route, max_dist);
 
         // Bad route: return min score
         if (cost == INT_MAX) {
@@ -568,20 +574,20 @@ double RoleMiner::resource_cell_score(Unit *unit, Cell *cell, int max_dist, vect
     } else {
         score = -1 * (1.0 * dist + 1.0 * cost / (double)unit->cfg->MOVE_COST) / 2.0;
     }
-    //if (board.sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreA " << *cell << ' ' << score);
+    //if (board().sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreA " << *cell << ' ' << score);
 
     // TODO: maybe a box_out bonus (own factory is between resource and its nearest opp factory)
     // TODO: subtract more for chains near opp dist / traffic
 
     // Avoid opp-traffic'd cells
-    PDD traffic_score = cell->get_traffic_score(board.opp, /*neighbors*/true);
+    PDD traffic_score = cell->get_traffic_score(board().opp, /*neighbors*/true);
     score -= 3 * traffic_score.first;
     if (route || !unit->heavy) score -= 3 * traffic_score.second;
-    //if (board.sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreB " << *cell << ' ' << score);
+    //if (board().sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreB " << *cell << ' ' << score);
 
     // Avoid contested cells as a rough tie-breaker
     if (cell->is_contested()) score -= 0.25;
-    //if (board.sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreC " << *cell << ' ' << score);
+    //if (board().sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreC " << *cell << ' ' << score);
 
     // Want low cost/dist, high opp dist, really don't want opp_dist=1
     int opp_dist = cell->away_dist;
@@ -590,7 +596,7 @@ double RoleMiner::resource_cell_score(Unit *unit, Cell *cell, int max_dist, vect
     if      (dist == 1)     score +=  7 + opp_dist_near + 0.1 * opp_dist_far;
     else if (opp_dist == 1) score += -4;
     else                    score += opp_dist_near + 0.1 * opp_dist_far;
-    //if (board.sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreD " << *cell << ' ' << score);
+    //if (board().sim0() && unit->id == 48 && cell->ice) LUX_LOG("RM::scoreD " << *cell << ' ' << score);
 
     // Try not to chain-mine an ore cell that is convenient for another own factory
     if (cell->ore) {  // TODO: && route?
@@ -613,7 +619,7 @@ double RoleMiner::resource_cell_score(Unit *unit, Cell *cell, int max_dist, vect
 
 bool RoleMiner::factory_needs_water(Factory *factory, int steps, Unit *skip_unit) {
     LUX_ASSERT(factory);
-    if (board.sim_step + steps > 1000) steps -= (board.sim_step + steps - 1000) / 2;
+    if (board().sim_step + steps > 1000) steps -= (board().sim_step + steps - 1000) / 2;
     int factory_water = factory->total_water();
     if (factory_water >= 300) {
         int water_income_without_unit = factory->water_income(skip_unit);
@@ -629,7 +635,7 @@ bool RoleMiner::_is_patient() {
     if (!this->power_transporter && this->chain_route.empty()) return false;
 
     // Check that standing still is safe
-    if (board.sim0() && this->unit->move_risk(this->unit->cell())) return false;
+    if (board().sim0() && this->unit->move_risk(this->unit->cell())) return false;
 
     return ((this->protector && this->_transporters_exist(/*dist*/0))
             || (this->power_transporter && this->_transporters_exist(/*dist*/0))
@@ -637,7 +643,7 @@ bool RoleMiner::_is_patient() {
 }
 
 bool RoleMiner::_ore_chain_is_paused() {
-    int light_lim = 14 + board.sim_step / 100;
+    int light_lim = 14 + board().sim_step / 100;
     int light_count = this->factory->lights.size();
 
     bool is_paused = (this->unit->heavy
@@ -825,7 +831,7 @@ bool RoleMiner::is_valid() {
 
     // Stop mining ore during the final game phase
     if (this->resource_cell->ore
-        && board.sim_step >= END_PHASE + 20) return false;
+        && board().sim_step >= END_PHASE + 20) return false;
 
     bool is_paused = this->_ore_chain_is_paused();
 
@@ -922,7 +928,7 @@ Cell *RoleMiner::goal_cell() {
     if (this->goal_type == 'c') return this->resource_cell;
 
     // Goal is factory
-    if (this->unit->heavy && cur_cell->factory != this->factory) {
+    if (this->unit->heavy && cur_cell->factory() != this->factory) {
         Cell *fcell = this->factory->cell_toward(cur_cell);
         RolePowerTransporter *role;
         if (!fcell->assigned_unit  // no one
@@ -960,17 +966,17 @@ void RoleMiner::update_goal() {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 3 * this->unit->cfg->MOVE_COST  // Necessary? Consistent with low_power baseline
-                + board.naive_cost(this->unit, cur_cell, this->resource_cell)
+                + board().naive_cost(this->unit, cur_cell, this->resource_cell)
                 + this->unit->cfg->DIG_COST
-                + board.naive_cost(this->unit, this->resource_cell, this->factory->cell));
+                + board().naive_cost(this->unit, this->resource_cell, this->factory->cell));
         } else if (resource_dist <= 5) {
             //if (this->unit->_log_cond()) LUX_LOG("RoleMiner::update_goal B");
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 3 * this->unit->cfg->MOVE_COST  // Necessary? Consistent with low_power baseline
-                + board.naive_cost(this->unit, cur_cell, this->resource_cell)
+                + board().naive_cost(this->unit, cur_cell, this->resource_cell)
                 + this->unit->cfg->DIG_COST
-                + board.naive_cost(this->unit, this->resource_cell, this->factory->cell));
+                + board().naive_cost(this->unit, this->resource_cell, this->factory->cell));
         }
         power_threshold = MIN(power_threshold, 0.5 * this->unit->cfg->BATTERY_CAPACITY);
         //if (this->unit->_log_cond()) LUX_LOG("RoleMiner::update_goal c->f " << power_threshold);
@@ -981,7 +987,7 @@ void RoleMiner::update_goal() {
         }
 
         // Return to factory early if low power and threatened by opp
-        else if (board.sim0()
+        else if (board().sim0()
                  && this->unit->low_power
                  && this->unit->move_risk(cur_cell) > 0) {
             this->goal_type = 'f';
@@ -1006,15 +1012,15 @@ void RoleMiner::update_goal() {
         }
 
         // Deliver ice to factory early if we have ice and game is almost over
-        else if (board.sim_step + resource_dist >= ICE_RUSH_PHASE
+        else if (board().sim_step + resource_dist >= ICE_RUSH_PHASE
                  && this->unit->ice >= 4 * this->unit->cfg->DIG_RESOURCE_GAIN) {
             this->goal_type = 'f';
             this->goal = this->factory;
         }
 
         // Deliver ice to factory early if we are an early-game solo heavy ice miner
-        else if (board.sim_step < 200
-                 && board.sim_step % 3 == 0
+        else if (board().sim_step < 200
+                 && board().sim_step % 3 == 0
                  && this->resource_cell->ice
                  && this->unit->ice
                  && this->unit->heavy
@@ -1050,9 +1056,9 @@ void RoleMiner::update_goal() {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 3 * this->unit->cfg->MOVE_COST  // Necessary? Consistent with low_power baseline
-                + board.naive_cost(this->unit, cur_cell, this->resource_cell)
+                + board().naive_cost(this->unit, cur_cell, this->resource_cell)
                 + 2 * this->unit->cfg->DIG_COST
-                + board.naive_cost(this->unit, this->resource_cell, this->factory->cell));
+                + board().naive_cost(this->unit, this->resource_cell, this->factory->cell));
         } else if (this->factory->power >= 5000) {
             //if (this->unit->_log_cond()) LUX_LOG("RoleMiner::update_goal E");
             power_threshold = 0.95 * this->unit->cfg->BATTERY_CAPACITY;
@@ -1061,9 +1067,9 @@ void RoleMiner::update_goal() {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 3 * this->unit->cfg->MOVE_COST  // Necessary? Consistent with low_power baseline
-                + board.naive_cost(this->unit, cur_cell, this->resource_cell)
+                + board().naive_cost(this->unit, cur_cell, this->resource_cell)
                 + 6 * this->unit->cfg->DIG_COST
-                + board.naive_cost(this->unit, this->resource_cell, this->factory->cell));
+                + board().naive_cost(this->unit, this->resource_cell, this->factory->cell));
         }
         power_threshold = MIN(power_threshold, 0.95 * this->unit->cfg->BATTERY_CAPACITY);
         //if (this->unit->_log_cond()) LUX_LOG("RoleMiner::update_goal f->c " << power_threshold);
@@ -1111,9 +1117,9 @@ bool RoleMiner::do_dig() {
             return false;
         }
         // Throttle ice mining power usage if there's an ore miner?
-        //if (board.sim_step >= 200
-        //    && board.sim_step < 800
-        //    && board.sim_step % 4 == 0
+        //if (board().sim_step >= 200
+        //    && board().sim_step < 800
+        //    && board().sim_step % 4 == 0
         //    && this->factory->heavy_ore_miner_count > 0
         //    && this->factory->power < 2 * this->factory->power_gain()
         //    && this->_transporters_exist()
@@ -1144,7 +1150,7 @@ bool RoleMiner::_do_excess_power_transfer() {
         amount = (amount / 10) * 10;  // round down to nearest 10
         if (amount > 0
             && this->unit->power >= this->unit->transfer_cost(tx_cell, Resource_POWER, amount)) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *this->unit->role
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *this->unit->role
                                       << " miner excess power tx " << amount << ' '
                                       << (cur_cell == this->resource_cell));
             this->unit->do_transfer(tx_cell, Resource_POWER, amount);
@@ -50,13 +50,13 @@ bool RolePillager::from_lichen(Role **new_role, Unit *_unit, int max_dist, int m
         max_dist = RolePillager::cast(_unit->role)->lichen_cell->man_dist_factory(factory) + 5;
     }
 
-    int steps_remaining = 1000 - board.sim_step;
+    int steps_remaining = 1000 - board().sim_step;
     Cell *cur_cell = _unit->cell();
     bool cur_near_factory = cur_cell->man_dist_factory(factory) <= max_dist;
 
     Cell *best_cell = NULL;
     double best_score = INT_MIN;
-    for (Factory *opp_factory : board.opp->factories()) {
+    for (Factory *opp_factory : board().opp->factories()) {
         for (Cell *cell : opp_factory->lichen_connected_cells) {
             int cur_cell_dist = cell->man_dist(cur_cell);
             if (cell->man_dist_factory(factory) > max_dist
@@ -64,14 +64,14 @@ bool RolePillager::from_lichen(Role **new_role, Unit *_unit, int max_dist, int m
 
             // Check if significant bottleneck is required
             if (_bn
-                && (cell->lichen_bottleneck_step != board.step
+                && (cell->lichen_bottleneck_step != board().step
                     || cell->lichen_bottleneck_cell_count < 25)) continue;
 
             Unit *assigned_unit = cell->assigned_unit;
             if (cur_cell_dist <= steps_remaining - 1
                 && (!assigned_unit
                     || (_unit->heavy && !assigned_unit->heavy)
-                    || (board.final_night()
+                    || (board().final_night()
                         && _unit->heavy == assigned_unit->heavy
                         && _unit->power >= _unit->cfg->DIG_COST
                         && (assigned_unit->power < assigned_unit->cfg->DIG_COST
@@ -92,17 +92,17 @@ bool RolePillager::from_lichen(Role **new_role, Unit *_unit, int max_dist, int m
     }
 
     // During endgame also check for dist-1 boundary cells in some cases
-    if (_bn || board.sim_step < END_PHASE) return false;
+    if (_bn || board().sim_step < END_PHASE) return false;
     if (_unit->heavy && max_dist < 100) return false;
     if (RolePillager::cast(_unit->role)
         && RolePillager::cast(_unit->role)->lichen_cell->away_dist == 1) return false;
 
     best_cell = NULL;
     best_score = INT_MIN;
-    for (Factory *opp_factory : board.opp->factories()) {
+    for (Factory *opp_factory : board().opp->factories()) {
         Cell *cell = opp_factory->radius_cell(1);
         while (cell) {
-            if (cell->lichen <= 0 && !cell->ice && !cell->ore) {
+            if (cell->lichen() <= 0 && !cell->ice && !cell->ore) {
                 int cur_cell_dist = cell->man_dist(cur_cell);
                 Unit *assigned_unit = cell->assigned_unit;
                 if (cur_cell_dist <= steps_remaining - 1
@@ -110,7 +110,7 @@ bool RolePillager::from_lichen(Role **new_role, Unit *_unit, int max_dist, int m
                     && (cur_near_factory || cur_cell_dist <= max_dist)
                     && (!assigned_unit
                         || (_unit->heavy && !assigned_unit->heavy)
-                        || (board.final_night()
+                        || (board().final_night()
                             && _unit->heavy == assigned_unit->heavy
                             && _unit->power >= _unit->cfg->DIG_COST
                             && (assigned_unit->power < assigned_unit->cfg->DIG_COST
@@ -145,7 +145,7 @@ bool RolePillager::from_transition_active_pillager(Role **new_role, Unit *_unit,
 
     RolePillager *role;
     if (!(role = RolePillager::cast(_unit->role))
-        || role->lichen_cell->lichen > 0) {
+        || role->lichen_cell->lichen() > 0) {
         return false;
     }
 
@@ -154,7 +154,7 @@ bool RolePillager::from_transition_active_pillager(Role **new_role, Unit *_unit,
         bool more_work = false;
         for (Cell *neighbor : role->lichen_cell->neighbors) {
             if (neighbor->away_dist == 1
-                && neighbor->lichen > 0
+                && neighbor->lichen() > 0
                 && !neighbor->assigned_unit) {
                 more_work = true;
             }
@@ -164,7 +164,7 @@ bool RolePillager::from_transition_active_pillager(Role **new_role, Unit *_unit,
 
     // Displaced units may be set to nearby factory center
     int max_radius = (role->lichen_cell->factory_center ? 4 : 2);
-    int steps_remaining = 1000 - board.sim_step;
+    int steps_remaining = 1000 - board().sim_step;
     Cell *cur_cell = _unit->cell();
     for (int radius = 1; radius <= max_radius; radius++) {
         Cell *best_cell = NULL;
@@ -172,8 +172,8 @@ bool RolePillager::from_transition_active_pillager(Role **new_role, Unit *_unit,
         Cell *rc = role->lichen_cell->radius_cell(radius, radius);
         while (rc) {
             int cur_cell_dist = cur_cell->man_dist(rc);
-            if (rc->lichen > 0
-                && board.opp->is_strain(rc->lichen_strain)
+            if (rc->lichen() > 0
+                && board().opp->is_strain(rc->lichen_strain())
                 && (!rc->assigned_unit
                     || (_unit->heavy && !rc->assigned_unit->heavy))
                 && cur_cell_dist < steps_remaining - 1) {
@@ -187,7 +187,7 @@ bool RolePillager::from_transition_active_pillager(Role **new_role, Unit *_unit,
         }
 
         if (best_cell) {
-            //if (board.sim0()) LUX_LOG(*_unit << " RP transition " << *role->lichen_cell << ' '
+            //if (board().sim0()) LUX_LOG(*_unit << " RP transition " << *role->lichen_cell << ' '
             //                          << *best_cell);
             Role::_displace_unit(best_cell);
             *new_role = new RolePillager(_unit, role->factory, best_cell);
@@ -195,10 +195,10 @@ bool RolePillager::from_transition_active_pillager(Role **new_role, Unit *_unit,
         }
     }
 
-    if (board.sim_step < END_PHASE) {
+    if (board().sim_step < END_PHASE) {
         return RolePillager::from_lichen(new_role, _unit, max_dist);
     } else {
-        max_dist = (1000 - board.sim_step - 20);
+        max_dist = (1000 - board().sim_step - 20);
         return (RolePillager::from_transition_end_of_game(new_role, _unit, /*allow*/true)
                 || RoleAntagonizer::from_mine(new_role, _unit, Resource_ICE, max_dist)
                 || RoleDefender::from_unit(new_role, _unit, max_dist));
@@ -207,7 +207,7 @@ bool RolePillager::from_transition_active_pillager(Role **new_role, Unit *_unit,
 
 bool RolePillager::from_transition_end_of_game(Role **new_role, Unit *_unit, bool allow_pillager) {
     //if (_unit->_log_cond()) LUX_LOG("RolePillager::from_transition_end_of_game A");
-    if (board.sim_step < END_PHASE) return false;
+    if (board().sim_step < END_PHASE) return false;
 
     Factory *factory = _unit->assigned_factory;
 
@@ -249,14 +249,14 @@ bool RolePillager::from_transition_end_of_game(Role **new_role, Unit *_unit, boo
     int best_score = INT_MIN;
     Cell *cur_cell = _unit->cell();
     int unit_factory_dist = _unit->cell()->man_dist_factory(factory);
-    for (Factory *opp_factory : board.opp->factories()) {
+    for (Factory *opp_factory : board().opp->factories()) {
         for (Cell *cell : opp_factory->lichen_connected_cells) {
             if (cell->assigned_unit) continue;
             int factory_lichen_dist = cell->man_dist_factory(factory);
             int unit_lichen_dist = cur_cell->man_dist(cell);
-            int cushion = (board.final_night() ? 2 : 20);
-            int end_step = board.sim_step + cushion;
-            int score = cell->lichen - cell->lichen_dist;
+            int cushion = (board().final_night() ? 2 : 20);
+            int end_step = board().sim_step + cushion;
+            int score = cell->lichen() - cell->lichen_dist();
             if (unit_lichen_dist < unit_factory_dist) {
                 end_step += unit_lichen_dist;
                 score -= unit_lichen_dist / 5;
@@ -280,12 +280,12 @@ bool RolePillager::from_transition_end_of_game(Role **new_role, Unit *_unit, boo
 }
 
 double RolePillager::_cell_score(Unit *unit, Cell *cell) {
-    if (cell->lichen <= 0) return 0;
+    if (cell->lichen() <= 0) return 0;
 
-    int steps_remaining = 1000 - board.sim_step;
-    if (board.sim_step > 900
-        && cell->lichen_dist == INT_MAX  // disconnected
-        && steps_remaining >= cell->lichen) return 0.0001 * cell->lichen;
+    int steps_remaining = 1000 - board().sim_step;
+    if (board().sim_step > 900
+        && cell->lichen_dist() == INT_MAX  // disconnected
+        && steps_remaining >= cell->lichen()) return 0.0001 * cell->lichen();
 
     Cell *cur_cell = unit->cell();
     Factory *factory = unit->assigned_factory;
@@ -294,7 +294,7 @@ double RolePillager::_cell_score(Unit *unit, Cell *cell) {
     int dist_unit_to_factory = cur_cell->man_dist_factory(factory);
     int dist_cell_to_factory = cell->man_dist_factory(factory);
 
-    int cell_lichen = MIN(100, cell->lichen + dist_unit_to_cell);
+    int cell_lichen = MIN(100, cell->lichen() + dist_unit_to_cell);
     int digs_necessary = ((cell_lichen + unit->cfg->DIG_LICHEN_REMOVED - 1 )  // round up
                           / unit->cfg->DIG_LICHEN_REMOVED);
     cell_lichen = MIN(100, cell_lichen + digs_necessary);
@@ -323,17 +323,17 @@ double RolePillager::_cell_score(Unit *unit, Cell *cell) {
                                    (traffic_scores.first + (unit->heavy ? 0 : traffic_scores.second)));
 
     double cell_value = 1;
-    if (cell->lichen_bottleneck_step == board.step) {
+    if (cell->lichen_bottleneck_step == board().step) {
         if (cell->lichen_bottleneck_cell_count >= 2) cell_value += 1;
         if (cell->lichen_bottleneck_cell_count >= 5) cell_value += 1;
         if (cell->lichen_bottleneck_cell_count >= 10) cell_value += 1;
         if (cell->lichen_bottleneck_cell_count >= 25) cell_value += 1;
     }
-    if (cell->lichen_opp_boundary_step == board.step) cell_value += 2;
-    if (board.sim_step < END_PHASE) {
-        if (cell->lichen_frontier_step == board.step) cell_value += 1;
+    if (cell->lichen_opp_boundary_step == board().step) cell_value += 2;
+    if (board().sim_step < END_PHASE) {
+        if (cell->lichen_frontier_step == board().step) cell_value += 1;
     } else {
-        if (cell->lichen_dist <= 3) cell_value += 2;
+        if (cell->lichen_dist() <= 3) cell_value += 2;
     }
     if (cell->x % 2 == 0 && cell->y % 2 == 0) cell_value += 0.5;
 
@@ -353,7 +353,7 @@ Factory *RolePillager::get_factory() {
 }
 
 double RolePillager::power_usage() {
-    if (this->lichen_cell->lichen > 0) {
+    if (this->lichen_cell->lichen() > 0) {
         return (0.6 * this->unit->cfg->MOVE_COST
                 + 0.35 * this->unit->cfg->DIG_COST
                 + 0.2 * this->unit->cfg->ACTION_QUEUE_POWER_COST);
@@ -382,12 +382,12 @@ bool RolePillager::is_valid() {
     bool is_valid = this->factory->alive();
 
     if (is_valid
-        && board.player->is_strain(this->lichen_cell->lichen_strain)) {
+        && board().player->is_strain(this->lichen_cell->lichen_strain())) {
         is_valid = false;
     }
 
     if (is_valid
-        && this->unit->cell()->man_dist(this->lichen_cell) >= 1000 - board.sim_step - 1) {
+        && this->unit->cell()->man_dist(this->lichen_cell) >= 1000 - board().sim_step - 1) {
         is_valid = false;
     }
 
@@ -411,23 +411,23 @@ void RolePillager::update_goal() {
     } else if (this->goal_type == 'f') {  // Done with factory goal?
         Cell *cur_cell = this->unit->cell();
         int power_threshold = 0;
-        if (board.sim_step >= END_PHASE && this->factory->power < 500) {
+        if (board().sim_step >= END_PHASE && this->factory->power < 500) {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + this->unit->cfg->RAZE_COST
-                + board.naive_cost(this->unit, cur_cell, this->lichen_cell)
-                - this->unit->power_gain(board.sim_step, 1000));
-        } else if (board.sim_step >= END_PHASE) {
+                + board().naive_cost(this->unit, cur_cell, this->lichen_cell)
+                - this->unit->power_gain(board().sim_step, 1000));
+        } else if (board().sim_step >= END_PHASE) {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 6 * this->unit->cfg->DIG_COST
-                + board.naive_cost(this->unit, cur_cell, this->lichen_cell));
+                + board().naive_cost(this->unit, cur_cell, this->lichen_cell));
         } else {
             power_threshold = (
                 this->unit->cfg->ACTION_QUEUE_POWER_COST
                 + 6 * this->unit->cfg->DIG_COST
-                + board.naive_cost(this->unit, cur_cell, this->lichen_cell)
-                + board.naive_cost(this->unit, this->lichen_cell, this->factory->cell));
+                + board().naive_cost(this->unit, cur_cell, this->lichen_cell)
+                + board().naive_cost(this->unit, this->lichen_cell, this->factory->cell));
         }
         power_threshold = MIN(power_threshold, 0.95 * this->unit->cfg->BATTERY_CAPACITY);
         if (this->unit->power >= power_threshold) {
@@ -440,8 +440,8 @@ void RolePillager::update_goal() {
 }
 
 bool RolePillager::do_move() {
-    if ((this->lichen_cell->lichen > 0
-         || (board.sim_step >= END_PHASE
+    if ((this->lichen_cell->lichen() > 0
+         || (board().sim_step >= END_PHASE
              && this->unit->power >= 6 * this->unit->cfg->MOVE_COST))
         && this->_do_move()) {
         //if (this->unit->_log_cond()) LUX_LOG("RolePillager::do_move A");
@@ -455,22 +455,22 @@ bool RolePillager::do_move() {
 bool RolePillager::do_dig() {
     //if (this->unit->_log_cond()) LUX_LOG("RolePillager::do_dig A");
 
-    bool end_phase = (board.sim_step >= END_PHASE);
+    bool end_phase = (board().sim_step >= END_PHASE);
     Cell *cur_cell = this->unit->cell();
 
     if ((this->goal_type == 'c' && cur_cell == this->lichen_cell)
         || (this->unit->heavy && this->unit->cell()->man_dist_factory(this->factory) >= 30)
         || end_phase) {
-        if (cur_cell->lichen
-            && board.opp->is_strain(cur_cell->lichen_strain)
+        if (cur_cell->lichen()
+            && board().opp->is_strain(cur_cell->lichen_strain())
             && this->unit->power >= this->unit->cfg->DIG_COST) {
 
             // Try to destroy bottlenecks if possible
             if (end_phase
-                && board.sim_step < 970
-                && cur_cell->lichen_bottleneck_step == board.step) {
+                && board().sim_step < 970
+                && cur_cell->lichen_bottleneck_step == board().step) {
                 if (!this->unit->heavy
-                    && cur_cell->lichen > this->unit->cfg->DIG_LICHEN_REMOVED
+                    && cur_cell->lichen() > this->unit->cfg->DIG_LICHEN_REMOVED
                     && this->unit->power <= 2 * this->unit->cfg->RAZE_COST
                     && this->unit->power >= this->unit->self_destruct_cost()) {
                     this->unit->do_self_destruct();
@@ -484,7 +484,7 @@ bool RolePillager::do_dig() {
             // If endgame before 998, not at goal, and threatened, just return
             // Keep going to goal, then blow up or get killed there
             if (end_phase
-                && board.sim_step <= 997
+                && board().sim_step <= 997
                 && cur_cell != this->lichen_cell
                 && this->unit->threat_units(this->unit->cell(), 1, 1)) {
                 return false;
@@ -493,11 +493,11 @@ bool RolePillager::do_dig() {
             // If low power and a self-destruct could do more than digging for the rest of the game
             if (end_phase
                 && !this->unit->heavy) {
-                int steps_remaining = 1000 - board.sim_step;
+                int steps_remaining = 1000 - board().sim_step;
                 int digs_remaining = this->unit->power / this->unit->cfg->DIG_COST;
                 int max_lichen_by_digging = ((this->unit->cfg->DIG_LICHEN_REMOVED - 1)
                                              * MIN(steps_remaining, digs_remaining));
-                if (cur_cell->lichen > max_lichen_by_digging
+                if (cur_cell->lichen() > max_lichen_by_digging
                     && this->unit->power <= 2 * this->unit->cfg->RAZE_COST
                     && this->unit->power >= this->unit->self_destruct_cost()) {
                     this->unit->do_self_destruct();
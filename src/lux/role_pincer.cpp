@@ -7,6 +7,7 @@
 #include "lux/exception.hpp"
 #include "lux/log.hpp"
 #include "lux/mode_ice_conflict.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/role_antagonizer.hpp"
 #include "lux/role_miner.hpp"
 #include "lux/role_protector.hpp"
@@ -43,10 +44,10 @@ RolePincer::RolePincer(Unit *_unit, Factory *_factory, Unit *_target_unit,
 }
 
 void RolePincer::transition_units() {
-    LUX_ASSERT(board.sim0());
+    LUX_ASSERT(board().sim0());
 
     vector<Unit*> target_units;
-    for (Unit *u : board.opp->units()) {
+    for (Unit *u : board().opp->units()) {
         if (u->heavy
             && !u->low_power
             && !u->assigned_unit
@@ -55,9 +56,9 @@ void RolePincer::transition_units() {
 
     for (Unit *target_unit : target_units) {
         Cell *target_cell1 = target_unit->cell();
-        Cell *target_cell2 = target_unit->cell_at(board.step - 1);
+        Cell *target_cell2 = target_unit->cell_at(board().step - 1);
         vector<Unit*> nearby_units;
-        for (Unit *u : board.player->units()) {
+        for (Unit *u : board().player->units()) {
             // Role exceptions
             if (RolePincer::cast(u->role)
                 || (RoleMiner::cast(u->role)
@@ -114,11 +115,11 @@ void RolePincer::transition_units() {
         if (!best_route1.empty()) {
             Role *r1 = new RolePincer(
                 best_u1, best_u1->assigned_factory, target_unit, best_u2, best_route1.back(),
-                target_unit->cell(), target_unit->cell_at(board.step - 1), &best_route1);
+                target_unit->cell(), target_unit->cell_at(board().step - 1), &best_route1);
             best_u1->new_role(r1);
             Role *r2 = new RolePincer(
                 best_u2, best_u2->assigned_factory, target_unit, best_u1, best_route2.back(),
-                target_unit->cell(), target_unit->cell_at(board.step - 1), &best_route2);
+                target_unit->cell(), target_unit->cell_at(board().step - 1), &best_route2);
             best_u2->new_role(r2);
         }
     }
@@ -135,7 +136,7 @@ bool RolePincer::get_routes(Unit *target_unit, Unit *u1, Unit *u2,
     int min_dist = INT_MAX;
     int min_cost = INT_MAX;
 
-    Cell *target_cells[2] = { target_unit->cell(), target_unit->cell_at(board.step - 1) };
+    Cell *target_cells[2] = { target_unit->cell(), target_unit->cell_at(board().step - 1) };
     for (Cell *target_cell : target_cells) {
         if (target_cell->away_dist <= 1) continue;
         for (int i = 0; i < 8; i++) {
@@ -143,12 +144,12 @@ bool RolePincer::get_routes(Unit *target_unit, Unit *u1, Unit *u2,
             if (!stage_cell1 || stage_cell1->opp_factory() || stage_cell1->factory_center) continue;
 
             vector<Cell*> route1;
-            int cost1 = board.pathfind(
-                u1, u1->cell(), stage_cell1, NULL,
+            int cost1 = board().pathfind_t(
+                u1, u1->cell(), stage_cell1, PathNone(),
                 [&](Cell *c) { return (c->opp_factory()
                                        || c->man_dist(target_cells[0]) <= 1
                                        || c->man_dist(target_cells[1]) <= 1); },
-                NULL, &route1, /*max_dist*/3);
+                PathNone(), &route1, /*max_dist*/3);
             if (cost1 == INT_MAX) continue;
             if (target_unit->power >= (
                     u1->power - 2 * u1->cfg->ACTION_QUEUE_POWER_COST - cost1)) continue;
@@ -162,12 +163,12 @@ bool RolePincer::get_routes(Unit *target_unit, Unit *u1, Unit *u2,
                 if (!stage_cell2 || stage_cell2->opp_factory() || stage_cell2->factory_center)continue;
 
                 vector<Cell*> route2;
-                int cost2 = board.pathfind(
-                    u2, u2->cell(), stage_cell2, NULL,
+                int cost2 = board().pathfind_t(
+                    u2, u2->cell(), stage_cell2, PathNone(),
                     [&](Cell *c) { return (c->opp_factory()
                                            || c->man_dist(target_cells[0]) <= 1
                                            || c->man_dist(target_cells[1]) <= 1); },
-                    NULL, &route2, /*max_dist*/3);
+                    PathNone(), &route2, /*max_dist*/3);
                 if (cost2 == INT_MAX) continue;
                 if (target_unit->power >= (
                         u2->power - 2 * u2->cfg->ACTION_QUEUE_POWER_COST - cost2)) continue;
@@ -246,14 +247,14 @@ void RolePincer::teardown() {
 
 bool RolePincer::is_valid() {
     // Try to keep pincers valid even if home factory is lost
-    if (board.sim0()
+    if (board().sim0()
         && !this->factory->alive()
         && this->factory != this->unit->assigned_factory) {
         this->factory = this->unit->assigned_factory;
         LUX_LOG("pincer modify " << *this->unit << " home factory " << *this);
     }
 
-    if (board.sim0()
+    if (board().sim0()
         && this->primary()
         && !this->target_unit->alive()
         && this->unit->cell()->man_dist(this->target_unit->cell()) <= 1) {
@@ -267,7 +268,7 @@ bool RolePincer::is_valid() {
                      && this->partner_unit->alive()
                      && partner_role);
 
-    if (!board.sim0()) return is_valid;
+    if (!board().sim0()) return is_valid;
 
     // Confirm target unit is still oscillating in place
     if (is_valid
@@ -34,7 +34,7 @@ bool RolePowerTransporter::from_miner(Role **new_role, Unit *_unit) {
         if (role_miner->resource_cell->man_dist_factory(factory) > 1) continue;
 
         Cell *factory_cell = role_miner->resource_cell->neighbor_toward(factory->cell);
-        LUX_ASSERT(factory_cell->factory);
+        LUX_ASSERT(factory_cell->factory());
 
         // Determine if currently assigned unit can be displaced (chain transporters/miners can be)
         if (factory_cell->assigned_unit) {
@@ -67,7 +67,7 @@ bool RolePowerTransporter::from_transition_protector(Role **new_role, Unit *_uni
     //if (_unit->_log_cond()) LUX_LOG("RolePowerTransporter::from_transition_protector A");
 
     RoleProtector *role;
-    if (!board.sim0()
+    if (!board().sim0()
         || !_unit->heavy
         || !(role = RoleProtector::cast(_unit->role))) {
         return false;
@@ -82,19 +82,19 @@ bool RolePowerTransporter::from_transition_protector(Role **new_role, Unit *_uni
 }
 
 void RolePowerTransporter::print(ostream &os) const {
-    if (!this->factory_cell->factory) {
+    if (!this->factory_cell->factory()) {
         os << "PowerTransporter[N/A]";
         return;
     }
 
     string fgoal = this->goal_type == 'c' ? "*" : "";
     string tgoal = this->goal_type == 'u' ? "*" : "";
-    os << "PowerTransporter[" << *this->factory_cell->factory << *this->factory_cell << fgoal << " -> "
+    os << "PowerTransporter[" << *this->factory_cell->factory() << *this->factory_cell << fgoal << " -> "
        << *this->target_unit << tgoal << "]";
 }
 
 Factory *RolePowerTransporter::get_factory() {
-    return this->factory_cell->factory;
+    return this->factory_cell->factory();
 }
 
 void RolePowerTransporter::set() {
@@ -173,8 +173,8 @@ void RolePowerTransporter::update_goal() {
         int power_threshold = (
             this->unit->cfg->ACTION_QUEUE_POWER_COST
             + 2 * this->target_unit->cfg->DIG_COST
-            - this->target_unit->power_gain(board.sim_step + 1)
-            - this->target_unit->power_gain(board.sim_step + 2));
+            - this->target_unit->power_gain(board().sim_step + 1)
+            - this->target_unit->power_gain(board().sim_step + 2));
         if (this->unit->power >= power_threshold && unit_resource == 0) {
             this->goal_type = 'u';
             this->goal = this->target_unit;
@@ -204,7 +204,7 @@ bool RolePowerTransporter::_do_excess_power_transfer() {
         amount = (amount / 10) * 10;  // round down to nearest 10
         if (amount > 0
             && this->unit->power >= this->unit->transfer_cost(cur_cell, Resource_POWER, amount)) {
-            if (board.sim0()) LUX_LOG(*this->unit << ' ' << *this->unit->role
+            if (board().sim0()) LUX_LOG(*this->unit << ' ' << *this->unit->role
                                       << " transporter excess power tx " << amount);
             this->unit->do_transfer(cur_cell, Resource_POWER, amount);
             return true;
@@ -236,7 +236,7 @@ bool RolePowerTransporter::do_transfer() {
             LUX_LOG("target_cell: " << *this->target_unit->cell());
         }
         LUX_ASSERT(transfer_cell);
-        if (!transfer_cell->factory && this->unit->cell()->man_dist(transfer_cell) == 1) {
+        if (!transfer_cell->factory() && this->unit->cell()->man_dist(transfer_cell) == 1) {
             RoleMiner *target_role = RoleMiner::cast(this->target_unit->role);
             LUX_ASSERT(target_role);
             int amount = (this->target_unit->cfg->BATTERY_CAPACITY
@@ -244,7 +244,7 @@ bool RolePowerTransporter::do_transfer() {
                           - this->target_unit->power_delta
                           - this->target_unit->power_gain());
             int dist = target_role->resource_cell->man_dist_factory(this->get_factory());
-            int power_gain = this->unit->power_gain(board.sim_step, board.sim_step + dist);
+            int power_gain = this->unit->power_gain(board().sim_step, board().sim_step + dist);
             int power_to_keep = (this->unit->cfg->ACTION_QUEUE_POWER_COST
                                  + 2 * this->unit->cfg->MOVE_COST * dist
                                  - power_gain);
@@ -270,7 +270,7 @@ bool RolePowerTransporter::do_pickup() {
 
     // Skip pickup if miner has sufficient power
     int digs_remaining = this->target_unit->power / this->target_unit->cfg->DIG_COST;
-    int power_gain = this->target_unit->power_gain(board.sim_step, board.sim_step + digs_remaining);
+    int power_gain = this->target_unit->power_gain(board().sim_step, board().sim_step + digs_remaining);
     digs_remaining = (this->target_unit->power + power_gain) / this->target_unit->cfg->DIG_COST;
     if (digs_remaining >= 8) return false;
 
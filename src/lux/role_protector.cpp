@@ -33,7 +33,7 @@ bool RoleProtector::from_transition_protect_ice_miner(Role **new_role, Unit *_un
     LUX_ASSERT(_unit);
     //if (_unit->_log_cond()) LUX_LOG("RoleProtector::from_transition_protect_ice_miner A");
 
-    if (!board.sim0() || !_unit->heavy) return false;
+    if (!board().sim0() || !_unit->heavy) return false;
 
     // Some roles/situations should not transition
     Cell *cur_cell = _unit->cell();
@@ -81,7 +81,7 @@ bool RoleProtector::from_transition_protect_ice_miner(Role **new_role, Unit *_un
         if (role_miner->power_transporter) role_miner->power_transporter->delete_role();
 
         Cell *factory_cell = role_miner->resource_cell->neighbor_toward(factory->cell);
-        LUX_ASSERT(factory_cell->factory);
+        LUX_ASSERT(factory_cell->factory());
         Role::_displace_unit(factory_cell);
 
         *new_role = new RoleProtector(_unit, factory_cell, best_unit);
@@ -97,7 +97,7 @@ bool RoleProtector::from_transition_power_transporter(Role **new_role, Unit *_un
     //if (_unit->_log_cond()) LUX_LOG("RoleProtector::from_transition_power_transporter A");
 
     RolePowerTransporter *role_pt;
-    if (!board.sim0()
+    if (!board().sim0()
         || !_unit->heavy
         || !(role_pt = RolePowerTransporter::cast(_unit->role))) {
         return false;
@@ -150,10 +150,10 @@ bool RoleProtector::in_position() {
 }
 
 bool RoleProtector::is_protecting() {
-    if (board.step != this->_is_protecting_step) {
-        this->_is_protecting_step = board.step;
+    if (board().step != this->_is_protecting_step) {
+        this->_is_protecting_step = board().step;
         this->_is_protecting = (
-            board.sim0()
+            board().sim0()
             && this->goal_type == 'c'
             && this->in_position()
             && (this->miner_unit->power
@@ -166,8 +166,8 @@ bool RoleProtector::is_protecting() {
 
 // Assumes is_protecting is true
 bool RoleProtector::should_strike() {
-    if (board.step != this->_should_strike_step) {
-        this->_should_strike_step = board.step;
+    if (board().step != this->_should_strike_step) {
+        this->_should_strike_step = board().step;
         this->_should_strike = false;
 
         RoleMiner *role_miner = RoleMiner::cast(this->miner_unit->role);
@@ -183,10 +183,10 @@ bool RoleProtector::should_strike() {
             // This is 100% safe, not even a "protected move"
         } else if (!threat_units.empty()
                    && this->get_factory()->total_water() > 5
-                   && (this->last_strike_step <= board.step - 10
-                       || prandom(board.sim_step + this->unit->id, PROTECTOR_STRIKE_CHANCE))) {
+                   && (this->last_strike_step <= board().step - 10
+                       || prandom(board().sim_step + this->unit->id, PROTECTOR_STRIKE_CHANCE))) {
             this->_should_strike = true;
-            this->last_strike_step = board.step;
+            this->last_strike_step = board().step;
         }
         if (this->unit->_log_cond()) LUX_LOG(*this->unit<< " should_strike? " << this->_should_strike);
     }
@@ -203,19 +203,19 @@ bool RoleProtector::is_covering() {
 }
 
 void RoleProtector::print(ostream &os) const {
-    if (!this->factory_cell->factory) {
+    if (!this->factory_cell->factory()) {
         os << "Protector[N/A]";
         return;
     }
 
     string fgoal = this->goal_type == 'f' ? "*" : "";
     string cgoal = this->goal_type == 'c' ? "*" : "";
-    os << "Protector[" << *this->factory_cell->factory << fgoal << " -> "
+    os << "Protector[" << *this->factory_cell->factory() << fgoal << " -> "
        << *this->miner_unit << cgoal << "]";
 }
 
 Factory *RoleProtector::get_factory() {
-    return this->factory_cell->factory;
+    return this->factory_cell->factory();
 }
 
 double RoleProtector::power_usage() {
@@ -295,8 +295,8 @@ bool RoleProtector::do_move() {
     // We are at factory cell
     // For step idx0, either strike out at resource_cell, or sit tight and pickup/transfer
     // For all future steps, we will claim that we _plan_ on striking resource cell
-    if ((board.sim0() && this->is_striking())
-        || (!board.sim0() && this->in_position())) {
+    if ((board().sim0() && this->is_striking())
+        || (!board().sim0() && this->in_position())) {
         //if (this->unit->_log_cond()) LUX_LOG("RoleProtector::do_move B");
         RoleMiner *role_miner = RoleMiner::cast(this->miner_unit->role);
         LUX_ASSERT(role_miner);
@@ -307,7 +307,7 @@ bool RoleProtector::do_move() {
     }
 
     // If in position on idx0 and we are not striking, picking up, or transferring, stand still
-    if (board.sim0() && this->in_position()) {
+    if (board().sim0() && this->in_position()) {
         //if (this->unit->_log_cond()) LUX_LOG("RoleProtector::do_move D");
         return this->_do_no_move();
     }
@@ -327,7 +327,7 @@ bool RoleProtector::do_transfer() {
     }
 
     // Only actually do pickup on step idx0
-    if (!board.sim0()) {
+    if (!board().sim0()) {
         return false;
     }
 
@@ -352,7 +352,7 @@ bool RoleProtector::do_transfer() {
     int miner_power = this->miner_unit->power;
     int digs_remaining = (miner_power / (this->miner_unit->cfg->ACTION_QUEUE_POWER_COST
                                          + this->miner_unit->cfg->DIG_COST));
-    int power_gain = this->miner_unit->power_gain(board.step, board.step + digs_remaining);
+    int power_gain = this->miner_unit->power_gain(board().step, board().step + digs_remaining);
     digs_remaining = ((miner_power + power_gain) / (this->miner_unit->cfg->ACTION_QUEUE_POWER_COST
                                                     + this->miner_unit->cfg->DIG_COST));
     if (digs_remaining >= 10) {
@@ -368,7 +368,7 @@ bool RoleProtector::do_transfer() {
 
     int amount = (this->miner_unit->cfg->BATTERY_CAPACITY
                   - miner_power
-                  - this->miner_unit->power_gain(board.step));
+                  - this->miner_unit->power_gain(board().step));
     amount = MIN(amount, protector_power - protector_power_to_keep);
 
     int max_miner_power = MAX(threat_power + 100,
@@ -396,7 +396,7 @@ bool RoleProtector::do_pickup() {
     }
 
     // Only actually do pickup on step idx0
-    if (!board.sim0()) {
+    if (!board().sim0()) {
         return false;
     }
 
@@ -34,7 +34,7 @@ bool RoleRecharge::from_transition_low_power(Role **new_role, Unit *_unit) {
 
     // Was Recharge and made it to the factory
     Factory *factory = _unit->assigned_factory;
-    if (!_unit->role && _unit->cell()->factory == factory) return false;
+    if (!_unit->role && _unit->cell()->factory() == factory) return false;
 
     // Various roles/situations do not utilize Recharge
     RoleMiner *role_miner;
@@ -53,7 +53,7 @@ bool RoleRecharge::from_transition_low_power(Role **new_role, Unit *_unit) {
                 && (!role_miner->chain_route.empty()
                     || role_miner->resource_cell->man_dist_factory(factory) <= 5))
             || (RolePillager::cast(_unit->role)
-                && board.sim_step >= END_PHASE)
+                && board().sim_step >= END_PHASE)
             || RolePincer::cast(_unit->role)
             || RolePowerTransporter::cast(_unit->role)
             || RoleProtector::cast(_unit->role)
@@ -80,7 +80,7 @@ bool RoleRecharge::from_transition_low_water(Role **new_role, Unit *_unit) {
             || RoleChainTransporter::cast(_unit->role)
             || RoleMiner::cast(_unit->role)
             || (RolePillager::cast(_unit->role)
-                && board.sim_step >= END_PHASE
+                && board().sim_step >= END_PHASE
                 && cur_cell->man_dist_factory(factory) > 10)
             || RolePowerTransporter::cast(_unit->role)
             || RoleRecharge::cast(_unit->role)
@@ -105,7 +105,7 @@ Factory *RoleRecharge::get_factory() {
 }
 
 double RoleRecharge::power_usage() {
-    if (this->unit->cell()->factory == this->factory) return 0;
+    if (this->unit->cell()->factory() == this->factory) return 0;
     return 1.5 * this->unit->cfg->MOVE_COST;
 }
 
@@ -125,7 +125,7 @@ void RoleRecharge::teardown() {
 bool RoleRecharge::is_valid() {
     return (this->factory->alive()
             && this->unit->power < this->unit->cfg->BATTERY_CAPACITY / 2
-            && (this->unit->cell()->factory != this->factory
+            && (this->unit->cell()->factory() != this->factory
                 || (this->unit->ore + this->unit->ice + this->unit->metal + this->unit->water > 0)));
 }
 
@@ -134,7 +134,7 @@ Cell *RoleRecharge::goal_cell() {
 
     // Temporarily override goal cell for ice conflict heavies on the first step
     ModeIceConflict *mode;
-    if (board.sim_step == 1
+    if (board().sim_step == 1
         && this->unit->heavy
         && cur_cell == this->factory->cell
         && (mode = ModeIceConflict::cast(this->factory->mode))) {
@@ -146,10 +146,10 @@ Cell *RoleRecharge::goal_cell() {
     // Override goal if on factory center - just move toward center of board
     // Lights will naturally get pushed off by newly created units
     if (this->unit->heavy && cur_cell == this->factory->cell) {
-        Cell *mid_cell = board.cell(SIZE / 2, SIZE / 2);
+        Cell *mid_cell = board().cell(SIZE / 2, SIZE / 2);
         Cell *rc = mid_cell->radius_cell(SIZE);
         while (rc) {
-            if (!rc->factory) return rc;
+            if (!rc->factory()) return rc;
             rc = mid_cell->radius_cell(SIZE, rc);
         }
     }
@@ -211,7 +211,7 @@ bool RoleRecharge::_do_ice_conflict_power_transfer() {
 
     // Must be on factory
     Cell *cur_cell = this->unit->cell();
-    if (cur_cell->factory != this->factory) return false;
+    if (cur_cell->factory() != this->factory) return false;
 
     // Transfer excess to factory, rounding down to nearest 10
     int amount = this->unit->power - 10;
@@ -35,7 +35,7 @@ bool RoleRelocate::from_idle(Role **new_role, Unit *_unit) {
 
     Factory *best_factory = NULL;
     int min_dist = INT_MAX;
-    for (Factory *other_factory : board.player->factories()) {
+    for (Factory *other_factory : board().player->factories()) {
         if (other_factory == factory) continue;
         if ((_unit->heavy && other_factory->heavy_relocate_count > 0)
             || (!_unit->heavy && other_factory->light_relocate_count > 0)) continue;
@@ -53,7 +53,7 @@ bool RoleRelocate::from_idle(Role **new_role, Unit *_unit) {
 
     if (best_factory) {
         *new_role = new RoleRelocate(_unit, factory, best_factory);
-        if (board.sim0()) LUX_LOG("relocate (idle): " << *_unit << ' ' << **new_role);
+        if (board().sim0()) LUX_LOG("relocate (idle): " << *_unit << ' ' << **new_role);
         return true;
     }
 
@@ -73,7 +73,7 @@ bool RoleRelocate::from_ore_surplus(Role **new_role, Unit *_unit) {
 
     Factory *best_factory = NULL;
     int min_dist = INT_MAX;
-    for (Factory *other_factory : board.player->factories()) {
+    for (Factory *other_factory : board().player->factories()) {
         if (other_factory == factory) continue;
 
         int light_count = other_factory->lights.size() + other_factory->inbound_light_relocate_count;
@@ -91,7 +91,7 @@ bool RoleRelocate::from_ore_surplus(Role **new_role, Unit *_unit) {
 
     if (best_factory) {
         *new_role = new RoleRelocate(_unit, factory, best_factory);
-        if (board.sim0()) LUX_LOG("relocate (ore surplus): " << *_unit << ' ' << **new_role);
+        if (board().sim0()) LUX_LOG("relocate (ore surplus): " << *_unit << ' ' << **new_role);
         return true;
     }
 
@@ -118,7 +118,7 @@ bool RoleRelocate::from_power_surplus(Role **new_role, Unit *_unit) {
 
     Factory *best_factory = NULL;
     int min_dist = INT_MAX;
-    for (Factory *other_factory : board.player->factories()) {
+    for (Factory *other_factory : board().player->factories()) {
         if (other_factory == factory) continue;
 
         int f_power = other_factory->total_power();
@@ -133,7 +133,7 @@ bool RoleRelocate::from_power_surplus(Role **new_role, Unit *_unit) {
 
     if (best_factory) {
         *new_role = new RoleRelocate(_unit, factory, best_factory);
-        if (board.sim0()) LUX_LOG("relocate (power surplus): " << *_unit << ' ' << **new_role);
+        if (board().sim0()) LUX_LOG("relocate (power surplus): " << *_unit << ' ' << **new_role);
         return true;
     }
 
@@ -144,13 +144,13 @@ bool RoleRelocate::from_assist_ice_conflict(Role **new_role, Unit *_unit) {
     //if (_unit->_log_cond()) LUX_LOG("RoleRelocate::from_assist_ice_conflict A");
     Factory *factory = _unit->assigned_factory;
 
-    if (board.sim_step < 10
+    if (board().sim_step < 10
         || ModeIceConflict::cast(factory->mode)
         || (_unit->heavy && factory->heavies.size() == 1)) return false;
 
     Factory *best_factory = NULL;
     int min_dist = INT_MAX;
-    for (Factory *other_factory : board.player->factories()) {
+    for (Factory *other_factory : board().player->factories()) {
         if (other_factory == factory) continue;
 
         // Relocate up to 1 heavy to any factory
@@ -179,7 +179,7 @@ bool RoleRelocate::from_assist_ice_conflict(Role **new_role, Unit *_unit) {
 
     if (best_factory) {
         *new_role = new RoleRelocate(_unit, factory, best_factory);
-        if (board.sim0()) LUX_LOG("relocate (assist): " << *_unit << ' ' << **new_role);
+        if (board().sim0()) LUX_LOG("relocate (assist): " << *_unit << ' ' << **new_role);
         return true;
     }
 
@@ -298,7 +298,7 @@ void RoleRelocate::update_goal() {
         // One way ticket
     } else if (this->goal == this->factory) {  // Done with factory goal?
         int power_threshold = (
-            + 3 * board.naive_cost(this->unit, this->unit->cell(), this->target_factory->cell) / 2);
+            + 3 * board().naive_cost(this->unit, this->unit->cell(), this->target_factory->cell) / 2);
         power_threshold = MIN(power_threshold, 0.95 * this->unit->cfg->BATTERY_CAPACITY);
         if (this->unit->power >= power_threshold) {
             this->goal = this->target_factory;
@@ -331,7 +331,7 @@ bool RoleRelocate::do_transfer() {
 bool RoleRelocate::do_pickup() {
     //if (this->unit->_log_cond()) LUX_LOG("RoleRelocate::do_pickup A");
     int power_threshold = (
-        + 3 * board.naive_cost(this->unit, this->unit->cell(), this->target_factory->cell) / 2);
+        + 3 * board().naive_cost(this->unit, this->unit->cell(), this->target_factory->cell) / 2);
     power_threshold = MIN(power_threshold, 0.95 * this->unit->cfg->BATTERY_CAPACITY);
 
     return this->_do_power_pickup(/*max_amount*/power_threshold+1);
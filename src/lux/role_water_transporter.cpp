@@ -34,7 +34,7 @@ bool RoleWaterTransporter::from_ice_conflict(Role **new_role, Unit *_unit,
 
     Factory *best_factory = NULL;
     double best_score = INT_MIN;
-    for (Factory *other_factory : board.player->factories()) {
+    for (Factory *other_factory : board().player->factories()) {
         if (other_factory == factory
             || ModeIceConflict::cast(other_factory->mode)) continue;
 
@@ -46,7 +46,7 @@ bool RoleWaterTransporter::from_ice_conflict(Role **new_role, Unit *_unit,
                         - dist
                         - 100 * other_factory->inbound_water_transporter_count);
 
-        if (board.low_iceland()
+        if (board().low_iceland()
             && water < 200) continue;
 
         if (2 * dist > factory_water) {  // probably won't make it in time
@@ -162,7 +162,7 @@ void RoleWaterTransporter::update_goal() {
         water_threshold = MAX(10, water_threshold);
         water_threshold = MIN(100, water_threshold);
         if (unit_water >= water_threshold) {
-            int power_threshold = 2 * board.naive_cost(
+            int power_threshold = 2 * board().naive_cost(
                 this->unit, this->unit->cell(), this->factory->cell);
             power_threshold = MIN(power_threshold, 0.95 * this->unit->cfg->BATTERY_CAPACITY);
             if (this->unit->power >= power_threshold) {
@@ -171,7 +171,7 @@ void RoleWaterTransporter::update_goal() {
         }
     } else if (this->goal == this->factory) {  // Done with factory goal?
         if (unit_water == 0) {
-            int power_threshold = 2 * board.naive_cost(
+            int power_threshold = 2 * board().naive_cost(
                 this->unit, this->unit->cell(), this->target_factory->cell);
             power_threshold = MIN(power_threshold, 0.95 * this->unit->cfg->BATTERY_CAPACITY);
             if (this->unit->power >= power_threshold) {
@@ -208,7 +208,7 @@ bool RoleWaterTransporter::_do_water_pickup() {
     //if (this->unit->_log_cond()) LUX_LOG("RoleWaterTransporter::do_water_pickup A");
 
     Cell *cur_cell = this->unit->cell();
-    Factory *cur_factory = cur_cell->factory;
+    Factory *cur_factory = cur_cell->factory();
     if (cur_cell->factory_center
         || !cur_factory
         || cur_factory != this->target_factory) {
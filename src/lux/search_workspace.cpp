@@ -0,0 +1,25 @@
+#include "lux/search_workspace.hpp"
+
+#include <memory>  // unique_ptr
+#include <vector>
+using namespace std;
+
+
+// Workspaces of the calling thread, [0, depth) are in use by active searches
+static thread_local vector<unique_ptr<SearchWorkspace> > t_workspaces;
+static thread_local int t_depth = 0;
+
+SearchWorkspace::SearchWorkspace() : call_id(0) {
+    for (CellPathInfo &info : this->path_info) info = {};
+}
+
+SearchScope::SearchScope(SearchWorkspace *workspace) : ws(workspace), claimed(workspace == NULL) {
+    if (!this->claimed) return;
+    if ((int)t_workspaces.size() <= t_depth) t_workspaces.emplace_back(new SearchWorkspace());
+    this->ws = t_workspaces[t_depth].get();
+    t_depth += 1;
+}
+
+SearchScope::~SearchScope() {
+    if (this->claimed) t_depth -= 1;
+}
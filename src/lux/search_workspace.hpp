@@ -0,0 +1,41 @@
+#pragma once
+
+#include "lux/defs.hpp"
+
+
+struct Cell;
+
+typedef struct CellPathInfo {
+    int cost;  // stores best cost per cell during each pathfind call
+    int dist;  // stores dist associated with best cost route
+    struct Cell *prev_cell;  // so we can unwind routes
+    int call_id;  // so we can skip per-call all-cell initialization
+} CellPathInfo;
+
+// Per-cell scratch of one pathfind_t or flood_fill call. Each thread keeps a stack of these, so a search may run
+// from inside another one's callbacks, and searches on different threads do not share state, see SearchScope.
+typedef struct SearchWorkspace {
+    CellPathInfo path_info[SIZE2];  // by cell id, only set where path_info[id].call_id == call_id
+    int call_id;
+
+    // ~~~ Methods:
+
+    SearchWorkspace();
+
+    inline void begin() { this->call_id += 1; }
+    inline bool reached(int cell_id) const { return this->path_info[cell_id].call_id == this->call_id; }
+} SearchWorkspace;
+
+// Claims the calling thread's next free workspace until destroyed, or uses the given one (e.g. to read the
+// search results afterwards). Scopes must be destroyed in reverse order of creation.
+typedef struct SearchScope {
+    SearchWorkspace *ws;
+    bool claimed;
+
+    // ~~~ Methods:
+
+    explicit SearchScope(SearchWorkspace *workspace = NULL);
+    ~SearchScope();
+    SearchScope(SearchScope const&) = delete;
+    SearchScope &operator=(SearchScope const&) = delete;
+} SearchScope;
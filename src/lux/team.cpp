@@ -7,7 +7,7 @@
 using namespace std;
 
 
-void Team::init(bool is_player0, json &strains_info) {
+void Team::init(bool is_player0, const vector<int> &strains_info) {
     this->id = (is_player0 ? 0 : 1);
     this->player.init(this, is_player0, strains_info);
 }
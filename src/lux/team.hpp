@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <list>
+#include <vector>
 
 #include "lux/player.hpp"
 
@@ -15,5 +16,5 @@ typedef struct Team {
 
     // ~~~ Methods:
 
-    void init(bool is_player0, json &strains_info);
+    void init(bool is_player0, const std::vector<int> &strains_info);
 } Team;
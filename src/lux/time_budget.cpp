@@ -0,0 +1,56 @@
+#include "lux/time_budget.hpp"
+
+#include <algorithm>  // max, min
+#include <climits>
+
+#include "lux/defs.hpp"
+using namespace std;
+
+
+TimeBudget::TimeBudget()
+    : turn_start(0), deadline(0), hard_deadline(0), watchdog_armed(false), loop_start(0), loop_end(0),
+      tail_time(0), horizon(0), horizon_total(0), horizon_min(INT_MAX), turns(0), near_misses(0), fallbacks(0) {}
+
+bool TimeBudget::is_critical(int env_step) {
+    return env_step == 0 || env_step >= END_PHASE;
+}
+
+void TimeBudget::begin_loop(int env_step, double remaining_overage, double max_time) {
+    this->loop_start = get_time();
+
+    int turns_left = max(1, 1000 - env_step);
+    double spare_overage = max(0.0, remaining_overage - OVERAGE_RESERVE);
+    double shares = (is_critical(env_step) ? OVERAGE_CRITICAL_SHARES : OVERAGE_ROUTINE_SHARES);
+    double limit = ACT_TIMEOUT + shares * spare_overage / turns_left;
+    double budget = min(TIME_BUDGET_SAFETY * limit, max_time);
+    this->deadline = this->turn_start + budget - this->tail_time;
+    this->hard_deadline = this->turn_start + limit - this->tail_time;
+    this->watchdog_armed = false;
+}
+
+bool TimeBudget::fits_another_step(int steps_done) {
+    double now = get_time();
+    double step_time = (now - this->loop_start) / steps_done;
+    return now + step_time <= this->deadline;
+}
+
+void TimeBudget::end_loop(int steps_done, bool fallback) {
+    this->loop_end = get_time();
+    this->watchdog_armed = false;
+    if (fallback) {
+        this->fallbacks += 1;
+    } else if (this->loop_end > this->deadline + WATCHDOG_NEAR_MISS * (this->hard_deadline - this->deadline)) {
+        this->near_misses += 1;
+    }
+    this->horizon = steps_done;
+    this->horizon_total += steps_done;
+    this->horizon_min = min(this->horizon_min, steps_done);
+    this->turns += 1;
+}
+
+void TimeBudget::end_turn() {
+    double latest = get_time() - this->loop_end;
+    this->tail_time = (this->turns == 1
+                       ? latest
+                       : (1 - TIME_BUDGET_SMOOTHING) * this->tail_time + TIME_BUDGET_SMOOTHING * latest);
+}
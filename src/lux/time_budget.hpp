@@ -0,0 +1,54 @@
+#pragma once
+
+#include "lux/defs.hpp"  // get_time
+
+
+#define ACT_TIMEOUT 3.0  // seconds per turn before the overage pool is drawn on
+#define TIME_BUDGET_SAFETY 0.8  // plan for this fraction of the limits, the rest absorbs timing noise
+#define OVERAGE_RESERVE 10.0  // overage seconds never planned for
+#define OVERAGE_CRITICAL_SHARES 4.0  // a critical turn may draw this many fair shares of the spare overage
+#define OVERAGE_ROUTINE_SHARES 0.5  // a routine turn draws less than its fair share, saving it for critical turns
+#define TIME_BUDGET_SMOOTHING 0.2  // weight of the latest turn in the moving averages
+#define WATCHDOG_NEAR_MISS 0.5  // a loop ending this far into the gap between deadline and hard_deadline is a near-miss
+
+// Thrown at a watchdog checkpoint once hard_deadline has passed, caught by Agent::act
+typedef struct WatchdogExpired {} WatchdogExpired;
+
+// Deadline of the future-sim loop in Agent::act. Each turn may take ACT_TIMEOUT plus some of the spare
+// overage pool, split over the remaining turns and weighted toward critical turns (the first turn after
+// placement and the end phase). The time a turn needs after the loop is measured over recent turns and kept
+// free. Also keeps the horizon (future sim steps) actually reached.
+//
+// A single slow sim step can still overrun the deadline, so once the step 0 actions are final the watchdog is
+// armed: checkpoints between unit phases and role assignment passes throw WatchdogExpired after hard_deadline,
+// the share of the turn limit left once the tail is kept free.
+typedef struct TimeBudget {
+    double turn_start;  // set by Agent::init, so the board update counts toward the turn
+    double deadline;  // no sim step should start that is expected to end after this
+    double hard_deadline;  // the loop is abandoned at the next checkpoint after this
+    bool watchdog_armed;
+    double loop_start;
+    double loop_end;
+    double tail_time;  // moving average of the time from leaving the loop to the end of the turn
+    int horizon;  // sim steps completed in the last turn
+    long horizon_total;
+    int horizon_min;
+    int turns;
+    int near_misses;
+    int fallbacks;  // turns that emitted the step 0 actions because the watchdog fired
+
+    // ~~~ Methods:
+
+    TimeBudget();
+
+    static bool is_critical(int env_step);
+    void begin_loop(int env_step, double remaining_overage, double max_time);
+    bool fits_another_step(int steps_done);  // after steps_done sim steps of this turn
+    inline void arm_watchdog() { this->watchdog_armed = true; }
+    inline void check_watchdog() {
+        if (this->watchdog_armed && get_time() > this->hard_deadline) throw WatchdogExpired();
+    }
+    void end_loop(int steps_done, bool fallback);
+    void end_turn();
+    inline double horizon_avg() const { return this->turns ? this->horizon_total / (double)this->turns : 0; }
+} TimeBudget;
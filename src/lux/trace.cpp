@@ -0,0 +1,126 @@
+#include "lux/trace.hpp"
+
+#include <fcntl.h>  // open
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // close
+
+#include <cstring>  // memcmp, memcpy
+
+#include "lux/log.hpp"
+using namespace std;
+
+
+bool TraceRecorder::open(const char *path) {
+    this->file = fopen(path, "w+b");
+    if (!this->file) return false;
+
+    memset(&this->header, 0, sizeof(this->header));
+    memcpy(this->header.magic, TRACE_MAGIC, sizeof(this->header.magic));
+    this->header.version = TRACE_VERSION;
+    this->header.max_turns = TRACE_MAX_TURNS;
+    fwrite(&this->header, sizeof(this->header), 1, this->file);
+
+    TraceIndexEntry empty_entry;
+    memset(&empty_entry, 0, sizeof(empty_entry));
+    for (int i = 0; i < TRACE_MAX_TURNS; i++) {
+        fwrite(&empty_entry, sizeof(empty_entry), 1, this->file);
+    }
+    this->end_offset = sizeof(TraceHeader) + TRACE_MAX_TURNS * sizeof(TraceIndexEntry);
+    fflush(this->file);
+    return true;
+}
+
+void TraceRecorder::record(Observation &obs, const string &actions, bool actions_binary, double turn_time) {
+    if (!this->file) return;
+    if (obs.step < 0 || obs.step >= TRACE_MAX_TURNS) {
+        LUX_LOG("trace: step " << obs.step << " out of range");
+        return;
+    }
+
+    this->_buf.clear();
+    obs.write_binary(&this->_buf, /*static_planes*/obs.step == 0);
+
+    TraceIndexEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.offset = this->end_offset;
+    entry.obs_len = this->_buf.size();
+    entry.actions_len = actions.size();
+    entry.turn_time = turn_time;
+    entry.actions_binary = actions_binary;
+
+    fseek(this->file, this->end_offset, SEEK_SET);
+    fwrite(this->_buf.data(), 1, this->_buf.size(), this->file);
+    fwrite(actions.data(), 1, actions.size(), this->file);
+    this->end_offset += this->_buf.size() + actions.size();
+
+    // Index entry and header last, so a reader never sees an entry for a partial frame
+    fseek(this->file, sizeof(TraceHeader) + obs.step * sizeof(TraceIndexEntry), SEEK_SET);
+    fwrite(&entry, sizeof(entry), 1, this->file);
+    this->header.turn_count = MAX(this->header.turn_count, (uint32_t)obs.step + 1);
+    fseek(this->file, 0, SEEK_SET);
+    fwrite(&this->header, sizeof(this->header), 1, this->file);
+    fflush(this->file);
+}
+
+void TraceRecorder::close() {
+    if (this->file) fclose(this->file);
+    this->file = NULL;
+}
+
+bool TraceReader::open(const char *path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader) + TRACE_MAX_TURNS * sizeof(TraceIndexEntry)) {
+        ::close(fd);
+        return false;
+    }
+    void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) return false;
+
+    this->data = static_cast<const char*>(addr);
+    this->size = st.st_size;
+    this->header = reinterpret_cast<const TraceHeader*>(this->data);
+    this->index = reinterpret_cast<const TraceIndexEntry*>(this->data + sizeof(TraceHeader));
+    if (memcmp(this->header->magic, TRACE_MAGIC, sizeof(this->header->magic)) != 0
+        || this->header->version != TRACE_VERSION
+        || this->header->max_turns != TRACE_MAX_TURNS) {
+        this->close();
+        return false;
+    }
+    return true;
+}
+
+void TraceReader::close() {
+    if (this->data) munmap(const_cast<char*>(this->data), this->size);
+    this->data = NULL;
+    this->size = 0;
+}
+
+int TraceReader::turn_count() {
+    return this->header->turn_count;
+}
+
+bool TraceReader::has_turn(int step) {
+    return (step >= 0 && step < (int)this->header->turn_count && this->index[step].offset
+            && this->index[step].offset + this->index[step].obs_len + this->index[step].actions_len <= this->size);
+}
+
+bool TraceReader::observation(int step, Observation *obs) {
+    if (!this->has_turn(step)) return false;
+    const TraceIndexEntry *entry = &this->index[step];
+    return obs->parse_binary(this->data + entry->offset, entry->obs_len);
+}
+
+string TraceReader::actions(int step) {
+    if (!this->has_turn(step)) return "";
+    const TraceIndexEntry *entry = &this->index[step];
+    return string(this->data + entry->offset + entry->obs_len, entry->actions_len);
+}
+
+float TraceReader::turn_time(int step) {
+    if (!this->has_turn(step)) return 0;
+    return this->index[step].turn_time;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "lux/observation.hpp"
+
+
+// Match trace written with `agent.out --record PATH`.
+//
+// Layout (native little-endian, fixed offsets so the file can be mmap'd and any turn read directly):
+//   TraceHeader
+//   TraceIndexEntry[TRACE_MAX_TURNS], indexed by agent step (bidding = 0)
+//   frames: per turn the observation (Observation::write_binary payload) followed by the emitted
+//           action bytes exactly as written to stdout
+// Static map planes (ice/ore/rubble) are only stored with the step-0 observation; every later
+// turn carries the per-step diffs only. The header and index entry are rewritten after each turn,
+// so the file is readable even if the match is cut short.
+
+#define TRACE_MAGIC "LUXTRACE"
+#define TRACE_VERSION 1
+#define TRACE_MAX_TURNS 1100
+
+typedef struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t max_turns;
+    uint32_t turn_count;  // 1 + highest recorded step
+    uint32_t _pad;
+} TraceHeader;
+
+typedef struct TraceIndexEntry {
+    uint64_t offset;  // 0 if the turn was not recorded
+    uint32_t obs_len;
+    uint32_t actions_len;
+    float turn_time;  // seconds from observation received to actions written
+    uint8_t actions_binary;  // action bytes are a --binary frame instead of json text
+    uint8_t _pad[3];
+} TraceIndexEntry;
+
+typedef struct TraceRecorder {
+    FILE *file;
+    TraceHeader header;
+    uint64_t end_offset;
+    std::string _buf;
+
+    // ~~~ Methods:
+
+    bool open(const char *path);
+    void record(Observation &obs, const std::string &actions, bool actions_binary, double turn_time);
+    void close();
+} TraceRecorder;
+
+typedef struct TraceReader {
+    const char *data;
+    size_t size;
+    const TraceHeader *header;
+    const TraceIndexEntry *index;
+
+    // ~~~ Methods:
+
+    bool open(const char *path);  // mmap, read-only
+    void close();
+    int turn_count();
+    bool has_turn(int step);
+    bool observation(int step, Observation *obs);
+    std::string actions(int step);
+    float turn_time(int step);
+} TraceReader;
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>  // memcpy
+#include <type_traits>  // is_trivially_copyable
+#include <vector>
+
+
+// Old values of scalar fields written while the log is open, so they can be restored in O(writes). Only fields
+// whose writers call record() before writing are covered, see Board::save_begin/save_end/load.
+typedef struct UndoLog {
+    typedef struct Entry {
+        void *field;
+        uint64_t old_value;
+        uint8_t size;
+    } Entry;
+
+    std::vector<Entry> entries;
+    bool active;
+
+    // ~~~ Methods:
+
+    UndoLog() : active(false) {}
+
+    inline void begin() {
+        this->entries.clear();
+        this->active = true;
+    }
+
+    template <typename T>
+    inline void record(T *field) {
+        static_assert(sizeof(T) <= sizeof(uint64_t) && std::is_trivially_copyable<T>::value,
+                      "UndoLog only records small trivially copyable fields");
+        if (!this->active) return;
+        Entry entry{.field = field, .old_value = 0, .size = sizeof(T)};
+        memcpy(&entry.old_value, field, sizeof(T));
+        this->entries.push_back(entry);
+    }
+
+    // Restores recorded fields newest first, then closes the log
+    inline void rollback() {
+        for (auto it = this->entries.rbegin(); it != this->entries.rend(); ++it) {
+            memcpy(it->field, &it->old_value, it->size);
+        }
+        this->entries.clear();
+        this->active = false;
+    }
+} UndoLog;
@@ -8,6 +8,7 @@
 #include "lux/defs.hpp"
 #include "lux/exception.hpp"
 #include "lux/log.hpp"
+#include "lux/pathfind.hpp"
 #include "lux/role_antagonizer.hpp"
 #include "lux/role_blockade.hpp"
 #include "lux/role_cow.hpp"
@@ -26,7 +27,7 @@ bool Unit::_log_cond() {
     return (
         true
         && false
-        && board.sim0()
+        && board().sim0()
         //&& this->id == 32
         && RoleBlockade::cast(this->role)
         );
@@ -72,12 +73,12 @@ UnitConfig g_heavy_cfg = {
 };
 
 void Unit::init(int unit_id, int _player_id, int _x, int _y, bool _heavy, int step,
-		int _ice, int _ore, int _water, int _metal, int _power, json *aq_json) {
+		int _ice, int _ore, int _water, int _metal, int _power, ActionSpec *_aq, int _aq_len) {
     // Init once:
     if (this->build_step == 0) {
 	this->build_step = step;
 	this->id = unit_id;
-	this->player = board.get_player(_player_id);
+	this->player = board().get_player(_player_id);
 	this->heavy = _heavy;
 	this->cfg = _heavy ? &g_heavy_cfg : &g_light_cfg;
         this->role = NULL;
@@ -91,6 +92,7 @@ void Unit::init(int unit_id, int _player_id, int _x, int _y, bool _heavy, int st
         this->prev_prev_water = 0;
         this->prev_rubble = 0;
         this->prev_lichen_strain = -1;
+        memset(this->_ff_safe_version, 0, sizeof(this->_ff_safe_version));
     }
 
     // Re-init every step:
@@ -108,14 +110,14 @@ void Unit::init(int unit_id, int _player_id, int _x, int _y, bool _heavy, int st
     this->action_queue_cost_iou = false;
 
     // Register unit with cell
-    if (step > board.sim_step) {
+    if (step > board().sim_step) {
         // Only executed for future units:
         this->register_move(Direction_CENTER);  // sets unit_next
     } else {
         // Not executed for future units:
-        this->cell()->unit = this;
+        board().set_unit(this->cell(), this);
         this->cell_history.push_back(this->cell());
-        // Note: cell.unit_history updated in Board::begin_step
+        // Note: unit history planes updated in Board::begin_step_cells
     }
 
     // Process given action queue
@@ -123,26 +125,19 @@ void Unit::init(int unit_id, int _player_id, int _x, int _y, bool _heavy, int st
     this->aq_len = 0;
     new_action_queue.clear();
 
-    // Future units have no prior json AQ
-    if (aq_json) {
-        for (auto &a_json : *aq_json) {
-            ActionSpec *spec = &this->raw_action_queue[this->raq_len++];
-            spec->action = a_json.at(0);
-            spec->direction = a_json.at(1);
-            spec->resource = a_json.at(2);
-            spec->amount = a_json.at(3);
-            spec->repeat = a_json.at(4);
-            spec->n = a_json.at(5);
+    // Future units have no prior AQ
+    if (_aq) {
+        for (int i = 0; i < _aq_len; i++) {
+            this->raw_action_queue[this->raq_len++] = _aq[i];
         }
         this->expand_raw_action_queue();
     }
 }
 
 void Unit::save_end() {
-    if (this->build_step > board.sim_step) return;  // Ignore future units created this sim step
+    if (this->build_step > board().sim_step) return;  // Ignore future units created this sim step
     this->_save_role = this->role->copy();
     this->_save_route = this->route;
-    this->_save_assigned_factory = this->assigned_factory;
     //if (this->_log_cond()) LUX_LOG("Do " << *this << ' ' << this->action);
 }
 
@@ -150,20 +145,19 @@ void Unit::load() {
     if (this->role) delete this->role;
     this->role = this->_save_role;
     this->route = this->_save_route;
-    this->assigned_factory = this->_save_assigned_factory;
 }
 
 void Unit::handle_destruction() {
     if (this->role) {
         LUX_LOG("died: " << *this << ' ' << *this->role << ' ' << *this->cell());
     } else {
-        LUX_ASSERT(this->player == board.opp);
+        LUX_ASSERT(this->player == board().opp);
         LUX_LOG("died: " << *this << ' ' << *this->cell());
     }
 }
 
 bool Unit::alive() {
-    return this->alive_step >= board.step;
+    return this->alive_step >= board().step;
 }
 
 string Unit::id_str() {
@@ -171,16 +165,16 @@ string Unit::id_str() {
 }
 
 Cell *Unit::cell() {
-    return board.cell(this->x, this->y);
+    return board().cell(this->x, this->y);
 }
 
 Cell *Unit::cell_next() {
     if (this->x_delta == INT16_MAX) return NULL;
-    return board.cell(this->x + this->x_delta, this->y + this->y_delta);
+    return board().cell(this->x + this->x_delta, this->y + this->y_delta);
 }
 
 Cell *Unit::cell_at(int step) {
-    LUX_ASSERT(step <= board.step);
+    LUX_ASSERT(step <= board().step);
     if (step < this->build_step) return NULL;  // unborn
     int idx = step - this->build_step;
     if (!this->alive() && idx >= this->cell_history.size()) return NULL;  // dead
@@ -189,7 +183,7 @@ Cell *Unit::cell_at(int step) {
                 << " idx=" << idx
                 << " size=" << this->cell_history.size()
                 << " step=" << step
-                << " bstep=" << board.step
+                << " bstep=" << board().step
                 << " build_step=" << this->build_step);
     }*/
     LUX_ASSERT(idx >= 0);
@@ -198,26 +192,26 @@ Cell *Unit::cell_at(int step) {
 }
 
 void Unit::update_stats_begin() {
-    LUX_ASSERT(board.step == board.sim_step);  // Only called beginning of first sim step
+    LUX_ASSERT(board().step == board().sim_step);  // Only called beginning of first sim step
 
     if (!this->alive()) return;
 
     // Update last_factory for all units
     Cell *cur_cell = this->cell();
-    if (cur_cell->factory) {
-        this->last_factory = cur_cell->factory;  // must be before f.update_units
+    if (cur_cell->factory()) {
+        this->last_factory = cur_cell->factory();  // must be before f.update_units
     } else if (!this->last_factory  // created same step as factory destroyed
                || !this->last_factory->alive()) {
         this->last_factory = cur_cell->nearest_factory(this->player);
     }
 
     // Own units only:
-    if (this->player == board.player) {
+    if (this->player == board().player) {
         this->update_antagonizer_unit();
     }
 
     // Opp units only:
-    if (this->player == board.opp) {
+    if (this->player == board().opp) {
         // Calculate low_power info for opp units
         this->update_low_power();
         this->update_is_trapped();
@@ -226,31 +220,31 @@ void Unit::update_stats_begin() {
         if (!this->cell_history.empty() && cur_cell == this->cell_history.back()) {
             if ((cur_cell->ice && this->ice > this->prev_ice)
                 || (cur_cell->ore && this->ore > this->prev_ore)
-                || ((cur_cell->ice || cur_cell->ore) && cur_cell->rubble < this->prev_rubble)) {
+                || ((cur_cell->ice || cur_cell->ore) && cur_cell->rubble() < this->prev_rubble)) {
                 // Save to unit and board
-                this->mine_cell_steps.push_back(make_pair(cur_cell, board.step - 1));
+                this->mine_cell_steps.push_back(make_pair(cur_cell, board().step - 1));
                 auto &board_cell_steps = (this->heavy
-                                          ? board.heavy_mine_cell_steps
-                                          : board.light_mine_cell_steps);
-                board_cell_steps.push_back(make_pair(cur_cell, board.step - 1));
+                                          ? board().heavy_mine_cell_steps
+                                          : board().light_mine_cell_steps);
+                board_cell_steps.push_back(make_pair(cur_cell, board().step - 1));
             }
-            else if (cur_cell->rubble < this->prev_rubble
+            else if (cur_cell->rubble() < this->prev_rubble
                      && !cur_cell->ice
                      && !cur_cell->ore) {
                 // Save to board
                 auto &board_cell_steps = (this->heavy
-                                           ? board.heavy_cow_cell_steps
-                                           : board.light_cow_cell_steps);
-                board_cell_steps.push_back(make_pair(cur_cell, board.step - 1));
+                                           ? board().heavy_cow_cell_steps
+                                           : board().light_cow_cell_steps);
+                board_cell_steps.push_back(make_pair(cur_cell, board().step - 1));
             }
             else if (this->prev_rubble == 0
-                     && cur_cell->rubble > 0
+                     && cur_cell->rubble() > 0
                      && this->prev_lichen_strain != -1
-                     && cur_cell->lichen_strain == -1) {
+                     && cur_cell->lichen_strain() == -1) {
                 // Save to factory
-                Factory *factory = &board.factories[this->prev_lichen_strain];
+                Factory *factory = &board().factories[this->prev_lichen_strain];
                 if (factory->alive()) {
-                    factory->pillage_cell_steps.push_back(make_pair(cur_cell, board.step - 1));
+                    factory->pillage_cell_steps.push_back(make_pair(cur_cell, board().step - 1));
                 }
             }
         }
@@ -260,15 +254,15 @@ void Unit::update_stats_begin() {
     this->prev_ore = this->ore;
     this->prev_prev_water = this->prev_water;
     this->prev_water = this->water;
-    this->prev_rubble = cur_cell->rubble;
-    this->prev_lichen_strain = cur_cell->lichen_strain;
+    this->prev_rubble = cur_cell->rubble();
+    this->prev_lichen_strain = cur_cell->lichen_strain();
 }
 
 void Unit::update_assigned_factory(Factory *new_factory) {
     if (!new_factory) new_factory = this->role->get_factory();
     if (new_factory != this->assigned_factory) {
         this->assigned_factory->remove_unit(this);
-        this->assigned_factory = new_factory;
+        board().set_assigned_factory(this, new_factory);
         this->assigned_factory->add_unit(this);
     }
 }
@@ -282,7 +276,7 @@ void Unit::update_antagonizer_unit() {
         Unit *threat_unit = this->threat_unit_steps[i].first;
         if (!threat_unit->alive()) continue;
         int recent_step = this->threat_unit_steps[i].second;
-        if (recent_step < board.step - 2) break;
+        if (recent_step < board().step - 2) break;
         if (checked.count(threat_unit)) continue;
         checked.insert(threat_unit);
 
@@ -290,7 +284,7 @@ void Unit::update_antagonizer_unit() {
         for (int j = i - 1; j >= 0; j--) {
             Unit *past_threat_unit = this->threat_unit_steps[j].first;
             int past_step = this->threat_unit_steps[j].second;
-            if (past_step < board.step - 6) break;
+            if (past_step < board().step - 6) break;
             // TODO: Require that threat_unit be in same/similar cell each time?
             //       otherwise e.g. an opp heavy moving past/through a unit can trigger this
             if (past_threat_unit == threat_unit) count++;
@@ -303,9 +297,9 @@ void Unit::update_antagonizer_unit() {
 
             // Check to see if opp unit is oscillating
             if (this->heavy == threat_unit->heavy
-                && threat_unit->cell_at(board.step) != threat_unit->cell_at(board.step - 1)
-                && threat_unit->cell_at(board.step) == threat_unit->cell_at(board.step - 2)
-                && threat_unit->cell_at(board.step - 1) == threat_unit->cell_at(board.step - 3)) {
+                && threat_unit->cell_at(board().step) != threat_unit->cell_at(board().step - 1)
+                && threat_unit->cell_at(board().step) == threat_unit->cell_at(board().step - 2)
+                && threat_unit->cell_at(board().step - 1) == threat_unit->cell_at(board().step - 3)) {
                 threat_unit->oscillating_unit = this;
                 //if (this->_log_cond()) LUX_LOG(*threat_unit << " oscillating with " << *this);
             }
@@ -338,7 +332,7 @@ int Unit::steps_until_power(int amount) {
     int _power = 0;
     int step_count = 0;
     while (_power < remainder_power) {
-        _power += this->power_gain(board.step + step_count++);
+        _power += this->power_gain(board().step + step_count++);
     }
 
     return 50 * full_days + step_count;
@@ -425,9 +419,9 @@ void Unit::compress_new_action_queue() {
 }
 
 void Unit::normalize_action_queue() {
-    int i = board.sim_step - board.step;
-    if (this->player != board.player
-        || this->action_queue_cost_step < board.sim_step
+    int i = board().sim_step - board().step;
+    if (this->player != board().player
+        || this->action_queue_cost_step < board().sim_step
         || this->action_queue_cost_iou
         || i >= this->aq_len) return;
 
@@ -473,6 +467,7 @@ void Unit::new_role(Role *new_role) {
         this->delete_role();
     }
     this->role = new_role;
+    board().reset_ff_safe(this->cell(), 2);  // role affects own and neighbors' move_risk
     if (this->_log_cond()) LUX_LOG("   " << *this << ' ' << *this->role);
 
     this->role->set();
@@ -499,7 +494,7 @@ void Unit::update_goal() {
 }
 
 int Unit::power_gain(int step) {
-    step = (step == -1) ? board.sim_step : step;
+    step = (step == -1) ? board().sim_step : step;
     return step % CYCLE_LENGTH < DAY_LENGTH ? this->cfg->CHARGE : 0;
 }
 
@@ -520,7 +515,7 @@ int Unit::power_gain(int step, int end_step) {
 }
 
 bool Unit::need_action_queue_cost(ActionSpec *spec) {
-    if (this->action_queue_cost_step < board.sim_step) return false;
+    if (this->action_queue_cost_step < board().sim_step) return false;
 
     int i = this->new_action_queue.size();  // Less than (sim_step - step) for future created units
     return this->action_queue_cost_iou || i >= this->aq_len || !spec->equal(&this->action_queue[i]);
@@ -577,7 +572,7 @@ void Unit::future_route(Factory *dest_factory, int max_len, vector<Cell*> *route
 
         route->push_back(cur_cell);
         if (route->size() > max_len  // route length is actually 1 shorter than vector length..
-            || cur_cell->factory == dest_factory) {
+            || cur_cell->factory() == dest_factory) {
             // Reached dest or maxed out len, cut off here
             break;
         }
@@ -595,7 +590,7 @@ void Unit::update_low_power() {
         return;
     }
 
-    bool is_player = (this->player == board.player);
+    bool is_player = (this->player == board().player);
     Cell *cur_cell = this->cell();
     Cell *goal_cell = NULL;
     RoleBlockade *role_blockade;
@@ -621,7 +616,7 @@ void Unit::update_low_power() {
             Cell *next_cell = cur_cell->neighbor_toward(goal_cell);
             do_something_cost = this->move_basic_cost(next_cell);
             cur_cell = next_cell;
-        } else if (board.sim0() && this->move_risk(cur_cell)) {
+        } else if (board().sim0() && this->move_risk(cur_cell)) {
             for (Cell *neighbor : cur_cell->neighbors) {
                 do_something_cost = MAX(do_something_cost, this->move_basic_cost(neighbor));
             }
@@ -632,7 +627,7 @@ void Unit::update_low_power() {
         } else {
             // at goal, not threatened, not a digger -> 0 cost
         }
-    } else if (!cur_cell->factory) {  // opp unit
+    } else if (!cur_cell->factory()) {  // opp unit
         // If no plans to move immediately, assume they will update AQ at least once
         if (this->aq_len == 0
             || this->action_queue[0].action != UnitAction_MOVE
@@ -643,13 +638,13 @@ void Unit::update_low_power() {
 
     // TODO: Start with naive estimates?
     //int dist = cur_cell->man_dist_factory(factory);
-    //int end_step = board.sim_step + dist + (is_player ? 0 : -1);
-    //this->low_power_threshold = baseline_power + board.naive_cost(this, cur_cell, factory->cell);
-    //int power_gain = this->power_gain(board.sim_step, end_step);
+    //int end_step = board().sim_step + dist + (is_player ? 0 : -1);
+    //this->low_power_threshold = baseline_power + board().naive_cost(this, cur_cell, factory->cell);
+    //int power_gain = this->power_gain(board().sim_step, end_step);
     //if (this->power - do_something_cost + power_gain < this->low_power_threshold) {
     // Maybe low power! Calculate exact return route to determine for sure.
 
-    int return_cost = board.pathfind(
+    int return_cost = board().pathfind(
         this, cur_cell, factory->cell,
         NULL, NULL, NULL, &this->low_power_route);
     if (return_cost == INT_MAX) {
@@ -657,11 +652,11 @@ void Unit::update_low_power() {
     } else {
         this->low_power_threshold = baseline_power + return_cost;
     }
-    int end_step = board.sim_step + this->low_power_route.size()-1 + (is_player ? 0 : -1);
-    int power_gain = this->power_gain(board.sim_step, end_step);
+    int end_step = board().sim_step + this->low_power_route.size()-1 + (is_player ? 0 : -1);
+    int power_gain = this->power_gain(board().sim_step, end_step);
     if (this->power - do_something_cost + power_gain < this->low_power_threshold) {
         this->low_power = true;
-        /*if (board.sim0() && this->id == 30) {
+        /*if (board().sim0() && this->id == 30) {
             LUX_LOG("Low Power " << *this << ' '
                     << this->power
                     << " - " << do_something_cost
@@ -673,8 +668,8 @@ void Unit::update_low_power() {
 }
 
 bool Unit::is_stationary(int steps) {
-    Cell *cur_cell = this->cell_at(board.step);
-    for (int step = MAX(0, board.step - steps); step < board.step; step++) {
+    Cell *cur_cell = this->cell_at(board().step);
+    for (int step = MAX(0, board().step - steps); step < board().step; step++) {
         if (cur_cell->get_unit_history(step) != this) return false;
     }
     return true;
@@ -716,32 +711,31 @@ bool Unit::threat_units(Cell *cell, int past_steps, int max_radius,
     if (this->heavy) ignore_lights = true;
     LUX_ASSERT(!(ignore_heavies && ignore_lights));
 
-    if (threat_units) threat_units->clear();
-    Player *opp_player = (this->player == board.player) ? board.opp : board.player;
+    Player *opp_player = (this->player == board().player) ? board().opp : board().player;
+    if (!threat_units) {  // existence only, so sweep the history planes in any order
+        return board().history_any_unit(cell, max_radius, past_steps, opp_player,
+                                      !ignore_heavies, !ignore_lights);
+    }
 
+    threat_units->clear();
     Cell *radius_cell = cell->radius_cell(max_radius);
     while (radius_cell) {
-        for (int step = board.step; step >= MAX(0, board.step - past_steps + 1); step--) {
+        for (int step = board().step; step >= MAX(0, board().step - past_steps + 1); step--) {
             Unit *unit = radius_cell->get_unit_history(step, opp_player);
             if (unit
                 && unit->alive()
                 && ((unit->heavy && !ignore_heavies) || (!unit->heavy && !ignore_lights))) {
-                if (threat_units) {
-                    threat_units->push_back(unit);
-                } else {
-                    return true;
-                }
+                threat_units->push_back(unit);
             }
         }
         radius_cell = cell->radius_cell(max_radius, radius_cell);
     }
 
-    if (threat_units && !threat_units->empty()) return true;
-    return false;
+    return !threat_units->empty();
 }
 
 int Unit::standoff_steps(struct Unit *opp_unit) {
-    if (board.sim_step > board.step) return 0;
+    if (board().sim_step > board().step) return 0;
     if (!this->antagonizer_unit) return 0;  // Standoff is a subset of antagonized
 
     // Opp needs to plan to be stationary (or no plan)
@@ -753,7 +747,7 @@ int Unit::standoff_steps(struct Unit *opp_unit) {
     Cell *opp_cell = opp_unit->cell();
     for (int jump = 1; jump <= 2; jump++) {
         // Count number of consecutive steps (or every other step) that opp_unit has threatened unit
-        int prev_step = board.step - jump;
+        int prev_step = board().step - jump;
         int standoff_count = 0;
         for (int i = (int)this->threat_unit_steps.size() - 1; i >= 0; i--) {
             Unit *threat_unit = this->threat_unit_steps[i].first;
@@ -777,14 +771,14 @@ int Unit::standoff_steps(struct Unit *opp_unit) {
 
 bool Unit::break_standoff(struct Unit *opp_unit) {
     // Never assume opp unit will break standoff against own unit
-    if (opp_unit->player == board.player) return false;
+    if (opp_unit->player == board().player) return false;
 
     int standoff_steps = this->standoff_steps(opp_unit);
     if (standoff_steps <= 1) return false;
     double break_chance = 0;
 
     // endgame
-    if (board.sim_step >= 980) {
+    if (board().sim_step >= 980) {
         //                                      0    1    2
         static double const break_chance_d[] = {0, 0.7, 0.9};
         static int const bc_len_d = sizeof(break_chance_d) / sizeof(break_chance_d[0]);
@@ -792,7 +786,7 @@ bool Unit::break_standoff(struct Unit *opp_unit) {
     }
     // low power and oscillating
     else if (RoleRecharge::cast(this->role)
-        && this->cell_at(board.step) != this->cell_at(board.step - 1)) {
+        && this->cell_at(board().step) != this->cell_at(board().step - 1)) {
         //                                      0  1    2    3
         static double const break_chance_a[] = {0, 0, 0.7, 0.9};
         static int const bc_len_a = sizeof(break_chance_a) / sizeof(break_chance_a[0]);
@@ -806,7 +800,7 @@ bool Unit::break_standoff(struct Unit *opp_unit) {
         break_chance = break_chance_b[MIN(standoff_steps, bc_len_b - 1)];
     }
     // protected miner moving off factory
-    else if (this->cell()->factory
+    else if (this->cell()->factory()
              && RoleMiner::cast(this->role)
              && RoleMiner::cast(this->role)->protector) {
         //                                      0  1    2    3    4    5    6
@@ -821,7 +815,7 @@ bool Unit::break_standoff(struct Unit *opp_unit) {
         static int const bc_len_c = sizeof(break_chance_c) / sizeof(break_chance_c[0]);
         break_chance = break_chance_c[MIN(standoff_steps, bc_len_c - 1)];
     }
-    bool ret = prandom(board.sim_step + this->id, break_chance);
+    bool ret = prandom(board().sim_step + this->id, break_chance);
     if (this->_log_cond()) LUX_LOG(*this << " break standoff " << *opp_unit << ' '
                                    << standoff_steps << ' ' << break_chance << ' ' << ret);
     return ret;
@@ -832,18 +826,18 @@ int Unit::move_basic_cost(Cell *move_cell, int move_cost, double rubble_movement
     rubble_movement_cost = (rubble_movement_cost < 0
                             ? this->cfg->RUBBLE_MOVEMENT_COST
                             : rubble_movement_cost);
-    return move_cost + static_cast<int>(rubble_movement_cost * move_cell->rubble);
+    return move_cost + static_cast<int>(rubble_movement_cost * move_cell->rubble());
 }
 
 int Unit::move_count(bool include_center) {
-    LUX_ASSERT(this->player == board.player);
+    LUX_ASSERT(this->player == board().player);
     LUX_ASSERT(!this->cell_next());
 
     int count = 0;
     vector<Cell*> &neighbors = include_center ? this->cell()->neighbors_plus : this->cell()->neighbors;
     for (Cell *move_cell : neighbors) {
         // Cell claimed by own unit or opp factory
-        if (move_cell->unit_next || move_cell->opp_factory(this->player)) {
+        if (move_cell->unit_next() || move_cell->opp_factory(this->player)) {
             continue;
         }
 
@@ -867,11 +861,27 @@ int Unit::move_count(bool include_center) {
 }
 
 bool Unit::move_is_safe_from_friendly_fire(Cell *move_cell) {
-    LUX_ASSERT(this->player == board.player);
+    // Only depends on bookings, positions, power and roles, so memoize until one changes
+    Cell *cur_cell = this->cell();
+    if (cur_cell->man_dist(move_cell) > 1) return this->_move_is_safe_from_friendly_fire(move_cell);
+    Direction direction = cur_cell->neighbor_to_direction(move_cell);
+    if (this->_ff_safe_version[direction] != board().booking_version) {
+        this->_ff_safe[direction] = this->_move_is_safe_from_friendly_fire(move_cell);
+        this->_ff_safe_version[direction] = board().booking_version;
+    }
+#ifdef DEBUG_BUILD
+    // The check also reads friends' power and move_risk, which no reset_ff_safe tracks directly
+    LUX_ASSERT(this->_ff_safe[direction] == this->_move_is_safe_from_friendly_fire(move_cell));
+#endif
+    return this->_ff_safe[direction];
+}
+
+bool Unit::_move_is_safe_from_friendly_fire(Cell *move_cell) {
+    LUX_ASSERT(this->player == board().player);
     LUX_ASSERT(!this->cell_next());
 
     // A friendly unit has already registered a move here (assume cannot be this unit)
-    if (move_cell->unit_next) {
+    if (move_cell->unit_next()) {
         //if (this->_log_cond()) LUX_LOG(*this << " cannot move " << *move_cell << " A "
         //                               << *move_cell->unit_next);
         return false;
@@ -879,8 +889,8 @@ bool Unit::move_is_safe_from_friendly_fire(Cell *move_cell) {
 
     // Avoiding low power friendlies is not a concern during final night
     Unit *friend_unit = move_cell->own_unit();
-    if (board.final_night()
-        && !board.player->is_strain(move_cell->lichen_strain)
+    if (board().final_night()
+        && !board().player->is_strain(move_cell->lichen_strain())
         && (!friend_unit
             || this->heavy
             || !friend_unit->heavy)) {
@@ -911,7 +921,7 @@ bool Unit::move_is_safe_from_friendly_fire(Cell *move_cell) {
         friend_unit = neighbor->own_unit();
         if (friend_unit
             && friend_unit != this
-            && (neighbor->unit_next || friend_unit->move_risk(neighbor) > 0)
+            && (neighbor->unit_next() || friend_unit->move_risk(neighbor) > 0)
             && !friend_unit->cell_next()
             && friend_unit->move_risk(move_cell) <= 0
             && friend_unit->power >= friend_unit->move_cost(move_cell)) {
@@ -932,10 +942,10 @@ int Unit::move_risk(Cell *move_cell, vector<Unit*> *threat_units, bool all_colli
     if (move_cell->own_factory(this->player)) return 0;
 
     // TODO:
-    // Disregard opp_units that are far from own_unit at board.step?
+    // Disregard opp_units that are far from own_unit at board().step?
     // Disregard all opp_units after some amount of forward sim?
     // Use AQ-predicted location for opp_unit?
-    if (board.sim_step > board.step + 5) return 0;
+    if (board().sim_step > board().step + 5) return 0;
 
     int risk = 0;
     bool is_own_move = this->cell() != move_cell;
@@ -982,7 +992,7 @@ int Unit::move_risk(Cell *move_cell, vector<Unit*> *threat_units, bool all_colli
             int own_power = this->power_init;
             int opp_power = opp_unit->power_init;
             // Consider AQ cost when i==0
-            if (board.sim_step == board.step) {
+            if (board().sim_step == board().step) {
                 Direction own_direction = this->cell()->neighbor_to_direction(move_cell);
                 Direction opp_direction = neighbor->neighbor_to_direction(move_cell);
                 if (!(this->aq_len > 0
@@ -1029,7 +1039,11 @@ void Unit::register_move(Direction direction) {
         this->x_delta = 0;
         this->y_delta = 0;
     }
-    this->cell_next()->unit_next = this;
+    Cell *next_cell = this->cell_next();
+    board().set_unit_next(next_cell, this);
+
+    // Friendly fire checks look at bookings up to 2 cells beyond the neighbor being checked
+    board().reset_ff_safe(next_cell, 3);
 }
 
 Direction Unit::move_direction(Cell *goal_cell) {
@@ -1038,14 +1052,14 @@ Direction Unit::move_direction(Cell *goal_cell) {
     if (this->route.size()) {
         Cell *route_dest_cell = this->route[this->route.size() - 1];
         if ((route_dest_cell == goal_cell)
-            || (goal_cell->factory_center && route_dest_cell->factory == goal_cell->factory)) {
+            || (goal_cell->factory_center && route_dest_cell->factory() == goal_cell->factory())) {
             auto route_cur_cell_it = find(this->route.begin(), this->route.end(), cur_cell);
             if (route_cur_cell_it != this->route.end()) {
                 int cur_i = route_cur_cell_it - this->route.begin();
                 int next_i = MIN(cur_i + 1, (int)this->route.size() - 1);
                 Cell *move_cell = this->route[next_i];
                 bool safe_from_friendly = this->move_is_safe_from_friendly_fire(move_cell);
-                bool safe_from_opp = !((board.step == board.sim_step
+                bool safe_from_opp = !((board().step == board().sim_step
                                         || cur_cell->man_dist(route_dest_cell) <= 1)
                                        && this->move_risk(move_cell) > 0);  // near or present danger
                 if (safe_from_friendly && safe_from_opp) {
@@ -1064,8 +1078,8 @@ Direction Unit::move_direction(Cell *goal_cell) {
 
     RoleBlockade *role_blockade;
     if ((role_blockade = RoleBlockade::cast(this->role))
-        && role_blockade->force_direction_step.first == board.step
-        && role_blockade->force_direction_step.second == board.sim_step) {
+        && role_blockade->force_direction_step.first == board().step
+        && role_blockade->force_direction_step.second == board().sim_step) {
         return role_blockade->force_direction;
     }
 
@@ -1083,7 +1097,7 @@ Direction Unit::move_direction(Cell *goal_cell) {
             // Some exceptions:
             if (this->heavy
                 && RolePincer::cast(this->role)
-                && (!move_cell->unit || !move_cell->unit->heavy)) {
+                && (!move_cell->unit() || !move_cell->unit()->heavy)) {
                 // Allow it
             } else {
                 //if (this->_log_cond()) {
@@ -1095,12 +1109,12 @@ Direction Unit::move_direction(Cell *goal_cell) {
         }
 
         vector<Unit*> threat_units;
-        vector<Unit*> *threat_units_ptr = board.sim0() ? &threat_units : NULL;
+        vector<Unit*> *threat_units_ptr = board().sim0() ? &threat_units : NULL;
         int risk = this->move_risk(move_cell, threat_units_ptr);
 
         // If player unit is taking cur_cell, increase risk if cannot afford this move_cell
         Direction move_direction = cur_cell->neighbor_to_direction(move_cell);
-        if (cur_cell->unit_next && this->power < this->move_cost(move_direction)) risk += 10;
+        if (cur_cell->unit_next() && this->power < this->move_cost(move_direction)) risk += 10;
 
         // If we can safely move directly to goal, do it.
         if (move_cell == goal_cell && !goal_cell->factory_center && risk <= 0) {
@@ -1127,7 +1141,7 @@ Direction Unit::move_direction(Cell *goal_cell) {
             if (c->away_dist == 1) cost += 20 * u->cfg->MOVE_COST;
             else if (c->away_dist == 2) cost += 14 * u->cfg->MOVE_COST;
             else if (c->away_dist == 3) cost += 10 * u->cfg->MOVE_COST;
-            if (c->factory) cost += u->cfg->MOVE_COST;
+            if (c->factory()) cost += u->cfg->MOVE_COST;
             if (c->factory_center) cost += u->cfg->MOVE_COST;
             Unit *opp_unit;
             for (Cell *neighbor : c->neighbors_plus) {
@@ -1146,9 +1160,9 @@ Direction Unit::move_direction(Cell *goal_cell) {
                 || this->role->goal != this->assigned_factory)
             && !very_safe_avoid_cond(move_cell)) {
             cost_mult = 0.1;
-            cost = board.pathfind(
+            cost = board().pathfind_t(
                 this, move_cell, goal_cell,
-                NULL, very_safe_avoid_cond, very_safe_cost, &move_route);
+                PathNone(), very_safe_avoid_cond, very_safe_cost, &move_route);
         }
 
         // Safe route:
@@ -1168,7 +1182,7 @@ Direction Unit::move_direction(Cell *goal_cell) {
                         || RolePowerTransporter::cast(c->assigned_unit->role)));
             } else {  // light:
                 if (c->factory_center  // Factory center
-                    || (c->factory && c->unit)  // Occupied factory
+                    || (c->factory() && c->unit())  // Occupied factory
                     || (c->assigned_unit && c->assigned_unit != this)) {  // Assignment
                     return true;
                 }
@@ -1193,9 +1207,9 @@ Direction Unit::move_direction(Cell *goal_cell) {
                  && this->role->goal_type == 'u')
             && !safe_route_avoid_cond(move_cell)) {
             cost_mult = 1;
-            cost = board.pathfind(
+            cost = board().pathfind_t(
                 this, move_cell, goal_cell,
-                NULL, safe_route_avoid_cond, NULL, &move_route);
+                PathNone(), safe_route_avoid_cond, PathNone(), &move_route);
         }
 
         // Unsafe route:
@@ -1227,9 +1241,9 @@ Direction Unit::move_direction(Cell *goal_cell) {
                 rubble_cost = 0;
             }
             cost_mult = 4;
-            cost = board.pathfind(
+            cost = board().pathfind_t(
                 this, move_cell, goal_cell,
-                NULL, unsafe_route_avoid_cond,
+                PathNone(), unsafe_route_avoid_cond,
                 [&](Cell *c, Unit *u) { return u->move_basic_cost(c, move_cost, rubble_cost); },
                 &move_route);
         }
@@ -1238,7 +1252,7 @@ Direction Unit::move_direction(Cell *goal_cell) {
         //   Straight line
         if (cost == INT_MAX && true) {
             cost_mult = 10;
-            cost = board.pathfind(this, move_cell, goal_cell, NULL, NULL, NULL, &move_route);
+            cost = board().pathfind(this, move_cell, goal_cell, NULL, NULL, NULL, &move_route);
             if (cost == INT_MAX) {
                 LUX_LOG("WARNING: BAD RECKLESS ROUTE " << *this << ' ' << *this->role
                         << ' ' << *cur_cell << ' ' << *move_cell << ' ' << *goal_cell);
@@ -1284,7 +1298,7 @@ Direction Unit::move_direction(Cell *goal_cell) {
         if (risk_cost < best_risk_cost
             || (risk_cost == best_risk_cost
                 && !RoleBlockade::cast(this->role)
-                && prandom(board.sim_step + this->id + (int)move_direction, 0.5))) {
+                && prandom(board().sim_step + this->id + (int)move_direction, 0.5))) {
             best_risk_cost = risk_cost;
             best_direction = move_direction;
             this->route = move_route;
@@ -1293,7 +1307,7 @@ Direction Unit::move_direction(Cell *goal_cell) {
 
     // Record threats affecting this step's movement
     for (Unit *threat_unit : best_threat_units) {
-        this->threat_unit_steps.push_back(make_pair(threat_unit, board.step));
+        this->threat_unit_steps.push_back(make_pair(threat_unit, board().step));
     }
 
     //if (this->_log_cond()) {
@@ -1301,7 +1315,7 @@ Direction Unit::move_direction(Cell *goal_cell) {
     //            << DirectionStr[best_direction] << ", threat_count=" << best_threat_units.size());
     //}
 
-    //if (this->_log_cond() && board.step >= 144 && board.step <= 173) {
+    //if (this->_log_cond() && board().step >= 144 && board().step <= 173) {
     //    for (Cell *route_cell : this->route) {
     //        LUX_LOG("  " << *route_cell);
     //    }
@@ -1357,11 +1371,11 @@ int Unit::dig_cost() {
 
 void Unit::do_dig() {
     Cell *cur_cell = this->cell();
-    if (cur_cell->rubble > 0) {
-        cur_cell->rubble -= MIN(this->cfg->DIG_RUBBLE_REMOVED, cur_cell->rubble);
-    } else if (cur_cell->lichen > 0) {
-        cur_cell->lichen -= MIN(this->cfg->DIG_LICHEN_REMOVED, cur_cell->lichen);
-        if (cur_cell->lichen <= 0) cur_cell->rubble += this->cfg->DIG_RUBBLE_REMOVED;
+    if (cur_cell->rubble() > 0) {
+        cur_cell->rubble() -= MIN(this->cfg->DIG_RUBBLE_REMOVED, cur_cell->rubble());
+    } else if (cur_cell->lichen() > 0) {
+        cur_cell->lichen() -= MIN(this->cfg->DIG_LICHEN_REMOVED, cur_cell->lichen());
+        if (cur_cell->lichen() <= 0) cur_cell->rubble() += this->cfg->DIG_RUBBLE_REMOVED;
     } else if (cur_cell->ice) {
         this->ice_delta += this->cfg->DIG_RESOURCE_GAIN;
     } else if (cur_cell->ore) {
@@ -1412,8 +1426,8 @@ int Unit::transfer_cost(Cell *neighbor, Resource resource, int amount) {
 
 void Unit::do_transfer(Cell *neighbor, Resource resource, int amount, Unit *rx_unit_override) {
     Direction direction = this->cell()->neighbor_to_direction(neighbor);
-    Factory *rx_factory = neighbor->factory;
-    Unit *rx_unit = rx_unit_override ? rx_unit_override : neighbor->unit_next;
+    Factory *rx_factory = neighbor->factory();
+    Unit *rx_unit = rx_unit_override ? rx_unit_override : neighbor->unit_next();
     LUX_ASSERT(rx_factory || rx_unit);
     if (resource == Resource_ICE) {
         int tx = MIN(amount, this->ice);
@@ -1461,7 +1475,7 @@ int Unit::pickup_cost(Resource resource, int amount) {
 }
 
 void Unit::do_pickup(Resource resource, int amount) {
-    Factory *factory = this->cell()->factory;
+    Factory *factory = this->cell()->factory();
     if (resource == Resource_ICE) {
         int tx = MIN(amount, factory->ice + factory->ice_delta);
         this->ice_delta += tx;
@@ -1498,7 +1512,7 @@ void Unit::do_pickup(Resource resource, int amount) {
 }
 
 ostream& operator<<(ostream &os, const struct Unit &u) {
-    if (u.player == &board.home.player) os << (u.heavy ? "H." : "L.") << u.id;
+    if (u.player == &board().home.player) os << (u.heavy ? "H." : "L.") << u.id;
     else                                os << (u.heavy ? "H!" : "L!") << u.id;
     return os;
 }
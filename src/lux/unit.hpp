@@ -91,7 +91,7 @@ typedef struct Unit {
     bool action_queue_cost_iou;  // AQ differs and cost must be paid ASAP
     int action_queue_update_count;
 
-    std::vector<struct Cell*> cell_history;  // use index = (board.step - this->build_step)
+    std::vector<struct Cell*> cell_history;  // use index = (board().step - this->build_step)
     std::vector<std::pair<struct Unit*, int> > threat_unit_steps;
     std::vector<std::pair<struct Cell*, int> > mine_cell_steps;
     std::vector<std::pair<struct Cell*, int> > future_mine_cell_steps;
@@ -103,14 +103,16 @@ typedef struct Unit {
     int8_t prev_rubble;
     int8_t prev_lichen_strain;
 
+    int _ff_safe_version[5];  // per Direction, valid while equal to board().booking_version, reset by nearby bookings
+    bool _ff_safe[5];  // memoized move_is_safe_from_friendly_fire by Direction
+
     struct Role *_save_role;
     std::vector<struct Cell*> _save_route;
-    struct Factory *_save_assigned_factory;
 
     // ~~~ Methods:
 
     void init(int unit_id, int player_id, int x, int y, bool heavy, int step,
-	      int ice, int ore, int water, int metal, int power, json *aq_json);
+	      int ice, int ore, int water, int metal, int power, ActionSpec *aq, int aq_len);
     void save_end();
     void load();
     void handle_destruction();
@@ -159,7 +161,8 @@ typedef struct Unit {
     int move_basic_cost(struct Cell *move_cell,  // no AQ cost
                         int move_cost = -1, double rubble_movement_cost = -1);
     int move_count(bool include_center);
-    bool move_is_safe_from_friendly_fire(struct Cell *move_cell);
+    bool move_is_safe_from_friendly_fire(struct Cell *move_cell);  // memoized, see _ff_safe
+    bool _move_is_safe_from_friendly_fire(struct Cell *move_cell);
     int move_risk(struct Cell *move_cell,
                   std::vector<struct Unit*> *threat_units = NULL,
                   bool all_collisions = false);
@@ -1,5 +1,6 @@
 #include "lux/unit_group.hpp"
 
+#include "agent.hpp"
 #include "lux/action.hpp"
 #include "lux/board.hpp"
 #include "lux/log.hpp"
@@ -22,7 +23,8 @@ using namespace std;
 
 #define DO_ONE_SAFE(ROLE_CAP, ROLE, ACTION)                             \
     void UnitGroup::do_ ## ROLE ## _ ## ACTION(bool heavy) {            \
-        for (Unit *unit : board.player->units()) {                      \
+        agent().time_budget.check_watchdog();                             \
+        for (Unit *unit : board().player->units()) {                      \
             if (unit->last_action_step < this->step                     \
                 && unit->heavy == heavy                                 \
                 && typeid(*unit->role) == typeid(Role ## ROLE_CAP)      \
@@ -32,7 +34,8 @@ using namespace std;
                 unit->last_action_step = this->step; }}}
 #define DO_ONE(ROLE_CAP, ROLE, ACTION)                                  \
     void UnitGroup::do_ ## ROLE ## _ ## ACTION(bool heavy) {            \
-        for (Unit *unit : board.player->units()) {                      \
+        agent().time_budget.check_watchdog();                             \
+        for (Unit *unit : board().player->units()) {                      \
             if (unit->last_action_step < this->step                     \
                 && unit->heavy == heavy                                 \
                 && typeid(*unit->role) == typeid(Role ## ROLE_CAP)      \
@@ -46,7 +49,7 @@ using namespace std;
 
 
 void UnitGroup::finalize() {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         // Record step that AQ cost will be paid
 	if (unit->need_action_queue_cost(&unit->action)) {
             if (unit->power >= unit->cfg->ACTION_QUEUE_POWER_COST) {
@@ -76,8 +79,8 @@ DO_ALL(Relocate, relocate)
 DO_ALL(WaterTransporter, water_transporter)
 
 void UnitGroup::do_move_998() {
-    if (board.sim_step != 998) return;
-    for (Unit *unit : board.player->units()) {
+    if (board().sim_step != 998) return;
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->role->_do_move_998()) {
             unit->last_action_step = this->step;
@@ -86,8 +89,8 @@ void UnitGroup::do_move_998() {
 }
 
 void UnitGroup::do_move_999() {
-    if (board.sim_step != 999) return;
-    for (Unit *unit : board.player->units()) {
+    if (board().sim_step != 999) return;
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->role->_do_move_999()) {
             unit->last_action_step = this->step;
@@ -96,8 +99,8 @@ void UnitGroup::do_move_999() {
 }
 
 void UnitGroup::do_dig_999() {
-    if (board.sim_step != 999) return;
-    for (Unit *unit : board.player->units()) {
+    if (board().sim_step != 999) return;
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->role->_do_dig_999()) {
             unit->last_action_step = this->step;
@@ -106,7 +109,7 @@ void UnitGroup::do_dig_999() {
 }
 
 void UnitGroup::do_move_to_exploding_factory(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && unit->role->_do_move_to_exploding_factory()) {
@@ -116,7 +119,7 @@ void UnitGroup::do_move_to_exploding_factory(bool heavy) {
 }
 
 void UnitGroup::do_pickup_resource_from_exploding_factory(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && unit->move_is_safe_from_friendly_fire(unit->cell())
@@ -127,8 +130,8 @@ void UnitGroup::do_pickup_resource_from_exploding_factory(bool heavy) {
 }
 
 void UnitGroup::do_attack_trapped_unit_move(bool heavy) {
-    if (!board.sim0()) return;
-    for (Unit *unit : board.player->units()) {
+    if (!board().sim0()) return;
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && unit->role->_do_move_attack_trapped_unit()) {
@@ -138,7 +141,7 @@ void UnitGroup::do_attack_trapped_unit_move(bool heavy) {
 }
 
 void UnitGroup::do_move_win_collision(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && (RoleCow::cast(unit->role)
@@ -156,7 +159,7 @@ void UnitGroup::do_move_win_collision(bool heavy) {
 
 void UnitGroup::do_blockade_move(bool heavy, bool primary, bool engaged) {
     RoleBlockade *role;
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && (role = RoleBlockade::cast(unit->role))) {
@@ -173,7 +176,7 @@ void UnitGroup::do_blockade_move(bool heavy, bool primary, bool engaged) {
 }
 
 void UnitGroup::do_chain_transporter_last_chain_move(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         RoleChainTransporter *role = NULL;
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
@@ -186,7 +189,7 @@ void UnitGroup::do_chain_transporter_last_chain_move(bool heavy) {
 }
 
 void UnitGroup::do_chain_transporter_threatened_move(bool heavy, bool last_chain_only) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         RoleChainTransporter *role = NULL;
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
@@ -199,7 +202,7 @@ void UnitGroup::do_chain_transporter_threatened_move(bool heavy, bool last_chain
 }
 
 void UnitGroup::do_chain_transporter_rx_no_move(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         RoleChainTransporter *role = NULL;
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
@@ -213,7 +216,7 @@ void UnitGroup::do_chain_transporter_rx_no_move(bool heavy) {
 
 void UnitGroup::do_chain_transporter_ice_miner_pickup(bool heavy) {
     RoleChainTransporter *role;
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && (role = RoleChainTransporter::cast(unit->role))
@@ -226,7 +229,7 @@ void UnitGroup::do_chain_transporter_ice_miner_pickup(bool heavy) {
 }
 
 void UnitGroup::do_chain_transporter_special_transfer(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if ((unit->last_action_step < this->step
              || (unit->action.action == UnitAction_MOVE
                  && unit->action.direction == Direction_CENTER))  // update a no-move
@@ -245,8 +248,8 @@ void UnitGroup::do_chain_transporter_special_transfer(bool heavy) {
 void UnitGroup::do_miner_protected_move(bool heavy) {
     RoleMiner *role_miner;
     RoleProtector *role_protector;
-    for (Unit *unit : board.player->units()) {
-        if (board.sim0()
+    for (Unit *unit : board().player->units()) {
+        if (board().sim0()
             && unit->last_action_step < this->step
             && unit->heavy == heavy
             && (role_miner = RoleMiner::cast(unit->role))
@@ -282,8 +285,8 @@ void UnitGroup::do_miner_protected_move(bool heavy) {
 void UnitGroup::do_miner_protected_dig(bool heavy) {
     RoleMiner *role_miner;
     RoleProtector *role_protector;
-    for (Unit *unit : board.player->units()) {
-        if (board.sim0()
+    for (Unit *unit : board().player->units()) {
+        if (board().sim0()
             && unit->last_action_step < this->step
             && unit->heavy == heavy
             && (role_miner = RoleMiner::cast(unit->role))
@@ -301,7 +304,7 @@ void UnitGroup::do_miner_protected_dig(bool heavy) {
 void UnitGroup::do_miner_protected_transfer(bool heavy) {
     RoleMiner *role_miner;
     RoleProtector *role_protector;
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && (role_miner = RoleMiner::cast(unit->role))
@@ -309,7 +312,7 @@ void UnitGroup::do_miner_protected_transfer(bool heavy) {
             && (role_protector = RoleProtector::cast(role_miner->protector->role))
             && unit->move_is_safe_from_friendly_fire(unit->cell())) {
             // Protected transfer
-            if (board.sim0()
+            if (board().sim0()
                 && unit->cell() == role_miner->resource_cell
                 && role_protector->is_covering()
                 && unit->role->do_transfer()) {
@@ -317,7 +320,7 @@ void UnitGroup::do_miner_protected_transfer(bool heavy) {
                 unit->last_action_step = this->step;
             }
             // On-factory transfer
-            else if (unit->cell()->factory == role_miner->factory
+            else if (unit->cell()->factory() == role_miner->factory
                      && unit->role->do_transfer()) {
                 if (unit->_log_cond()) LUX_LOG(*unit << " protected miner transfer B");
                 unit->last_action_step = this->step;
@@ -328,7 +331,7 @@ void UnitGroup::do_miner_protected_transfer(bool heavy) {
 
 void UnitGroup::do_miner_protected_pickup(bool heavy) {
     RoleMiner *role_miner;
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && (role_miner = RoleMiner::cast(unit->role))
@@ -341,7 +344,7 @@ void UnitGroup::do_miner_protected_pickup(bool heavy) {
 }
 
 void UnitGroup::do_miner_with_transporters_pickup(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         RoleMiner *role = NULL;
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
@@ -354,7 +357,7 @@ void UnitGroup::do_miner_with_transporters_pickup(bool heavy) {
 }
 
 void UnitGroup::do_miner_with_transporters_no_move(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         RoleMiner *role = NULL;
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
@@ -367,12 +370,12 @@ void UnitGroup::do_miner_with_transporters_no_move(bool heavy) {
 }
 
 void UnitGroup::do_pillager_dangerous_dig(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && typeid(*unit->role) == typeid(RolePillager)
-            && ((heavy && (board.sim_step >= 980 || unit->power < 210))
-                || (!heavy && board.sim_step >= END_PHASE))
+            && ((heavy && (board().sim_step >= 980 || unit->power < 210))
+                || (!heavy && board().sim_step >= END_PHASE))
             && unit->move_is_safe_from_friendly_fire(unit->cell())
             //&& unit->move_risk(unit->cell()) <= 0
             && unit->role->do_dig()) {
@@ -382,7 +385,7 @@ void UnitGroup::do_pillager_dangerous_dig(bool heavy) {
 }
 
 void UnitGroup::do_power_transporter_ice_miner_pickup(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         RolePowerTransporter *role = NULL;
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
@@ -396,7 +399,7 @@ void UnitGroup::do_power_transporter_ice_miner_pickup(bool heavy) {
 }
 
 void UnitGroup::do_water_transporter_emergency_move(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
         if (unit->last_action_step < this->step
             && unit->heavy == heavy
             && RoleWaterTransporter::cast(unit->role)
@@ -413,7 +416,7 @@ void UnitGroup::do_water_transporter_emergency_move(bool heavy) {
 }
 
 void UnitGroup::do_no_move(bool heavy) {
-    for (Unit *unit : board.player->units()) {
+    for (Unit *unit : board().player->units()) {
 	if (unit->last_action_step < this->step && unit->heavy == heavy) {
             // Try not to move from current cell, taking into account potential risks.
             // If no power to do so, do a true no-move.
@@ -0,0 +1,11 @@
+#include "lux/wire.hpp"
+
+using namespace std;
+
+
+bool wire_read_frame(istream &in, string *payload) {
+    uint32_t len;
+    if (!in.read(reinterpret_cast<char*>(&len), sizeof(len))) return false;
+    payload->resize(len);
+    return len == 0 || (bool)in.read(&(*payload)[0], len);
+}
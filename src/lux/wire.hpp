@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>  // memcpy
+#include <iostream>
+#include <string>
+
+
+// Compact binary framing used with `agent.out --binary` (see main.py for the Python side).
+// Every frame is a little-endian uint32 payload length followed by the payload.
+//
+// Observation payload:
+//   i32 step, i32 remainingOverageTime, i32 real_env_steps, i8 player, i32 factories_per_team
+//   2x team: i8 present, i32 water, i32 metal, i8 place_first, u8 strain_count, i16 strains[]
+//   u8 plane flags (1=ice 2=ore 4=rubble 8=valid_spawns_mask), then i8[SIZE2] per plane by cell id
+//   u16 count, cell deltas: i16 cell_id, i8 fields (CellDeltaField bits), i8 rubble, i8 lichen, i8 strain
+//   u16 count, units: i16 id, i8 team_id, i8 heavy, i16 x, i16 y, i32 ice/ore/water/metal/power,
+//                     u8 aq_len, aq_len x (i8 action, i8 direction, i8 resource, i16 amount, i16 repeat, i16 n)
+//   u16 count, factories: i16 strain_id, i8 team_id, i16 x, i16 y, i32 ice/ore/water/metal/power
+//
+// Output payload: u8 kind, then
+//   WireFrame_ACTIONS: u16 count, units: i16 id, u8 len, len x packed ActionSpec (as above)
+//                      u16 count, factories: i16 id, i8 FactoryAction
+//   WireFrame_JSON:    utf-8 json text (bidding/placement steps)
+
+typedef enum WireFrameKind : uint8_t {
+    WireFrame_ACTIONS = 0,
+    WireFrame_JSON = 1,
+} WireFrameKind;
+
+template <typename T>
+inline void wire_put(std::string *buf, T val) {
+    buf->append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <typename T>
+inline void wire_set(std::string *buf, size_t offset, T val) {
+    memcpy(&(*buf)[offset], &val, sizeof(T));
+}
+
+// Bounds-checked reader over one frame payload
+typedef struct WireReader {
+    const char *pos;
+    const char *end;
+    bool ok;
+
+    // ~~~ Methods:
+
+    template <typename T>
+    inline T get() {
+        T val{};
+        if (this->end - this->pos < (long)sizeof(T)) {
+            this->ok = false;
+            return val;
+        }
+        memcpy(&val, this->pos, sizeof(T));
+        this->pos += sizeof(T);
+        return val;
+    }
+
+    inline const char *take(size_t len) {
+        if ((size_t)(this->end - this->pos) < len) {
+            this->ok = false;
+            return NULL;
+        }
+        const char *res = this->pos;
+        this->pos += len;
+        return res;
+    }
+} WireReader;
+
+bool wire_read_frame(std::istream &in, std::string *payload);
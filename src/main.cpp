@@ -4,23 +4,19 @@
 #include <string>
 
 #include "agent.hpp"
+#include "lux/action_writer.hpp"
 #include "lux/board.hpp"
+#include "lux/defs.hpp"
 #include "lux/exception.hpp"
 #include "lux/json.hpp"
 #include "lux/log.hpp"
+#include "lux/match.hpp"
+#include "lux/observation.hpp"
+#include "lux/trace.hpp"
+#include "lux/wire.hpp"
 using namespace std;
 
 
-Agent agent;
-Board board;
-bool g_prod;
-
-
-bool LUX_LOG_ON = true;
-bool LUX_LOG_DEBUG_ON = false;
-string LUX_LOG_PLAYER = "player_0";
-
-
 bool is_prod() {
     string res = "";
     char tmp[0x100];
@@ -30,51 +26,98 @@ bool is_prod() {
 }
 
 
-int _main() {
-    g_prod = is_prod();
+int _main(int argc, char **argv) {
+    // One match per process: the runner talks to us over stdin/stdout
+    static MatchContext match;
+    match.bind();
+    match.prod = is_prod();
+    LUX_LOG_ON = true;
+    LUX_LOG_DEBUG_ON = false;
+    LUX_LOG_PLAYER = "player_0";
+
+    // --json-dom: parse each observation into a full json DOM instead of streaming it
+    // --binary: length-prefixed binary frames in and out instead of json lines (see lux/wire.hpp)
+    // --record PATH: append every observation and response to a match trace (see lux/trace.hpp)
+    bool json_dom = false;
+    bool binary = false;
+    static TraceRecorder recorder;
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--json-dom") json_dom = true;
+        else if (string(argv[i]) == "--binary") binary = true;
+        else if (string(argv[i]) == "--record" && i + 1 < argc) {
+            // Reported even in release builds, where LUX_LOG is compiled out; the match runs unrecorded
+            if (!recorder.open(argv[++i])) std::cerr << "failed to open trace " << argv[i] << std::endl;
+        }
+    }
+
+    static Observation obs;
+    static ActionWriter writer;
+    writer.binary = binary;
+    string line;
+    double parse_time_total = 0, parse_time_max = 0;
+    int parse_count = 0, parse_fallback_count = 0;
 
-    while (std::cin && !std::cin.eof()) {
+    while (binary ? wire_read_frame(std::cin, &line) : (bool)std::getline(std::cin, line)) {
         LUX_LOG_DEBUG("main A");
-        json input;
-        std::cin >> input;
-        //lux::dumpJsonToFile("input.json", input);
-
-        input.at("step").get_to(agent.step);
-        input.at("remainingOverageTime").get_to(agent.remainingOverageTime);
-        if (agent.step == 0) {
-            input.at("player").get_to(agent.player);
-            input.at("obs").at("board").at("factories_per_team").get_to(agent.factories_per_team);
-            input.at("obs").at("board").at("factories_per_team").get_to(agent.factories_left);
-            LUX_LOG_ON = (g_prod || (agent.player == LUX_LOG_PLAYER));
-        } else if (agent.step == 1) {
-            input.at("obs").at("teams").at(agent.player).at("water").get_to(agent.water_left);
-            input.at("obs").at("teams").at(agent.player).at("metal").get_to(agent.metal_left);
-            input.at("obs").at("teams").at(agent.player).at("place_first").get_to(agent.place_first);
+        if (line.empty() && !binary) continue;
+        double parse_start = get_time();
+        if (binary) {
+            // An empty frame gets no reply frame, and main.py would block forever waiting for one
+            if (line.empty()) {
+                std::cerr << "empty binary frame" << std::endl;
+                return 1;
+            }
+            // A truncated frame leaves obs half-filled and its deltas lost, like malformed json (which throws)
+            if (!obs.parse_binary(line)) {
+                std::cerr << "malformed binary frame (" << line.size() << " bytes)" << std::endl;
+                return 1;
+            }
+        } else if (json_dom || !obs.parse(line)) {
+            if (!json_dom) parse_fallback_count++;
+            json input = json::parse(line);
+            //lux::dumpJsonToFile("input.json", input);
+            obs.load_json(input);
         }
+        obs.parse_time = get_time() - parse_start;
+        parse_time_total += obs.parse_time;
+        parse_time_max = MAX(parse_time_max, obs.parse_time);
+        parse_count++;
+
+        if (obs.step == 0) LUX_LOG_ON = (prod() || (obs.player == LUX_LOG_PLAYER));
 
         LUX_LOG_DEBUG("main B");
-        static bool is_player0 = (agent.player == "player_0");
-        board.init(input.at("obs"), agent.step, is_player0);
+        agent().init(obs);
+
+        if (board().step % 20 == 0 || board().step == 999) {
+            LUX_LOG("parse " << (binary ? "bin" : json_dom ? "dom" : "sax") << ' '
+                    << obs.units.size() << "u " << obs.parse_time * 1000 << "ms"
+                    << " avg=" << parse_time_total * 1000 / parse_count << "ms"
+                    << " max=" << parse_time_max * 1000 << "ms"
+                    << " fallback=" << parse_fallback_count);
+        }
 
         LUX_LOG_DEBUG("main C");
-        json output;
-        if (board.real_env_step < 0) {
-            output = agent.setup();
+        if (board().real_env_step < 0) {
+            json output = agent().setup();
+            //lux::dumpJsonToFile("last_actions.json", output);
+            writer.write_json(output);
         } else {
-            agent.step = board.real_env_step;
-            output = agent.act();
+            agent().step = board().real_env_step;
+            agent().act(&writer);
         }
 
-        LUX_LOG_DEBUG("main D " << output);
-        //lux::dumpJsonToFile("last_actions.json", output);
-        std::cout << output << std::endl;
+        LUX_LOG_DEBUG("main D " << (binary ? "<binary>" : writer.buf));
+        writer.flush(std::cout);
+
+        recorder.record(obs, writer.buf, binary, get_time() - parse_start);
     }
+    recorder.close();
     return 0;
 }
 
-int main() {
+int main(int argc, char **argv) {
     try {
-        return _main();
+        return _main(argc, argv);
     } catch (lux::Exception &e) {
         e.printStackTrace();
         throw;
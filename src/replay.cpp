@@ -0,0 +1,393 @@
+#include <atomic>
+#include <climits>  // INT_MAX
+#include <cstdlib>  // atoi
+#include <iostream>
+#include <memory>  // unique_ptr
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "agent.hpp"
+#include "lux/action_writer.hpp"
+#include "lux/board.hpp"
+#include "lux/defs.hpp"
+#include "lux/exception.hpp"
+#include "lux/factory.hpp"
+#include "lux/log.hpp"
+#include "lux/match.hpp"
+#include "lux/object_pool.hpp"
+#include "lux/observation.hpp"
+#include "lux/pathfind.hpp"
+#include "lux/player.hpp"
+#include "lux/search_workspace.hpp"
+#include "lux/trace.hpp"
+#include "lux/unit.hpp"
+using namespace std;
+
+
+typedef struct ReplayOptions {
+    int from_step;
+    int to_step;
+    bool print_actions;
+    bool prod;
+    bool log;
+    int bench_cells;
+    int bench_pathfind;
+} ReplayOptions;
+
+typedef struct ReplayResult {
+    bool ok;
+    int turns;
+    int matches;
+    int compared;
+    double total_time;
+    double max_time;
+    int max_time_step;
+    std::string output;  // per-turn lines, printed in trace order once all jobs are done
+} ReplayResult;
+
+
+void usage() {
+    cerr << "USAGE: agent_replay TRACE [TRACE...] [OPTIONS]" << endl
+         << "Re-runs the agent in-process over traces recorded with `agent.out --record TRACE`." << endl
+         << "OPTIONS can be:" << endl
+         << "  --from STEP  : only apply observations (no setup/act) before agent step STEP" << endl
+         << "  --to STEP    : stop after agent step STEP" << endl
+         << "  --actions    : print the emitted actions for every turn" << endl
+         << "  --dev        : use dev time/sim limits instead of prod" << endl
+         << "  --log        : enable LUX_LOG output (debug builds)" << endl
+         << "  --jobs N     : replay up to N traces concurrently, one match per worker thread" << endl
+         << "  --bench-cells N : afterwards, time N rounds of the full-board cell sweeps" << endl
+         << "  --bench-pathfind N : afterwards, time N rounds of typical pathfind callers" << endl;
+}
+
+// Times the per-step full-board loops and unit history queries over the final board state. The board is left in an
+// arbitrary state afterwards.
+void bench_cells(int rounds, ostream &out) {
+    double save_time = 0, begin_time = 0, end_time = 0, load_time = 0, threat_time = 0, region_time = 0;
+    int threat_count = 0;
+    for (int i = 0; i < rounds; i++) {
+        // Unit history queries, as issued by roles each step
+        double t = get_time();
+        for (Unit &unit : board().units) {
+            if (unit.alive()) threat_count += unit.threat_units(unit.cell(), 10, 3);
+        }
+        threat_time += get_time() - t;
+
+        t = get_time();
+        board().update_flatlands();
+        board().update_lowlands();
+        region_time += get_time() - t;
+
+        double t0 = get_time();
+        board().save_begin();
+        double t1 = get_time();
+        board().begin_step_cells();
+        double t2 = get_time();
+        board().end_step_cells();
+        double t3 = get_time();
+        board().load_cells();
+        double t4 = get_time();
+        save_time += t1 - t0;
+        begin_time += t2 - t1;
+        end_time += t3 - t2;
+        load_time += t4 - t3;
+    }
+    out << "bench_cells rounds=" << rounds << " us/round:"
+        << " save_begin=" << save_time * 1e6 / rounds
+        << " begin_step_cells=" << begin_time * 1e6 / rounds
+        << " end_step_cells=" << end_time * 1e6 / rounds
+        << " load_cells=" << load_time * 1e6 / rounds
+        << " threat_units=" << threat_time * 1e6 / rounds << " (" << threat_count / rounds << " hits)"
+        << " regions=" << region_time * 1e6 / rounds << endl;
+}
+
+int _flood_cost(SearchWorkspace *ws, Cell *cell) {
+    return ws->reached(cell->id) ? ws->path_info[cell->id].cost : -1;
+}
+
+// One round of searches with the given open list: unit routes home (A*, move costs) and rubble-cost floods from
+// every factory, or only unit-cost floods from every factory. Returns seconds, adds found costs to checksum.
+template <PathQueue Queue>
+double _bench_queue(bool unit_cost, int *checksum) {
+    SearchScope scope;
+    double t = get_time();
+    if (unit_cost) {
+        for (Factory &factory : board().factories) {
+            if (!factory.alive()) continue;
+            (void)board().pathfind_t<Queue>(NULL, factory.cell, NULL,
+                                          [&](Cell *c) { (void)c; return false; },
+                                          PathNone(),
+                                          [&](Cell *c, Unit *u) { (void)c; (void)u; return 1; },
+                                          NULL, INT_MAX, NULL, scope.ws);
+            *checksum += _flood_cost(scope.ws, board().cell(0));
+        }
+    } else if constexpr (Queue != PathQueue_BFS) {
+        for (Unit *unit : board().player->units()) {
+            if (!unit->assigned_factory) continue;
+            int cost = board().pathfind_t<Queue>(unit, unit->cell(), unit->assigned_factory->cell);
+            if (cost != INT_MAX) *checksum += cost;
+        }
+        for (Factory &factory : board().factories) {
+            if (!factory.alive()) continue;
+            (void)board().pathfind_t<Queue>(NULL, factory.cell, NULL,
+                                          [&](Cell *c) { (void)c; return false; },
+                                          PathNone(),
+                                          [&](Cell *c, Unit *u) { (void)u; return 20 + c->rubble(); },
+                                          NULL, INT_MAX, NULL, scope.ws);
+            *checksum += _flood_cost(scope.ws, board().cell(0));
+        }
+    }
+    return get_time() - t;
+}
+
+// Times the same searches with each open list, and checks they find the same costs
+void bench_queues(int rounds, ostream &out) {
+    double heap_time = 0, bucket_time = 0, heap_unit_time = 0, bucket_unit_time = 0, bfs_unit_time = 0;
+    int heap_sum = 0, bucket_sum = 0, heap_unit_sum = 0, bucket_unit_sum = 0, bfs_unit_sum = 0;
+    for (int i = 0; i < rounds; i++) {
+        heap_time += _bench_queue<PathQueue_HEAP>(false, &heap_sum);
+        bucket_time += _bench_queue<PathQueue_BUCKET>(false, &bucket_sum);
+        heap_unit_time += _bench_queue<PathQueue_HEAP>(true, &heap_unit_sum);
+        bucket_unit_time += _bench_queue<PathQueue_BUCKET>(true, &bucket_unit_sum);
+        bfs_unit_time += _bench_queue<PathQueue_BFS>(true, &bfs_unit_sum);
+    }
+    out << "bench_queues rounds=" << rounds << " us/round:"
+        << " heap=" << heap_time * 1e6 / rounds
+        << " bucket=" << bucket_time * 1e6 / rounds
+        << " unit-cost: heap=" << heap_unit_time * 1e6 / rounds
+        << " bucket=" << bucket_unit_time * 1e6 / rounds
+        << " bfs=" << bfs_unit_time * 1e6 / rounds
+        << ((heap_sum == bucket_sum && heap_unit_sum == bucket_unit_sum && heap_unit_sum == bfs_unit_sum)
+            ? "" : " COST MISMATCH") << endl;
+}
+
+// Times the pathfind-heavy analysis done per factory over the final board state. Resource/lowland routes are
+// rebuilt in place and cost fields refilled, so the board is left in an arbitrary state afterwards.
+void bench_pathfind(int rounds, ostream &out) {
+    double route_time = 0, vuln_time = 0, field_time = 0;
+    int route_count = 0, vuln_count = 0, field_count = 0;
+    for (int i = 0; i < rounds; i++) {
+        double t = get_time();
+        board().invalidate_cost_fields();  // resource routes read a cost field
+        for (Factory *factory : board().player->factories()) {
+            factory->update_lowland_routes();
+            factory->update_resource_routes(Resource_ICE, /*dist*/10, /*count*/6);
+            factory->update_resource_routes(Resource_ORE, /*dist*/25, /*count*/3);
+            route_count += (factory->lowland_routes.size()
+                            + factory->ice_routes.size()
+                            + factory->ore_routes.size());
+        }
+        route_time += get_time() - t;
+
+        t = get_time();
+        for (Factory *factory : board().player->factories()) {
+            factory->cell->_ice_vulnerable_cells_ready = false;
+            factory->cell->_ice_vulnerable_cells.clear();
+            vuln_count += factory->cell->ice_vulnerable_cells().size();
+        }
+        vuln_time += get_time() - t;
+
+        t = get_time();
+        board().invalidate_cost_fields();
+        for (Factory *factory : board().player->factories()) {
+            (void)board().cost_field(factory, CostField_HEAVY);
+            field_count += 1;
+        }
+        field_time += get_time() - t;
+    }
+    out << "bench_pathfind rounds=" << rounds << " us/round:"
+        << " resource_routes=" << route_time * 1e6 / rounds << " (" << route_count / rounds << " routes)"
+        << " ice_vulnerable=" << vuln_time * 1e6 / rounds << " (" << vuln_count / rounds << " cells)"
+        << " cost_fields=" << field_time * 1e6 / rounds << " (" << field_count / rounds << " fields)" << endl;
+    bench_queues(rounds, out);
+}
+
+// Replays one trace on the calling thread with a fresh MatchContext
+void replay_trace(const char *trace_path, ReplayOptions &opts, ReplayResult *result) {
+    unique_ptr<MatchContext> match(new MatchContext());
+    match->prod = opts.prod;
+    match->log.on = opts.log;
+    match->log.player = "player_0";
+    match->bind();
+
+    ostringstream out;
+    result->ok = false;
+    TraceReader trace{};
+    if (!trace.open(trace_path)) {
+        out << "failed to open trace " << trace_path << endl;
+        result->output = out.str();
+        return;
+    }
+
+    unique_ptr<Observation> obs(new Observation());
+    ActionWriter writer{};
+    writer.binary = false;
+
+    int turns = 0, matches = 0, compared = 0;
+    double total_time = 0, max_time = 0;
+    int max_time_step = -1;
+
+    out << "step real_step time_ms recorded_ms sim_iters actions match" << endl;
+    for (int step = 0; step < trace.turn_count() && step <= opts.to_step; step++) {
+        if (!trace.has_turn(step)) continue;
+        bool res = trace.observation(step, obs.get());
+        LUX_ASSERT(res);
+        if (!res) {
+            out << "failed to decode step " << step << endl;
+            result->output = out.str();
+            trace.close();
+            return;
+        }
+
+        // Fast-forward: rebuild board state from observations only. Agent-side state that act()
+        // normally carries between turns (roles, modes, assignments) starts fresh at from_step.
+        if (step < opts.from_step) {
+            agent().init(*obs);
+            continue;
+        }
+
+        double start_time = get_time();
+        agent().init(*obs);
+        if (board().real_env_step < 0) {
+            json output = agent().setup();
+            writer.write_json(output);
+            agent().sim_iterations = 0;
+        } else {
+            agent().step = board().real_env_step;
+            agent().act(&writer);
+        }
+        double turn_time = get_time() - start_time;
+
+        // Emitted actions can only be compared byte-for-byte against a json-mode recording
+        // replayed from the start
+        string match_str = "-";
+        string recorded = trace.actions(step);
+        if (opts.from_step == 0 && !trace.index[step].actions_binary) {
+            compared++;
+            if (recorded == writer.buf) {
+                matches++;
+                match_str = "yes";
+            } else {
+                match_str = "NO";
+            }
+        }
+
+        out << step << ' ' << board().real_env_step << ' '
+            << turn_time * 1000 << ' ' << trace.turn_time(step) * 1000 << ' '
+            << agent().sim_iterations << ' ' << writer.action_count << ' ' << match_str << endl;
+        if (opts.print_actions) out << writer.buf;
+
+        turns++;
+        total_time += turn_time;
+        if (turn_time > max_time) {
+            max_time = turn_time;
+            max_time_step = step;
+        }
+    }
+
+    if (opts.bench_cells > 0 && turns > 0) bench_cells(opts.bench_cells, out);
+    if (opts.bench_pathfind > 0 && turns > 0) bench_pathfind(opts.bench_pathfind, out);
+
+    out << "turns=" << turns
+        << " total_ms=" << total_time * 1000
+        << " avg_ms=" << (turns ? total_time * 1000 / turns : 0)
+        << " max_ms=" << max_time * 1000 << " (step " << max_time_step << ")"
+        << " matched=" << matches << '/' << compared << endl;
+    ObjectPoolStats pool = pool_stats();  // of this match only
+    out << "role_mode_allocs=" << pool.allocs << " heap_allocs=" << pool.heap_allocs << endl;
+    out << "horizon_avg=" << agent().time_budget.horizon_avg()
+        << " horizon_min=" << (agent().time_budget.turns ? agent().time_budget.horizon_min : 0)
+        << " near_misses=" << agent().time_budget.near_misses
+        << " fallbacks=" << agent().time_budget.fallbacks << endl;
+    trace.close();
+
+    result->ok = true;
+    result->turns = turns;
+    result->matches = matches;
+    result->compared = compared;
+    result->total_time = total_time;
+    result->max_time = max_time;
+    result->max_time_step = max_time_step;
+    result->output = out.str();
+}
+
+int _main(int argc, char **argv) {
+    vector<const char*> trace_paths;
+    ReplayOptions opts = {.from_step = 0, .to_step = INT_MAX, .print_actions = false,
+                          .prod = true, .log = false, .bench_cells = 0, .bench_pathfind = 0};
+    int jobs = 1;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--from" && i + 1 < argc) opts.from_step = atoi(argv[++i]);
+        else if (arg == "--to" && i + 1 < argc) opts.to_step = atoi(argv[++i]);
+        else if (arg == "--actions") opts.print_actions = true;
+        else if (arg == "--dev") opts.prod = false;
+        else if (arg == "--log") opts.log = true;
+        else if (arg == "--jobs" && i + 1 < argc) jobs = atoi(argv[++i]);
+        else if (arg == "--bench-cells" && i + 1 < argc) opts.bench_cells = atoi(argv[++i]);
+        else if (arg == "--bench-pathfind" && i + 1 < argc) opts.bench_pathfind = atoi(argv[++i]);
+        else if (arg.rfind("--", 0) != 0) trace_paths.push_back(argv[i]);
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (trace_paths.empty()) {
+        usage();
+        return 1;
+    }
+
+    // Matches share nothing but read-only tables, so workers just pull the next trace
+    vector<ReplayResult> results(trace_paths.size());
+    atomic<int> next_trace(0);
+    auto worker = [&]() {
+        int i;
+        while ((i = next_trace++) < (int)trace_paths.size()) {
+            replay_trace(trace_paths[i], opts, &results[i]);
+        }
+    };
+    double start_time = get_time();
+    jobs = MAX(1, MIN(jobs, (int)trace_paths.size()));
+    vector<thread> threads;
+    for (int i = 1; i < jobs; i++) threads.emplace_back(worker);
+    worker();
+    for (thread &t : threads) t.join();
+    double wall_time = get_time() - start_time;
+
+    bool ok = true;
+    int turns = 0, matches = 0, compared = 0;
+    double total_time = 0;
+    for (int i = 0; i < (int)trace_paths.size(); i++) {
+        ReplayResult &result = results[i];
+        if (trace_paths.size() > 1) cout << "== " << trace_paths[i] << endl;
+        cout << result.output;
+        ok = ok && result.ok;
+        turns += result.turns;
+        matches += result.matches;
+        compared += result.compared;
+        total_time += result.total_time;
+    }
+    if (trace_paths.size() > 1) {
+        cout << "traces=" << trace_paths.size() << " jobs=" << jobs
+             << " turns=" << turns
+             << " cpu_ms=" << total_time * 1000
+             << " wall_ms=" << wall_time * 1000
+             << " turns_per_s=" << (wall_time > 0 ? turns / wall_time : 0)
+             << " matched=" << matches << '/' << compared << endl;
+    }
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    try {
+        return _main(argc, argv);
+    } catch (lux::Exception &e) {
+        e.printStackTrace();
+        throw;
+    } catch (...) {
+        LUX_LOG("Error: other exception v1");
+        throw;
+    }
+}